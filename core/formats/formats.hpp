@@ -29,6 +29,7 @@
 
 #include "index/index_meta.hpp"
 #include "index/column_info.hpp"
+#include "index/document_mask.hpp"
 #include "index/iterators.hpp"
 
 #include "utils/io_utils.hpp"
@@ -47,7 +48,6 @@ struct reader_state;
 struct index_output;
 struct data_input;
 struct index_input;
-typedef std::unordered_set<doc_id_t> document_mask;
 struct postings_writer;
 typedef std::vector<doc_id_t> doc_map;
 
@@ -53,6 +53,7 @@
 #include "utils/bit_packing.hpp"
 #include "utils/bit_utils.hpp"
 #include "utils/bitset.hpp"
+#include "utils/block_cache.hpp"
 #include "utils/lz4compression.hpp"
 #include "utils/encryption.hpp"
 #include "utils/frozen_attributes.hpp"
@@ -62,6 +63,7 @@
 #include "utils/memory.hpp"
 #include "utils/memory_pool.hpp"
 #include "utils/noncopyable.hpp"
+#include "utils/numeric_utils.hpp"
 #include "utils/object_pool.hpp"
 #include "utils/timer_utils.hpp"
 #include "utils/type_limits.hpp"
@@ -208,7 +210,7 @@ inline void prepare_output(
   format_utils::write_header(*out, format, version);
 }
 
-inline void prepare_input(
+inline int32_t prepare_input(
     std::string& str,
     index_input::ptr& in,
     IOAdvice advice,
@@ -228,7 +230,7 @@ inline void prepare_input(
     ));
   }
 
-  format_utils::check_header(*in, format, min_ver, max_ver);
+  return format_utils::check_header(*in, format, min_ver, max_ver);
 }
 
 // ----------------------------------------------------------------------------
@@ -268,7 +270,14 @@ class postings_writer_base : public irs::postings_writer {
   static constexpr int32_t FORMAT_POSITIONS_ZEROBASED = FORMAT_SSE_POSITIONS_ONEBASED + 1;
   // positions are stored zero based, sse used
   static constexpr int32_t FORMAT_SSE_POSITIONS_ZEROBASED = FORMAT_POSITIONS_ZEROBASED + 1;
-  static constexpr int32_t FORMAT_MAX = FORMAT_SSE_POSITIONS_ZEROBASED;
+
+  // positions are stored zero based,
+  // skip-list stores max term frequency per skipped block
+  static constexpr int32_t FORMAT_BLOCK_MAX_FREQ = FORMAT_SSE_POSITIONS_ZEROBASED + 1;
+  // positions are stored zero based,
+  // skip-list stores max term frequency per skipped block, sse used
+  static constexpr int32_t FORMAT_SSE_BLOCK_MAX_FREQ = FORMAT_BLOCK_MAX_FREQ + 1;
+  static constexpr int32_t FORMAT_MAX = FORMAT_SSE_BLOCK_MAX_FREQ;
 
   static constexpr uint32_t MAX_SKIP_LEVELS = 10;
   static constexpr uint32_t BLOCK_SIZE = 128;
@@ -362,6 +371,7 @@ class postings_writer_base : public irs::postings_writer {
     }
 
     doc_id_t skip_doc[MAX_SKIP_LEVELS]{};
+    uint32_t skip_freq[MAX_SKIP_LEVELS]{}; // max term frequency since last skip
     doc_id_t deltas[BLOCK_SIZE]{}; // document deltas
     uint32_t freqs[BLOCK_SIZE]{};
     doc_id_t* delta{ deltas };
@@ -436,6 +446,11 @@ class postings_writer_base : public irs::postings_writer {
 
   void write_skip(size_t level, index_output& out);
 
+  // skip-list stores max term frequency per skipped block
+  bool has_block_max_freq() const noexcept {
+    return postings_format_version_ >= FORMAT_BLOCK_MAX_FREQ && features_.freq();
+  }
+
   memory::memory_pool<> meta_pool_;
   memory::memory_pool_allocator<version10::term_meta, decltype(meta_pool_)> alloc_{ meta_pool_ };
   skip_writer skip_;
@@ -561,6 +576,11 @@ void postings_writer_base::write_skip(size_t level, index_output& out) {
   doc_.skip_doc[level] = doc_.block_last;
   doc_.skip_ptr[level] = doc_ptr;
 
+  if (has_block_max_freq()) {
+    out.write_vint(doc_.skip_freq[level]);
+    doc_.skip_freq[level] = 0;
+  }
+
   if (features_.position()) {
     assert(pos_);
 
@@ -602,6 +622,7 @@ void postings_writer_base::begin_term() {
 
   doc_.last = doc_limits::min(); // for proper delta of 1st id
   doc_.block_last = doc_limits::invalid();
+  std::fill_n(doc_.skip_freq, MAX_SKIP_LEVELS, 0);
   skip_.reset();
 }
 
@@ -609,6 +630,17 @@ void postings_writer_base::end_doc() {
   if (doc_.full()) {
     doc_.block_last = doc_.last;
     doc_.end = doc_out_->file_pointer();
+
+    if (has_block_max_freq()) {
+      // max term frequency for the block is accumulated at every skip level
+      const uint32_t max_freq = *std::max_element(
+        std::begin(doc_.freqs), std::end(doc_.freqs));
+
+      for (auto& freq : doc_.skip_freq) {
+        freq = std::max(freq, max_freq);
+      }
+    }
+
     if (features_.position()) {
       assert(pos_ && pos_out_);
       pos_->end = pos_out_->file_pointer();
@@ -927,6 +959,7 @@ struct skip_state {
   size_t pend_pos{}; // positions to skip before new document block
   doc_id_t doc{ doc_limits::invalid() }; // last document in a previous block
   uint32_t pay_pos{}; // payload size to skip before in new document block
+  uint32_t max_freq{ no_max_freq() }; // max term frequency in a previous block
 }; // skip_state
 
 struct skip_context : skip_state {
@@ -1546,7 +1579,7 @@ struct position<IteratorTraits, false> : attribute {
 ///////////////////////////////////////////////////////////////////////////////
 template<typename IteratorTraits>
 class doc_iterator final
-    : public frozen_attributes<5, irs::doc_iterator> {
+    : public frozen_attributes<6, irs::doc_iterator> {
  public:
   doc_iterator() noexcept
     : attributes{{
@@ -1555,9 +1588,11 @@ class doc_iterator final
         { type<score>::id(), &scr_    },
         { type<frequency>::id(),     IteratorTraits::frequency() ? &freq_ : nullptr  },
         { type<irs::position>::id(), IteratorTraits::position()  ? &pos_  : nullptr  },
+        { type<block_impact>::id(),  nullptr },
       }},
       skip_levels_(1),
-      skip_(postings_writer_base::BLOCK_SIZE, postings_writer_base::SKIP_N) {
+      skip_(postings_writer_base::BLOCK_SIZE, postings_writer_base::SKIP_N),
+      impact_(*this) {
     assert(
       std::all_of(docs_, docs_ + postings_writer_base::BLOCK_SIZE,
                   [](doc_id_t doc) { return doc == doc_limits::invalid(); })
@@ -1569,8 +1604,10 @@ class doc_iterator final
       const attribute_provider& attrs,
       const index_input* doc_in,
       [[maybe_unused]] const index_input* pos_in,
-      [[maybe_unused]] const index_input* pay_in) {
+      [[maybe_unused]] const index_input* pay_in,
+      bool has_block_max_freq) {
     features_ = field; // set field features
+    has_block_max_freq_ = has_block_max_freq && features_.freq();
 
     assert(!IteratorTraits::frequency() || IteratorTraits::frequency() == features_.freq());
     assert(!IteratorTraits::position() || IteratorTraits::position() == features_.position());
@@ -1641,9 +1678,145 @@ class doc_iterator final
       doc_freq_ = doc_freqs_;
       ++end_;
     }
+
+    // block impacts make sense only for fields with frequencies,
+    // total term frequency is the upper bound for any block
+    *ref(type<block_impact>::id()) = features_.freq() ? &impact_ : nullptr;
+    const auto* total_freq = irs::get<frequency>(attrs);
+    impact_.doc = doc_limits::invalid();
+    impact_.max_freq = total_freq ? total_freq->value : no_max_freq();
+    term_max_freq_ = impact_.max_freq;
   }
 
   virtual doc_id_t seek(doc_id_t target) override {
+    const doc_id_t doc = seek_to(target);
+
+    if (mask_ && mask_->test(doc)) {
+      next(); // land on the next live document
+    }
+
+    return doc_.value;
+  }
+
+  virtual doc_id_t value() const noexcept final {
+    return doc_.value;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief live documents of each decoded block are marked once per refill,
+  ///        so runs of masked documents are skipped without being returned
+  //////////////////////////////////////////////////////////////////////////////
+  virtual bool exclude(const document_mask& mask) override {
+    mask_ = &mask.bits();
+
+    if (begin_ != end_) {
+      mask_block(); // singleton document is decoded by 'prepare(...)'
+    }
+
+    return true;
+  }
+
+#if defined(_MSC_VER)
+  #pragma warning( disable : 4706 )
+#elif defined (__GNUC__)
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wparentheses"
+#endif
+
+  virtual bool next() override {
+    do {
+      if (begin_ == end_) {
+        cur_pos_ += relative_pos();
+
+        if (cur_pos_ == term_state_.docs_count) {
+          doc_.value = doc_limits::eof();
+          begin_ = end_ = docs_; // seal the iterator
+          return false;
+        }
+
+        refill();
+      }
+    } while (mask_ && !skip_masked());
+
+    doc_.value += *begin_++; // update document attribute
+
+    if constexpr (IteratorTraits::frequency()) {
+      freq_.value = *doc_freq_++; // update frequency attribute
+
+      if constexpr (IteratorTraits::position()) {
+        pos_.notify(freq_.value);
+        pos_.clear();
+      }
+    }
+
+    return true;
+  }
+
+#if defined(_MSC_VER)
+  #pragma warning( default : 4706 )
+#elif defined (__GNUC__)
+  #pragma GCC diagnostic pop
+#endif
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the remaining documents of the decoded block
+  //////////////////////////////////////////////////////////////////////////////
+  virtual doc_block next_block() override {
+    do {
+      if (begin_ == end_) {
+        cur_pos_ += relative_pos();
+
+        if (cur_pos_ == term_state_.docs_count) {
+          doc_.value = doc_limits::eof();
+          begin_ = end_ = docs_; // seal the iterator
+          return {};
+        }
+
+        refill();
+      }
+    } while (mask_ && !skip_masked());
+
+    if (mask_) {
+      return next_live_block();
+    }
+
+    // the rest of the block is consumed at once,
+    // so deltas can be replaced with document ids in place
+    const size_t pos = relative_pos();
+    doc_id_t* begin = docs_ + pos;
+
+    for (auto* it = begin; it != end_; ++it) {
+      doc_.value += *it;
+      *it = doc_.value;
+    }
+
+    doc_block block{ begin, nullptr, size_t(end_ - begin) };
+    assert(block.size);
+    begin_ = end_;
+
+    if constexpr (IteratorTraits::frequency()) {
+      block.freqs = doc_freqs_ + pos;
+      doc_freq_ = doc_freqs_ + relative_pos();
+      freq_.value = doc_freq_[-1];
+
+      if constexpr (IteratorTraits::position()) {
+        for (auto* freq = block.freqs; freq != doc_freq_; ++freq) {
+          pos_.notify(*freq);
+        }
+        pos_.clear();
+      }
+    }
+
+    return block;
+  }
+
+ private:
+  using word_t = bitset::word_t;
+
+  static constexpr size_t LIVE_WORDS
+    = postings_writer_base::BLOCK_SIZE / bits_required<word_t>();
+
+  doc_id_t seek_to(doc_id_t target) {
     if (target <= doc_.value) {
       return doc_.value;
     }
@@ -1694,52 +1867,126 @@ class doc_iterator final
     return doc_.value;
   }
 
-  virtual doc_id_t value() const noexcept final {
-    return doc_.value;
+  // marks live documents of the decoded block in 'live_'
+  void mask_block() noexcept {
+    assert(mask_);
+    std::fill(std::begin(live_), std::end(live_), word_t(0));
+
+    doc_id_t doc = doc_.value;
+    for (size_t i = 0, size = size_t(end_ - docs_); i < size; ++i) {
+      doc += docs_[i];
+      live_[bitset::word(i)] |= word_t(!mask_->test(doc)) << bitset::bit(i);
+    }
   }
 
-#if defined(_MSC_VER)
-  #pragma warning( disable : 4706 )
-#elif defined (__GNUC__)
-  #pragma GCC diagnostic push
-  #pragma GCC diagnostic ignored "-Wparentheses"
-#endif
+  // moves iterator to the next live document of the decoded block,
+  // returns 'false' if the rest of the block is masked
+  bool skip_masked() {
+    assert(begin_ < end_);
+    size_t i = bitset::word(relative_pos());
+    word_t word = live_[i] & ((~word_t(0)) << bitset::bit(relative_pos()));
 
-  virtual bool next() override {
-    if (begin_ == end_) {
-      cur_pos_ += relative_pos();
+    while (!word && ++i < LIVE_WORDS) {
+      word = live_[i];
+    }
 
-      if (cur_pos_ == term_state_.docs_count) {
-        doc_.value = doc_limits::eof();
-        begin_ = end_ = docs_; // seal the iterator
-        return false;
+    const doc_id_t* live = word
+      ? docs_ + bitset::bit_offset(i) + math::math_traits<word_t>::ctz(word)
+      : end_;
+    assert(live <= end_);
+
+    for (; begin_ != live; ++begin_) {
+      doc_.value += *begin_;
+    }
+
+    if constexpr (IteratorTraits::frequency()) {
+      if constexpr (IteratorTraits::position()) {
+        for (const auto* end = doc_freqs_ + relative_pos(); doc_freq_ != end; ++doc_freq_) {
+          pos_.notify(*doc_freq_);
+        }
+      } else {
+        doc_freq_ = doc_freqs_ + relative_pos();
       }
+    }
 
-      refill();
+    return begin_ != end_;
+  }
+
+  // returns live documents of the decoded block up to the last live one,
+  // iterator must be positioned before a live document
+  doc_block next_live_block() {
+    size_t last = LIVE_WORDS;
+    while (!live_[--last]) { }
+    last = bitset::bit_offset(last)
+         + bits_required<word_t>() - 1
+         - math::math_traits<word_t>::clz(live_[last]);
+
+    const size_t pos = relative_pos();
+    assert(pos <= last && docs_ + last < end_);
+    doc_id_t* docs = docs_ + pos;
+    [[maybe_unused]] uint32_t* freqs = doc_freqs_ + pos;
+
+    // deltas up to the last live document are consumed at once,
+    // so live document ids and their frequencies are compacted in place
+    for (size_t i = pos; i <= last; ++i) {
+      doc_.value += docs_[i];
+      const bool live = irs::check_bit(live_[bitset::word(i)], bitset::bit(i));
+
+      if (live) {
+        *docs++ = doc_.value;
+      }
+
+      if constexpr (IteratorTraits::frequency()) {
+        const uint32_t freq = doc_freqs_[i];
+
+        if constexpr (IteratorTraits::position()) {
+          pos_.notify(freq);
+        }
+
+        if (live) {
+          *freqs++ = freq;
+        }
+      }
     }
 
-    doc_.value += *begin_++; // update document attribute
+    doc_block block{ docs_ + pos, nullptr, size_t(docs - (docs_ + pos)) };
+    assert(block.size);
+    begin_ = docs_ + last + 1;
 
     if constexpr (IteratorTraits::frequency()) {
-      freq_.value = *doc_freq_++; // update frequency attribute
+      block.freqs = doc_freqs_ + pos;
+      doc_freq_ = doc_freqs_ + relative_pos();
+      freq_.value = freqs[-1];
 
       if constexpr (IteratorTraits::position()) {
-        pos_.notify(freq_.value);
         pos_.clear();
       }
     }
 
-    return true;
+    return block;
   }
 
-#if defined(_MSC_VER)
-  #pragma warning( default : 4706 )
-#elif defined (__GNUC__)
-  #pragma GCC diagnostic pop
-#endif
+  //////////////////////////////////////////////////////////////////////////////
+  /// @class impact
+  /// @brief exposes skip-list data of the block containing a target
+  //////////////////////////////////////////////////////////////////////////////
+  class impact final : public block_impact {
+   public:
+    explicit impact(doc_iterator& self) noexcept
+      : self_(&self) {
+    }
+
+    virtual doc_id_t shallow_seek(doc_id_t target) override {
+      return self_->shallow_seek(target);
+    }
+
+   private:
+    doc_iterator* self_;
+  }; // impact
 
- private:
   void seek_to_block(doc_id_t target);
+  doc_id_t shallow_seek(doc_id_t target);
+  void seek_skip(doc_id_t target);
 
   // returns current position in the document block 'docs_'
   size_t relative_pos() noexcept {
@@ -1751,6 +1998,10 @@ class doc_iterator final
     state.doc = in.read_vint();
     state.doc_ptr += in.read_vlong();
 
+    if (has_block_max_freq_) {
+      state.max_freq = in.read_vint();
+    }
+
     if (features_.position()) {
       state.pend_pos = in.read_vint();
       state.pos_ptr += in.read_vlong();
@@ -1819,13 +2070,18 @@ class doc_iterator final
 
     begin_ = docs_;
     doc_freq_ = doc_freqs_;
+
+    if (mask_) {
+      mask_block();
+    }
   }
 
   irs::cost cost_;
   irs::score scr_;
   std::vector<skip_state> skip_levels_;
   skip_reader skip_;
-  skip_context* skip_ctx_; // pointer to used skip context, will be used by skip reader
+  skip_context skip_ctx_; // where the block found by skip reader starts
+  size_t skipped_{}; // number of documents skipped by skip reader
   uint32_t enc_buf_[postings_writer_base::BLOCK_SIZE]; // buffer for encoding
   doc_id_t docs_[postings_writer_base::BLOCK_SIZE]{ }; // doc values
   uint32_t doc_freqs_[postings_writer_base::BLOCK_SIZE]; // document frequencies
@@ -1834,84 +2090,121 @@ class doc_iterator final
   doc_id_t* end_{docs_};
   uint32_t* doc_freq_{}; // pointer into docs_ to the frequency attribute value for the current doc
   uint32_t term_freq_{}; // total term frequency
+  uint32_t term_max_freq_{ no_max_freq() }; // upper bound for any block
   document doc_;
   frequency freq_;
   index_input::ptr doc_in_;
   version10::term_meta term_state_;
   features features_; // field features
   position<IteratorTraits> pos_;
+  impact impact_;
+  bool has_block_max_freq_{}; // skip-list stores max term frequency per block
+  const bitvector* mask_{}; // masked documents, nullptr if none
+  word_t live_[LIVE_WORDS]{}; // live documents of the decoded block
 }; // doc_iterator
 
 template<typename IteratorTraits>
-void doc_iterator<IteratorTraits>::seek_to_block(doc_id_t target) {
-  // check whether it make sense to use skip-list
-  if (skip_levels_.front().doc < target && term_state_.docs_count > postings_writer_base::BLOCK_SIZE) {
-    skip_context last; // where block starts
-    skip_ctx_ = &last;
+void doc_iterator<IteratorTraits>::seek_skip(doc_id_t target) {
+  assert(term_state_.docs_count > postings_writer_base::BLOCK_SIZE);
+  assert(skip_levels_.front().doc < target);
 
-    // init skip writer in lazy fashion
-    if (!skip_) {
-      auto skip_in = doc_in_->dup();
+  // init skip writer in lazy fashion
+  if (!skip_) {
+    auto skip_in = doc_in_->dup();
 
-      if (!skip_in) {
-        IR_FRMT_ERROR("Failed to duplicate input in: %s", __FUNCTION__);
+    if (!skip_in) {
+      IR_FRMT_ERROR("Failed to duplicate input in: %s", __FUNCTION__);
 
-        throw io_error("Failed to duplicate document input");
-      }
+      throw io_error("Failed to duplicate document input");
+    }
 
-      skip_in->seek(term_state_.doc_start + term_state_.e_skip_start);
+    skip_in->seek(term_state_.doc_start + term_state_.e_skip_start);
 
-      skip_.prepare(
-        std::move(skip_in),
-        [this](size_t level, index_input& in) {
-          skip_state& last = *skip_ctx_;
-          auto& last_level = skip_ctx_->level;
-          auto& next = skip_levels_[level];
+    skip_.prepare(
+      std::move(skip_in),
+      [this](size_t level, index_input& in) {
+        skip_state& last = skip_ctx_;
+        auto& last_level = skip_ctx_.level;
+        auto& next = skip_levels_[level];
 
-          if (last_level > level) {
-            // move to the more granular level
-            next = last;
-          } else {
-            // store previous step on the same level
-            last = next;
-          }
+        if (last_level > level) {
+          // move to the more granular level
+          next = last;
+        } else {
+          // store previous step on the same level
+          last = next;
+        }
 
-          last_level = level;
+        last_level = level;
 
-          if (in.eof()) {
-            // stream exhausted
-            return (next.doc = doc_limits::eof());
-          }
+        if (in.eof()) {
+          // stream exhausted
+          return (next.doc = doc_limits::eof());
+        }
 
-          return read_skip(next, in);
-      });
+        return read_skip(next, in);
+    });
 
-      // initialize skip levels
-      const auto num_levels = skip_.num_levels();
-      if (num_levels) {
-        skip_levels_.resize(num_levels);
+    // initialize skip levels
+    const auto num_levels = skip_.num_levels();
+    if (num_levels) {
+      skip_levels_.resize(num_levels);
 
-        // since we store pointer deltas, add postings offset
-        auto& top = skip_levels_.back();
-        top.doc_ptr = term_state_.doc_start;
-        top.pos_ptr = term_state_.pos_start;
-        top.pay_ptr = term_state_.pay_start;
-      }
+      // since we store pointer deltas, add postings offset
+      auto& top = skip_levels_.back();
+      top.doc_ptr = term_state_.doc_start;
+      top.pos_ptr = term_state_.pos_start;
+      top.pay_ptr = term_state_.pay_start;
     }
+  }
+
+  skip_ctx_.level = 0;
+  skipped_ = skip_.seek(target);
+}
 
-    const size_t skipped = skip_.seek(target);
-    if (skipped > (cur_pos_ + relative_pos())) {
-      doc_in_->seek(last.doc_ptr);
-      doc_.value = last.doc;
-      cur_pos_ = skipped;
+template<typename IteratorTraits>
+void doc_iterator<IteratorTraits>::seek_to_block(doc_id_t target) {
+  // check whether it make sense to use skip-list
+  if (term_state_.docs_count > postings_writer_base::BLOCK_SIZE) {
+    if (skip_levels_.front().doc < target) {
+      seek_skip(target);
+    }
+
+    // block might have been already found by 'shallow_seek(...)'
+    if (skip_ctx_.doc < target && skipped_ > (cur_pos_ + relative_pos())) {
+      doc_in_->seek(skip_ctx_.doc_ptr);
+      doc_.value = skip_ctx_.doc;
+      cur_pos_ = skipped_;
       begin_ = end_ = docs_; // will trigger refill in "next"
       if constexpr (IteratorTraits::position()) {
-        pos_.prepare(last); // notify positions
+        pos_.prepare(skip_ctx_); // notify positions
       }
     }
   }
 }
 
+template<typename IteratorTraits>
+doc_id_t doc_iterator<IteratorTraits>::shallow_seek(doc_id_t target) {
+  if (term_state_.docs_count > postings_writer_base::BLOCK_SIZE) {
+    if (skip_levels_.front().doc < target) {
+      seek_skip(target);
+    }
+
+    const auto& block = skip_levels_.front();
+
+    impact_.doc = block.doc;
+    impact_.max_freq = has_block_max_freq_ && !doc_limits::eof(block.doc)
+      ? block.max_freq
+      : term_max_freq_; // tail block isn't covered by skip-list
+  } else {
+    // no skip-list for a single block
+    impact_.doc = doc_limits::eof();
+    impact_.max_freq = term_max_freq_;
+  }
+
+  return impact_.doc;
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                index_meta_writer
 // ----------------------------------------------------------------------------
@@ -2366,7 +2659,21 @@ class document_mask_writer final: public irs::document_mask_writer {
   static constexpr string_ref FORMAT_EXT = "doc_mask";
 
   static constexpr int32_t FORMAT_MIN = 0;
-  static constexpr int32_t FORMAT_MAX = FORMAT_MIN;
+
+  // choose between a list of masked documents and a bitset of them
+  static constexpr int32_t FORMAT_BITSET = 1;
+
+  static constexpr int32_t FORMAT_MAX = FORMAT_BITSET;
+
+  enum Encoding : byte_type {
+    SPARSE = 0, // delta encoded list of masked documents
+    DENSE = 1 // little-endian bitset, bit 'doc' is set for every masked 'doc'
+  };
+
+  explicit document_mask_writer(int32_t version) noexcept
+    : version_(version) {
+    assert(version_ >= FORMAT_MIN && version <= FORMAT_MAX);
+  }
 
   virtual ~document_mask_writer() = default;
 
@@ -2375,6 +2682,9 @@ class document_mask_writer final: public irs::document_mask_writer {
   virtual void write(directory& dir,
                      const segment_meta& meta,
                      const document_mask& docs_mask) override;
+
+ private:
+  int32_t version_;
 }; // document_mask_writer
 
 template<>
@@ -2404,11 +2714,62 @@ void document_mask_writer::write(
   assert(docs_mask.size() <= integer_traits<uint32_t>::const_max);
   const auto count = static_cast<uint32_t>(docs_mask.size());
 
-  format_utils::write_header(*out, FORMAT_NAME, FORMAT_MAX);
+  format_utils::write_header(*out, FORMAT_NAME, version_);
   out->write_vint(count);
 
+  if (version_ < FORMAT_BITSET) {
+    for (auto mask : docs_mask) {
+      out->write_vint(mask);
+    }
+
+    format_utils::write_footer(*out);
+    return;
+  }
+
+  // estimate size of the delta encoded list
+  size_t sparse_size = 0;
+  doc_id_t prev = 0;
+
   for (auto mask : docs_mask) {
-    out->write_vint(mask);
+    sparse_size += bytes_io<uint32_t>::vsize(mask - prev);
+    prev = mask;
+  }
+
+  // number of 64-bit words required to store bits up to the last masked doc
+  const size_t dense_words = count ? (size_t(prev) / 64 + 1) : 0;
+
+  if (sparse_size <= dense_words * sizeof(uint64_t)) {
+    out->write_byte(SPARSE);
+
+    prev = 0;
+    for (auto mask : docs_mask) {
+      out->write_vint(mask - prev);
+      prev = mask;
+    }
+  } else {
+    out->write_byte(DENSE);
+    out->write_vint(static_cast<uint32_t>(dense_words));
+
+    // bit 'i' is stored in byte 'i/8', so the bitset is readable as is by
+    // little-endian hosts regardless of the word size
+    const auto* bytes = reinterpret_cast<const byte_type*>(docs_mask.bits().data());
+    const auto dense_bytes = dense_words * sizeof(uint64_t);
+    const auto mask_bytes = docs_mask.bits().words() * sizeof(document_mask::word_t);
+    const auto tail_bytes = dense_bytes - std::min(dense_bytes, mask_bytes);
+
+    if (!numeric_utils::is_big_endian()) {
+      out->write_bytes(bytes, dense_bytes - tail_bytes);
+    } else {
+      for (size_t i = 0, count = dense_bytes - tail_bytes; i < count; ++i) {
+        constexpr size_t WORD_SIZE = sizeof(document_mask::word_t);
+        // reverse byte order within each word
+        out->write_byte(bytes[i - i % WORD_SIZE + WORD_SIZE - 1 - i % WORD_SIZE]);
+      }
+    }
+
+    for (size_t i = 0; i < tail_bytes; ++i) {
+      out->write_byte(0); // pad to a whole number of 64-bit words
+    }
   }
 
   format_utils::write_footer(*out);
@@ -2463,22 +2824,75 @@ bool document_mask_reader::read(
 
   const auto checksum = format_utils::checksum(*in);
 
-  format_utils::check_header(
+  const auto version = format_utils::check_header(
     *in,
     document_mask_writer::FORMAT_NAME,
     document_mask_writer::FORMAT_MIN,
     document_mask_writer::FORMAT_MAX
   );
 
+  static_assert(
+    sizeof(doc_id_t) == sizeof(decltype(in->read_vint())),
+    "sizeof(doc_id) != sizeof(decltype(id))"
+  );
+
   auto count = in->read_vint();
 
-  while (count--) {
-    static_assert(
-      sizeof(doc_id_t) == sizeof(decltype(in->read_vint())),
-      "sizeof(doc_id) != sizeof(decltype(id))"
-    );
+  if (version < document_mask_writer::FORMAT_BITSET) {
+    while (count--) {
+      docs_mask.insert(in->read_vint());
+    }
+  } else if (document_mask_writer::SPARSE == in->read_byte()) {
+    doc_id_t doc = 0;
+
+    while (count--) {
+      doc += in->read_vint();
+      docs_mask.insert(doc);
+    }
+  } else {
+    const size_t words = in->read_vint();
+
+    // masked documents can't exceed the last document of the segment, check
+    // before allocating since the checksum is only verified at the footer
+    if (words > bitset::word(meta.docs_count + doc_limits::min()) + 1) {
+      throw index_error(string_utils::to_string(
+        "invalid document mask bitset size '" IR_SIZE_T_SPECIFIER "' for segment of '" IR_UINT64_T_SPECIFIER "' documents, path: %s",
+        words, meta.docs_count, in_name.c_str()
+      ));
+    }
+
+    const size_t bytes = words * sizeof(uint64_t);
+    bitvector bits(words * bits_required<uint64_t>());
+    assert(bits.words() * sizeof(document_mask::word_t) >= bytes);
+    auto* data = const_cast<document_mask::word_t*>(bits.data());
+
+    if (bytes != in->read_bytes(reinterpret_cast<byte_type*>(data), bytes)) {
+      throw io_error(string_utils::to_string(
+        "failed to read document mask bitset, path: %s",
+        in_name.c_str()
+      ));
+    }
+
+    if (numeric_utils::is_big_endian()) {
+      // reverse byte order within each word
+      for (auto* word = data, *end = data + bits.words(); word != end; ++word) {
+        auto* word_bytes = reinterpret_cast<byte_type*>(word);
+        std::reverse(word_bytes, word_bytes + sizeof(document_mask::word_t));
+      }
+    }
 
-    docs_mask.insert(in->read_vint());
+    const size_t size = bits.count();
+
+    // a corrupted bitset is detected by the checksum at the footer as well,
+    // but the mask is built before the footer is reached
+    if (size != count) {
+      throw index_error(string_utils::to_string(
+        "invalid document mask bitset of '" IR_SIZE_T_SPECIFIER "' documents, expected '" IR_UINT32_T_SPECIFIER "', path: %s",
+        size, count, in_name.c_str()
+      ));
+    }
+
+    docs_mask.insert(std::move(bits));
   }
 
   format_utils::check_footer(*in, checksum);
@@ -2778,7 +3192,14 @@ ColumnProperty write_compact(
   return CP_SPARSE;
 }
 
-void read_compact(
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads block data written by 'write_compact'
+/// @returns view of the block data, uncompressed and unencrypted data is
+///          referenced directly in the input buffer when the input allows
+///          persistent access (e.g. mmap or memory), otherwise data is
+///          decoded into 'decode_buf'
+////////////////////////////////////////////////////////////////////////////////
+irs::bytes_ref read_compact(
     irs::index_input& in,
     irs::encryption::stream* cipher,
     irs::compression::decompressor* decompressor,
@@ -2787,13 +3208,22 @@ void read_compact(
   const auto size = irs::read_zvint(in);
 
   if (!size) {
-    return;
+    return irs::bytes_ref::EMPTY;
   }
 
   const size_t buf_size = std::abs(size);
 
   // -ve to mark uncompressed
   if (size < 0) {
+    // try zero-copy access, data has to outlive the current read call
+    const byte_type* data = cipher
+      ? nullptr
+      : in.read_buffer(buf_size, BufferHint::PERSISTENT);
+
+    if (data) {
+      return irs::bytes_ref(data, buf_size);
+    }
+
     decode_buf.resize(buf_size); // ensure that we have enough space to store decompressed data
 
 #ifdef IRESEARCH_DEBUG
@@ -2809,7 +3239,7 @@ void read_compact(
                       const_cast<byte_type*>(decode_buf.c_str()), buf_size);
     }
 
-    return;
+    return decode_buf;
   }
 
   if (IRS_UNLIKELY(!decompressor)) {
@@ -2850,6 +3280,8 @@ void read_compact(
   if (decoded.null()) {
     throw irs::index_error("error while reading compact");
   }
+
+  return decode_buf;
 }
 
 template<size_t Size>
@@ -3309,35 +3741,6 @@ void writer::rollback() noexcept {
   columns_.clear(); // ensure next flush (without prepare(...)) will use the section without 'data_out_'
 }
 
-template<typename Block, typename Allocator>
-class block_cache : irs::util::noncopyable {
- public:
-  block_cache(const Allocator& alloc = Allocator())
-    : cache_(alloc) {
-  }
-  block_cache(block_cache&&) = default;
-
-  template<typename... Args>
-  Block& emplace_back(Args&&... args) {
-    cache_.emplace_back(std::forward<Args>(args)...);
-    return cache_.back();
-  }
-
-  void pop_back() noexcept {
-    cache_.pop_back();
-  }
-
- private:
-  std::deque<Block, Allocator> cache_; // pointers remain valid
-}; // block_cache
-
-template<typename Block, typename Allocator>
-struct block_cache_traits {
-  typedef Block block_t;
-  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<block_t> allocator_t;
-  typedef block_cache<Block, allocator_t> cache_t;
-};
-
 // -----------------------------------------------------------------------------
 // --SECTION--                                                            Blocks
 // -----------------------------------------------------------------------------
@@ -3420,7 +3823,7 @@ class sparse_block : util::noncopyable {
     const sparse_block::ref* next_{}; // next position
     const sparse_block::ref* begin_{};
     const sparse_block::ref* end_{};
-    const bstring* data_{};
+    const bytes_ref* data_{};
   }; // iterator
 
   void load(index_input& in,
@@ -3452,7 +3855,7 @@ class sparse_block : util::noncopyable {
     });
 
     // read data
-    read_compact(in, cipher, decomp, buf, data_);
+    data_ = read_compact(in, cipher, decomp, buf, data_buf_);
     end_ = index_ + size;
   }
 
@@ -3520,6 +3923,11 @@ class sparse_block : util::noncopyable {
     return visitor(begin->key, value);
   }
 
+  // amount of memory occupied by a block, used by the block cache
+  size_t memory() const noexcept {
+    return sizeof(*this) + data_buf_.capacity();
+  }
+
  private:
   // TODO: use single memory block for both index & data
 
@@ -3528,7 +3936,8 @@ class sparse_block : util::noncopyable {
   // waste just INDEX_BLOCK_SIZE*sizeof(ref)-1 per column
   // in the worst case
   ref index_[INDEX_BLOCK_SIZE];
-  bstring data_;
+  bstring data_buf_; // decoded data, unused if 'data_' references input directly
+  bytes_ref data_;
   const ref* end_{ std::end(index_) };
 }; // sparse_block
 
@@ -3605,7 +4014,7 @@ class dense_block : util::noncopyable {
     const uint32_t* begin_{};
     const uint32_t* it_{};
     const uint32_t* end_{};
-    const bstring* data_{};
+    const bytes_ref* data_{};
     doc_id_t base_{};
   }; // iterator
 
@@ -3639,7 +4048,7 @@ class dense_block : util::noncopyable {
     });
 
     // read data
-    read_compact(in, cipher, decomp, buf, data_);
+    data_ = read_compact(in, cipher, decomp, buf, data_buf_);
     end_ = index_ + size;
   }
 
@@ -3697,6 +4106,10 @@ class dense_block : util::noncopyable {
     return visitor(key, value);
   }
 
+  size_t memory() const noexcept {
+    return sizeof(*this) + data_buf_.capacity();
+  }
+
  private:
   // TODO: use single memory block for both index & data
 
@@ -3705,7 +4118,8 @@ class dense_block : util::noncopyable {
   // waste just INDEX_BLOCK_SIZE*sizeof(ref)-1 per column
   // in the worst case
   uint32_t index_[INDEX_BLOCK_SIZE];
-  bstring data_;
+  bstring data_buf_; // decoded data, unused if 'data_' references input directly
+  bytes_ref data_;
   uint32_t* end_{ index_ };
   doc_id_t base_{ };
 }; // dense_block
@@ -3817,7 +4231,7 @@ class dense_fixed_offset_block : util::noncopyable {
     }
 
     // read data
-    read_compact(in, cipher, decomp, buf, data_);
+    data_ = read_compact(in, cipher, decomp, buf, data_buf_);
   }
 
   bool value(doc_id_t key, bytes_ref& out) const {
@@ -3866,12 +4280,17 @@ class dense_fixed_offset_block : util::noncopyable {
     return visitor(key, value);
   }
 
+  size_t memory() const noexcept {
+    return sizeof(*this) + data_buf_.capacity();
+  }
+
  private:
   doc_id_t base_key_{}; // base key
   uint32_t base_offset_{}; // base offset
   uint32_t avg_length_{}; // entry length
   doc_id_t size_{}; // total number of entries
-  bstring data_;
+  bstring data_buf_; // decoded data, unused if 'data_' references input directly
+  bytes_ref data_;
 }; // dense_fixed_offset_block
 
 class sparse_mask_block : util::noncopyable {
@@ -3978,6 +4397,10 @@ class sparse_mask_block : util::noncopyable {
     return true;
   }
 
+  size_t memory() const noexcept {
+    return sizeof(*this);
+  }
+
  private:
   // all blocks except the tail one are going to be fully filled,
   // so we store keys in a fixed length array since we could
@@ -4093,18 +4516,16 @@ class dense_mask_block {
     return true;
   }
 
+  size_t memory() const noexcept {
+    return sizeof(*this);
+  }
+
  private:
   doc_id_t min_;
   doc_id_t max_;
 }; // dense_mask_block
 
-template<typename Allocator = std::allocator<sparse_block>>
-class read_context
-  : public block_cache_traits<sparse_block, Allocator>::cache_t,
-    public block_cache_traits<dense_block, Allocator>::cache_t,
-    public block_cache_traits<dense_fixed_offset_block, Allocator>::cache_t,
-    public block_cache_traits<sparse_mask_block, Allocator>::cache_t,
-    public block_cache_traits<dense_mask_block, Allocator>::cache_t {
+class read_context {
  public:
   using ptr = std::shared_ptr<read_context>;
 
@@ -4121,63 +4542,36 @@ class read_context
     return memory::make_shared<read_context>(std::move(clone), cipher);
   }
 
-  read_context(
-      index_input::ptr&& in,
-      encryption::stream* cipher,
-      const Allocator& alloc = Allocator())
-    : block_cache_traits<sparse_block, Allocator>::cache_t(typename block_cache_traits<sparse_block, Allocator>::allocator_t(alloc)),
-      block_cache_traits<dense_block, Allocator>::cache_t(typename block_cache_traits<dense_block, Allocator>::allocator_t(alloc)),
-      block_cache_traits<dense_fixed_offset_block, Allocator>::cache_t(typename block_cache_traits<dense_fixed_offset_block, Allocator>::allocator_t(alloc)),
-      block_cache_traits<sparse_mask_block, Allocator>::cache_t(typename block_cache_traits<sparse_mask_block, Allocator>::allocator_t(alloc)),
-      block_cache_traits<dense_mask_block, Allocator>::cache_t(typename block_cache_traits<dense_mask_block, Allocator>::allocator_t(alloc)),
-      buf_(INDEX_BLOCK_SIZE*sizeof(uint32_t), 0),
+  read_context(index_input::ptr&& in, encryption::stream* cipher)
+    : buf_(INDEX_BLOCK_SIZE*sizeof(uint32_t), 0),
       stream_(std::move(in)),
       cipher_(cipher) {
   }
 
-  template<typename Block, typename... Args>
-  Block& emplace_back(uint64_t offset, compression::decompressor* decomp, bool decrypt, Args&&... args) {
-    typename block_cache_traits<Block, Allocator>::cache_t& cache = *this;
-
-    // add cache entry
-    auto& block = cache.emplace_back(std::forward<Args>(args)...);
-
-    try {
-      load(block, decomp, decrypt, offset);
-    } catch (...) {
-      // failed to load block
-      pop_back<Block>();
-
-      throw;
-    }
-
-    return block;
-  }
-
   template<typename Block>
   void load(Block& block, compression::decompressor* decomp, bool decrypt, uint64_t offset) {
     stream_->seek(offset); // seek to the offset
     block.load(*stream_, decomp, decrypt ? cipher_ : nullptr, buf_);
   }
 
-  template<typename Block>
-  void pop_back() noexcept {
-    typename block_cache_traits<Block, Allocator>::cache_t& cache = *this;
-    cache.pop_back();
-  }
-
  private:
   bstring buf_; // temporary buffer for decoding/unpacking
   index_input::ptr stream_;
   encryption::stream* cipher_; // options cipher stream
 }; // read_context
 
-typedef read_context<> read_context_t;
+typedef read_context read_context_t;
 
 class context_provider: private util::noncopyable {
  public:
   context_provider(size_t max_pool_size)
-    : pool_(std::max(size_t(1), max_pool_size)) {
+    : pool_(std::max(size_t(1), max_pool_size)),
+      file_id_(block_cache::next_file_id()) {
+  }
+
+  ~context_provider() {
+    // blocks of a closed reader are never requested again
+    block_cache::instance().erase(file_id_);
   }
 
   void prepare(index_input::ptr&& stream, encryption::stream::ptr&& cipher) noexcept {
@@ -4191,63 +4585,90 @@ class context_provider: private util::noncopyable {
     return pool_.emplace(*stream_, cipher_.get());
   }
 
+  uint64_t file_id() const noexcept { return file_id_; }
+
+  void prefetch(uint64_t offset, size_t length) const noexcept {
+    stream_->prefetch(offset, length);
+  }
+
  private:
   mutable bounded_object_pool<read_context_t> pool_;
   encryption::stream::ptr cipher_;
   index_input::ptr stream_;
+  uint64_t file_id_; // identifies blocks of the reader in the block cache
 }; // context_provider
 
-// in case of success caches block pointed
-// instance, nullptr otherwise
+// returns block pointed by 'ref', loads and puts
+// it into the global block cache if necessary,
+// in the latter case the block pointed by 'next'
+// (if any) is prefetched since it's likely to be
+// requested soon and is unlikely to be cached as well
 template<typename BlockRef>
-const typename BlockRef::block_t& load_block(
+std::shared_ptr<const typename BlockRef::block_t> load_block(
     const context_provider& ctxs,
     compression::decompressor* decomp,
     bool decrypt,
-    BlockRef& ref) {
+    const BlockRef& ref,
+    const BlockRef* next = nullptr,
+    size_t next_size = 0) {
   typedef typename BlockRef::block_t block_t;
 
-  const auto* cached = ref.pblock.load();
+  auto& cache = block_cache::instance();
+  const block_cache::key key{ ctxs.file_id(), ref.offset };
+
+  auto cached = cache.find(key);
 
   if (!cached) {
-    auto ctx = ctxs.get_context();
-    assert(ctx);
+    if (next) {
+      ctxs.prefetch(next->offset, next_size);
+    }
 
-    // load block
-    const auto& block = ctx->template emplace_back<block_t>(ref.offset, decomp, decrypt);
+    auto block = std::make_shared<block_t>();
 
-    // mark block as loaded
-    if (ref.pblock.compare_exchange_strong(cached, &block)) {
-      cached = &block;
-    } else {
-      // already cached by another thread
-      ctx->template pop_back<block_t>();
+    {
+      auto ctx = ctxs.get_context();
+      assert(ctx);
+
+      ctx->load(*block, decomp, decrypt, ref.offset);
     }
+
+    const size_t size = block->memory();
+    cached = cache.insert(key, std::move(block), size);
   }
 
-  return *cached;
+  return std::static_pointer_cast<const block_t>(std::move(cached));
 }
 
-// in case of success caches block pointed
-// by 'ref' in the specified 'block' and
-// retuns a pointer to cached instance,
-// nullptr otherwise
+// returns block pointed by 'ref' if it's cached,
+// otherwise loads it into the specified 'block'
+// without caching and prefetches the block pointed
+// by 'next' (if any)
 template<typename BlockRef>
 const typename BlockRef::block_t& load_block(
     const context_provider& ctxs,
     compression::decompressor* decomp,
     bool decrypt,
     const BlockRef& ref,
-    typename BlockRef::block_t& block) {
-  const auto* cached = ref.pblock.load();
+    typename BlockRef::block_t& block,
+    std::shared_ptr<const typename BlockRef::block_t>& cached,
+    const BlockRef* next = nullptr,
+    size_t next_size = 0) {
+  typedef typename BlockRef::block_t block_t;
+
+  cached = std::static_pointer_cast<const block_t>(
+    block_cache::instance().find({ ctxs.file_id(), ref.offset }));
 
   if (!cached) {
+    if (next) {
+      ctxs.prefetch(next->offset, next_size);
+    }
+
     auto ctx = ctxs.get_context();
     assert(ctx);
 
     ctx->load(block, decomp, decrypt, ref.offset);
 
-    cached = &block;
+    return block;
   }
 
   return *cached;
@@ -4335,14 +4756,14 @@ class column_iterator final
   virtual doc_id_t seek(irs::doc_id_t doc) override {
     begin_ = column_->find_block(seek_origin_, end_, doc);
 
-    if (!next_block()) {
+    if (!load_next_block()) {
       return value();
     }
 
     if (!block_.seek(doc)) {
       // reached the end of block,
       // advance to the next one
-      while (next_block() && !block_.next()) { }
+      while (load_next_block() && !block_.next()) { }
     }
 
     doc_.value = block_.value();
@@ -4351,7 +4772,7 @@ class column_iterator final
 
   virtual bool next() override {
     while (!block_.next()) {
-      if (!next_block()) {
+      if (!load_next_block()) {
         return false;
       }
     }
@@ -4363,7 +4784,7 @@ class column_iterator final
  private:
   typedef typename column_t::refs_t refs_t;
 
-  bool next_block() {
+  bool load_next_block() {
     if (begin_ == end_) {
       // reached the end of the column
       block_.seal();
@@ -4375,14 +4796,19 @@ class column_iterator final
     }
 
     try {
-      const auto& cached = load_block(*column_->ctxs_, column_->decompressor(), column_->encrypted(), *begin_);
-
-      if (block_ != cached) {
-        block_.reset(cached, payload_);
+      // the size of a block isn't stored, prefetch an average one
+      const auto* next = begin_ + 1 != end_ ? begin_ + 1 : nullptr;
+      auto cached = load_block(*column_->ctxs_, column_->decompressor(), column_->encrypted(),
+                               *begin_, next, column_->avg_block_size());
+
+      if (block_ != *cached) {
+        block_.reset(*cached, payload_);
+        cached_ = std::move(cached); // keep block alive even if evicted
       }
     } catch (...) {
       // unable to load block, seal the iterator
       block_.seal();
+      cached_ = nullptr;
       begin_ = end_;
       payload_.value = bytes_ref::NIL;
       doc_.value = irs::doc_limits::eof();
@@ -4396,6 +4822,7 @@ class column_iterator final
   }
 
   block_iterator_t block_;
+  std::shared_ptr<const block_t> cached_; // block referenced by 'block_'
   irs::payload payload_;
   irs::document doc_;
   irs::cost cost_;
@@ -4410,14 +4837,21 @@ class column_iterator final
 // --SECTION--                                                           Columns
 // -----------------------------------------------------------------------------
 
+// values returned by the reader point to the last requested
+// block, the block is re-acquired via the global block cache
+// on each call and is only held by the reader until the next
+// one, i.e. the reader doesn't prevent the cache from evicting
+// blocks of a column
 template<typename Column>
 columnstore_reader::values_reader_f column_values(const Column& column) {
-if (column.empty()) {
+  if (column.empty()) {
     return columnstore_reader::empty_reader();
   }
 
-  return [&column](doc_id_t key, bytes_ref& value) {
-    return column.value(key, value);
+  std::shared_ptr<const typename Column::block_t> block;
+
+  return [&column, block](doc_id_t key, bytes_ref& value) mutable {
+    return column.value(key, value, block);
   };
 }
 
@@ -4495,7 +4929,10 @@ class sparse_column final : public column {
     refs_ = std::move(refs);
   }
 
-  bool value(doc_id_t key, bytes_ref& value) const {
+  bool value(
+      doc_id_t key,
+      bytes_ref& value,
+      std::shared_ptr<const block_t>& block) const {
     // find the right block
     const auto rbegin = refs_.rbegin(); // upper bound
     const auto rend = refs_.rend();
@@ -4509,17 +4946,20 @@ class sparse_column final : public column {
       return false;
     }
 
-    const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), *it);
+    block = load_block(*ctxs_, decompressor(), encrypted(), *it);
 
-    return cached.value(key, value);
+    return block->value(key, value);
   }
 
   virtual bool visit(
       const columnstore_reader::values_visitor_f& visitor
   ) const override {
     block_t block; // don't cache new blocks
+    std::shared_ptr<const block_t> cached_block;
     for (auto begin = refs_.begin(), end = refs_.end()-1; begin != end; ++begin) { // -1 for upper bound
-      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), *begin, block);
+      const auto* next = begin + 1 != end ? &*(begin + 1) : nullptr;
+      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), *begin, block, cached_block,
+                                      next, avg_block_size());
 
       if (!cached.visit(visitor)) {
         return false;
@@ -4548,19 +4988,11 @@ class sparse_column final : public column {
  private:
   friend class column_iterator<column_t>;
 
-  struct block_ref : util::noncopyable {
+  struct block_ref {
     typedef typename column_t::block_t block_t;
 
-    block_ref() = default;
-
-    block_ref(block_ref&& other) noexcept
-      : key(std::move(other.key)), offset(std::move(other.offset)) {
-      pblock = other.pblock.exchange(nullptr); // no std::move(...) for std::atomic<...>
-    }
-
     doc_id_t key; // min key in a block
     uint64_t offset; // block offset
-    mutable std::atomic<const block_t*> pblock; // pointer to cached block
   }; // block_ref
 
   typedef std::vector<block_ref> refs_t;
@@ -4679,7 +5111,10 @@ class dense_fixed_offset_column final : public column {
     min_ = this->max() - this->count() + 1;
   }
 
-  bool value(doc_id_t key, bytes_ref& value) const {
+  bool value(
+      doc_id_t key,
+      bytes_ref& value,
+      std::shared_ptr<const block_t>& block) const {
     const auto base_key = key - min_;
 
     if (base_key >= this->count()) {
@@ -4689,17 +5124,18 @@ class dense_fixed_offset_column final : public column {
     const auto block_idx = base_key / this->avg_block_count();
     assert(block_idx < refs_.size());
 
-    auto& ref = const_cast<block_ref&>(refs_[block_idx]);
-
-    const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), ref);
+    block = load_block(*ctxs_, decompressor(), encrypted(), refs_[block_idx]);
 
-    return cached.value(key, value);
+    return block->value(key, value);
   }
 
   virtual bool visit(const columnstore_reader::values_visitor_f& visitor) const override {
     block_t block; // don't cache new blocks
-    for (auto& ref : refs_) {
-      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), ref, block);
+    std::shared_ptr<const block_t> cached_block;
+    for (auto begin = refs_.begin(), end = refs_.end(); begin != end; ++begin) {
+      const auto* next = begin + 1 != end ? &*(begin + 1) : nullptr;
+      const auto& cached = load_block(*ctxs_, decompressor(), encrypted(), *begin, block, cached_block,
+                                      next, avg_block_size());
 
       if (!cached.visit(visitor)) {
         return false;
@@ -4732,15 +5168,7 @@ class dense_fixed_offset_column final : public column {
   struct block_ref {
     typedef typename column_t::block_t block_t;
 
-    block_ref() = default;
-
-    block_ref(block_ref&& other) noexcept
-      : offset(std::move(other.offset)) {
-      pblock = other.pblock.exchange(nullptr); // no std::move(...) for std::atomic<...>
-    }
-
     uint64_t offset; // need to store base offset since blocks may not be located sequentially
-    mutable std::atomic<const block_t*> pblock;
   }; // block_ref
 
   typedef std::vector<block_ref> refs_t;
@@ -4864,7 +5292,13 @@ class dense_fixed_offset_column<dense_mask_block> final : public column {
   virtual irs::doc_iterator::ptr iterator() const override;
 
   virtual columnstore_reader::values_reader_f values() const override {
-    return column_values<column_t>(*this);
+    if (empty()) {
+      return columnstore_reader::empty_reader();
+    }
+
+    return [this](doc_id_t key, bytes_ref& value) noexcept {
+      return this->value(key, value);
+    };
   }
 
  private:
@@ -5144,9 +5578,15 @@ class postings_reader_base : public irs::postings_reader {
     irs::term_meta& state) final;
 
  protected:
+  // skip-list stores max term frequency per skipped block
+  bool has_block_max_freq() const noexcept {
+    return version_ >= postings_writer_base::FORMAT_BLOCK_MAX_FREQ;
+  }
+
   index_input::ptr doc_in_;
   index_input::ptr pos_in_;
   index_input::ptr pay_in_;
+  int32_t version_{}; // postings format version
 }; // postings_reader
 
 void postings_reader_base::prepare(
@@ -5156,7 +5596,7 @@ void postings_reader_base::prepare(
   std::string buf;
 
   // prepare document input
-  prepare_input(
+  version_ = prepare_input(
     buf, doc_in_, irs::IOAdvice::RANDOM, state,
     postings_writer_base::DOC_EXT,
     postings_writer_base::DOC_FORMAT_NAME,
@@ -5287,7 +5727,8 @@ class postings_reader final: public postings_reader_base {
       const attribute_provider& attrs,
       const ::features& features) {
     auto it = memory::make_managed<doc_iterator<IteratorTraits>>();
-    it->prepare(features, attrs, doc_in_.get(), pos_in_.get(), pay_in_.get());
+    it->prepare(features, attrs, doc_in_.get(), pos_in_.get(), pay_in_.get(),
+                has_block_max_freq());
 
     return it;
   }
@@ -5361,7 +5802,7 @@ class format10 : public irs::version10::format {
   virtual segment_meta_writer::ptr get_segment_meta_writer() const override;
   virtual segment_meta_reader::ptr get_segment_meta_reader() const override final;
 
-  virtual document_mask_writer::ptr get_document_mask_writer() const override final;
+  virtual document_mask_writer::ptr get_document_mask_writer() const override;
   virtual document_mask_reader::ptr get_document_mask_reader() const override final;
 
   virtual field_writer::ptr get_field_writer(bool volatile_state) const override;
@@ -5412,7 +5853,7 @@ segment_meta_reader::ptr format10::get_segment_meta_reader() const {
 
 document_mask_writer::ptr format10::get_document_mask_writer() const {
   // can reuse stateless writer
-  static ::document_mask_writer INSTANCE;
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_MIN);
 
   return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
 }
@@ -5647,7 +6088,7 @@ const ::format14 FORMAT14_INSTANCE;
 
 irs::field_writer::ptr format14::get_field_writer(bool volatile_state) const {
   return burst_trie::make_writer(
-    burst_trie::Version::MAX,
+    burst_trie::Version::IMMUTABLE_FST,
     get_postings_writer(volatile_state),
     volatile_state);
 }
@@ -5659,6 +6100,65 @@ irs::field_writer::ptr format14::get_field_writer(bool volatile_state) const {
 
 REGISTER_FORMAT_MODULE(::format14, MODULE_NAME);
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                         format15
+// ----------------------------------------------------------------------------
+
+class format15 : public format14 {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_5";
+  }
+
+  DECLARE_FACTORY();
+
+  format15() noexcept : format14(irs::type<format15>::get()) { }
+
+  virtual irs::document_mask_writer::ptr get_document_mask_writer() const override final;
+
+  virtual irs::field_writer::ptr get_field_writer(bool volatile_state) const override;
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool volatile_state) const override;
+
+ protected:
+  explicit format15(const irs::type_info& type) noexcept
+    : format14(type) {
+  }
+}; // format15
+
+const ::format15 FORMAT15_INSTANCE;
+
+irs::document_mask_writer::ptr format15::get_document_mask_writer() const {
+  // can reuse stateless writer
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_MAX);
+
+  return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
+}
+
+irs::field_writer::ptr format15::get_field_writer(bool volatile_state) const {
+  return burst_trie::make_writer(
+    burst_trie::Version::MAX,
+    get_postings_writer(volatile_state),
+    volatile_state);
+}
+
+irs::postings_writer::ptr format15::get_postings_writer(bool volatile_state) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_BLOCK_MAX_FREQ;
+
+  if (volatile_state) {
+    return memory::make_unique<::postings_writer<format_traits, true>>(VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits, false>>(VERSION);
+}
+
+/*static*/ irs::format::ptr format15::make() {
+  // aliasing constructor
+  return irs::format::ptr(irs::format::ptr(), &FORMAT15_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format15, MODULE_NAME);
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                      format12sse
 // ----------------------------------------------------------------------------
@@ -5793,7 +6293,7 @@ const ::format14 FORMAT14SIMD_INSTANCE;
 
 irs::field_writer::ptr format14simd::get_field_writer(bool volatile_state) const {
   return burst_trie::make_writer(
-    burst_trie::Version::MAX,
+    burst_trie::Version::IMMUTABLE_FST,
     get_postings_writer(volatile_state),
     volatile_state);
 }
@@ -5805,6 +6305,65 @@ irs::field_writer::ptr format14simd::get_field_writer(bool volatile_state) const
 
 REGISTER_FORMAT_MODULE(::format14simd, MODULE_NAME);
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                      format15sse
+// ----------------------------------------------------------------------------
+
+class format15simd : public format14simd {
+ public:
+  static constexpr string_ref type_name() noexcept {
+    return "1_5simd";
+  }
+
+  DECLARE_FACTORY();
+
+  format15simd() noexcept : format14simd(irs::type<format15simd>::get()) { }
+
+  virtual irs::document_mask_writer::ptr get_document_mask_writer() const override final;
+
+  virtual irs::field_writer::ptr get_field_writer(bool volatile_state) const override;
+
+  virtual irs::postings_writer::ptr get_postings_writer(bool volatile_state) const override;
+
+ protected:
+  explicit format15simd(const irs::type_info& type) noexcept
+    : format14simd(type) {
+  }
+}; // format15simd
+
+const ::format15simd FORMAT15SIMD_INSTANCE;
+
+irs::document_mask_writer::ptr format15simd::get_document_mask_writer() const {
+  // can reuse stateless writer
+  static ::document_mask_writer INSTANCE(::document_mask_writer::FORMAT_MAX);
+
+  return memory::to_managed<irs::document_mask_writer, false>(&INSTANCE);
+}
+
+irs::field_writer::ptr format15simd::get_field_writer(bool volatile_state) const {
+  return burst_trie::make_writer(
+    burst_trie::Version::MAX,
+    get_postings_writer(volatile_state),
+    volatile_state);
+}
+
+irs::postings_writer::ptr format15simd::get_postings_writer(bool volatile_state) const {
+  constexpr const auto VERSION = postings_writer_base::FORMAT_SSE_BLOCK_MAX_FREQ;
+
+  if (volatile_state) {
+    return memory::make_unique<::postings_writer<format_traits_simd, true>>(VERSION);
+  }
+
+  return memory::make_unique<::postings_writer<format_traits_simd, false>>(VERSION);
+}
+
+/*static*/ irs::format::ptr format15simd::make() {
+  // aliasing constructor
+  return irs::format::ptr(irs::format::ptr(), &FORMAT15SIMD_INSTANCE);
+}
+
+REGISTER_FORMAT_MODULE(::format15simd, MODULE_NAME);
+
 #endif // IRESEARCH_SSE2
 
 }
@@ -5819,10 +6378,12 @@ void init() {
   REGISTER_FORMAT(::format12);
   REGISTER_FORMAT(::format13);
   REGISTER_FORMAT(::format14);
+  REGISTER_FORMAT(::format15);
 #ifdef IRESEARCH_SSE2
   REGISTER_FORMAT(::format12simd);
   REGISTER_FORMAT(::format13simd);
   REGISTER_FORMAT(::format14simd);
+  REGISTER_FORMAT(::format15simd);
 #endif // IRESEARCH_SSE2
 #endif // IRESEARCH_DLL
 }
@@ -22,7 +22,9 @@
 
 #include "formats_burst_trie.hpp"
 
+#include <atomic>
 #include <cassert>
+#include <mutex>
 #include <variant>
 #include <list>
 
@@ -70,6 +72,7 @@
 #include "store/store_utils.hpp"
 #include "utils/automaton.hpp"
 #include "utils/buffers.hpp"
+#include "utils/crc.hpp"
 #include "utils/encryption.hpp"
 #include "utils/hash_utils.hpp"
 #include "utils/memory.hpp"
@@ -86,6 +89,7 @@
 #include "utils/timer_utils.hpp"
 #include "utils/bit_utils.hpp"
 #include "utils/bitset.hpp"
+#include "utils/block_cache.hpp"
 #include "utils/frozen_attributes.hpp"
 #include "utils/string.hpp"
 #include "utils/log.hpp"
@@ -457,6 +461,15 @@ inline int32_t prepare_input(
   return format_utils::check_header(*in, format, min_ver, max_ver);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @returns number of cipher blocks buffered by an encrypted term index input
+///////////////////////////////////////////////////////////////////////////////
+inline size_t index_blocks_in_buffer(const encryption::stream& cipher) {
+  return math::div_ceil64(
+    buffered_index_input::DEFAULT_BUFFER_SIZE,
+    cipher.block_size());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @struct cookie
 ///////////////////////////////////////////////////////////////////////////////
@@ -1147,7 +1160,18 @@ void field_writer::end_field(
 #endif
 
   // write FST
-  if (version_ > burst_trie::Version::ENCRYPTION_MIN) {
+  if (version_ >= burst_trie::Version::FST_SIZE) {
+    // buffer FST to write its size ahead, readers skip it by a seek,
+    // FST is followed by its checksum verified once it's loaded lazily
+    bstring buf;
+    bytes_output out(buf);
+    immutable_byte_fst::Write(fst, out, fst_stats);
+    crc32c crc;
+    crc.process_bytes(buf.c_str(), buf.size());
+    index_out_->write_vlong(buf.size());
+    index_out_->write_bytes(buf.c_str(), buf.size());
+    index_out_->write_long(crc.checksum());
+  } else if (version_ > burst_trie::Version::ENCRYPTION_MIN) {
     immutable_byte_fst::Write(fst, *index_out_, fst_stats);
   } else {
     // wrap stream to be OpenFST compliant
@@ -1240,6 +1264,23 @@ attribute* term_reader_base::get_mutable(irs::type_info::type_id type) noexcept
   return irs::type<irs::frequency>::id() == type ? pfreq_ : nullptr;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @struct cached_block
+/// @brief term dictionary block data shared via 'block_cache::instance()'
+///////////////////////////////////////////////////////////////////////////////
+struct cached_block {
+  size_t memory() const noexcept {
+    return sizeof(*this) + suffix.capacity() + stats.capacity();
+  }
+
+  bstring suffix; // decrypted suffix data
+  bstring stats; // stats data
+  uint64_t ent_count{}; // number of entries in a block
+  uint64_t end{}; // block end pointer
+  bool leaf{}; // block is leaf block
+  bool sub_blocks{}; // block may have sub-blocks
+}; // cached_block
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @class block_iterator
 ///////////////////////////////////////////////////////////////////////////////
@@ -1263,6 +1304,10 @@ class block_iterator : util::noncopyable {
 
   void load(index_input& in, encryption::stream* cipher);
 
+  // same as above, but looks up the block in 'block_cache::instance()'
+  // first and caches blocks which aren't directly accessible in 'in'
+  void load(index_input& in, encryption::stream* cipher, uint64_t file_id);
+
   bool next_sub_block() noexcept {
     if (!sub_count_) {
       return false;
@@ -1345,7 +1390,35 @@ class block_iterator : util::noncopyable {
   SeekResult scan_to_term_nonleaf(const bytes_ref& term);
   SeekResult scan_to_term_leaf(const bytes_ref& term);
 
+  struct read_info {
+    uint64_t suffix_size;
+    uint64_t stats_size;
+    bool sub_blocks; // block may have sub-blocks
+    bool direct; // suffix and stats are referenced directly in the input
+  };
+
+  read_info read(index_input& in, encryption::stream* cipher);
+
+  // hints 'in' to read the following sub-block of a floor block ahead
+  // of time, its size isn't known and is assumed to be similar to the
+  // current one, the blocks reached via seeks aren't known in advance
+  void prefetch_next(const index_input& in) const noexcept {
+    if (sub_count_) {
+      in.prefetch(cur_end_, cur_end_ - cur_start_);
+    }
+  }
+
+  void reset_entries(uint64_t end) noexcept {
+    cur_end_ = end;
+    cur_ent_ = 0;
+    cur_block_start_ = UNDEFINED;
+    term_count_ = 0;
+    cur_stats_ent_ = 0;
+    dirty_ = false;
+  }
+
   byte_weight header_; // block header
+  std::shared_ptr<const cached_block> cached_; // cached suffix and stats data
   bstring suffix_block_; // suffix data block
   bstring stats_block_; // statis data block
   const byte_type* header_begin_{header_.c_str()}; // beginning of block header stream
@@ -1400,19 +1473,88 @@ void block_iterator::load(index_input& in, irs::encryption::stream* cipher) {
     return;
   }
 
+  read(in, cipher);
+  reset_entries(in.file_pointer());
+  prefetch_next(in);
+}
+
+void block_iterator::load(
+    index_input& in,
+    irs::encryption::stream* cipher,
+    uint64_t file_id) {
+  if (!dirty_) {
+    return;
+  }
+
+  auto& cache = block_cache::instance();
+  const block_cache::key key{ file_id, cur_start_ };
+
+  if (auto cached = cache.find(key); cached) {
+    cached_ = std::static_pointer_cast<const cached_block>(std::move(cached));
+
+    ent_count_ = cached_->ent_count;
+    if (!cached_->sub_blocks) {
+      sub_count_ = 0; // no sub-blocks
+    }
+    leaf_ = cached_->leaf;
+    suffix_begin_ = cached_->suffix.c_str();
+    stats_begin_ = cached_->stats.c_str();
+#ifdef IRESEARCH_DEBUG
+    suffix_end_ = suffix_begin_ + cached_->suffix.size();
+    stats_end_ = stats_begin_ + cached_->stats.size();
+#endif // IRESEARCH_DEBUG
+
+    reset_entries(cached_->end);
+    return;
+  }
+
+  const auto info = read(in, cipher);
+
+  if (info.direct) {
+    // nothing to gain from caching the data which is already in memory
+    reset_entries(in.file_pointer());
+    prefetch_next(in);
+    return;
+  }
+
+  auto block = std::make_shared<cached_block>();
+  block->suffix.assign(suffix_begin_, info.suffix_size);
+  block->stats.assign(stats_begin_, info.stats_size);
+  block->ent_count = ent_count_;
+  block->end = in.file_pointer();
+  block->leaf = leaf_;
+  block->sub_blocks = info.sub_blocks;
+
+  const auto size = block->memory();
+  cache.insert(key, std::move(block), size);
+
+  reset_entries(in.file_pointer());
+  prefetch_next(in);
+}
+
+block_iterator::read_info block_iterator::read(
+    index_input& in,
+    irs::encryption::stream* cipher) {
+  read_info info;
+  info.direct = true;
+  cached_ = nullptr;
+
   in.seek(cur_start_);
-  if (shift_unpack_64(in.read_vint(), ent_count_)) {
+  info.sub_blocks = !shift_unpack_64(in.read_vint(), ent_count_);
+  if (!info.sub_blocks) {
     sub_count_ = 0; // no sub-blocks
   }
 
   // read suffix block
   uint64_t block_size;
   leaf_ = shift_unpack_64(in.read_vlong(), block_size);
+  info.suffix_size = block_size;
 
   // for non-encrypted index try direct buffer access first
   suffix_begin_ = cipher ? nullptr : in.read_buffer(block_size, BufferHint::PERSISTENT);
 
   if (!suffix_begin_) {
+    info.direct = false;
     string_utils::oversize(suffix_block_, block_size);
 #ifdef IRESEARCH_DEBUG
     const auto read = in.read_bytes(&(suffix_block_[0]), block_size);
@@ -1433,11 +1575,13 @@ void block_iterator::load(index_input& in, irs::encryption::stream* cipher) {
 
   // read stats block
   block_size = in.read_vlong();
+  info.stats_size = block_size;
 
   // try direct buffer access first
   stats_begin_ = in.read_buffer(block_size, BufferHint::PERSISTENT);
 
   if (!stats_begin_) {
+    info.direct = false;
     string_utils::oversize(stats_block_, block_size);
 #ifdef IRESEARCH_DEBUG
     const auto read = in.read_bytes(&(stats_block_[0]), block_size);
@@ -1452,12 +1596,7 @@ void block_iterator::load(index_input& in, irs::encryption::stream* cipher) {
   stats_end_ = stats_begin_ + block_size;
 #endif // IRESEARCH_DEBUG
 
-  cur_end_ = in.file_pointer();
-  cur_ent_ = 0;
-  cur_block_start_ = UNDEFINED;
-  term_count_ = 0;
-  cur_stats_ent_ = 0;
-  dirty_ = false;
+  return info;
 }
 
 template<typename Reader>
@@ -1737,6 +1876,73 @@ void block_iterator::reset() {
 #endif // IRESEARCH_DEBUG
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @class term_meta_cache
+/// @brief small per-thread cache of the term states found by exact term
+///        lookups, allows to skip term dictionary traversal for the terms
+///        requested repeatedly
+/// @note entries are identified by the terms file and the field meta
+///       address, since file identifiers are never reused stale entries
+///       of closed readers are never matched
+///////////////////////////////////////////////////////////////////////////////
+class term_meta_cache : util::noncopyable {
+ public:
+  static constexpr size_t SIZE = 256; // number of slots, power of 2
+
+  struct entry {
+    const field_meta* field{};
+    uint64_t file{};
+    bstring term;
+    version10::term_meta meta;
+    uint32_t freq{};
+  }; // entry
+
+  static term_meta_cache& instance() {
+    thread_local term_meta_cache cache;
+    return cache;
+  }
+
+  const entry* find(
+      uint64_t file,
+      const field_meta& field,
+      const bytes_ref& term) const noexcept {
+    auto& entry = entries_[slot(file, field, term)];
+
+    return entry.field == &field && entry.file == file && entry.term == term
+      ? &entry
+      : nullptr;
+  }
+
+  void insert(
+      uint64_t file,
+      const field_meta& field,
+      const bytes_ref& term,
+      const version10::term_meta& meta,
+      uint32_t freq) {
+    auto& entry = entries_[slot(file, field, term)];
+    entry.field = nullptr; // invalidate entry in case of exception
+    entry.term.assign(term.c_str(), term.size());
+    entry.file = file;
+    entry.meta = meta;
+    entry.freq = freq;
+    entry.field = &field;
+  }
+
+ private:
+  static size_t slot(
+      uint64_t file,
+      const field_meta& field,
+      const bytes_ref& term) noexcept {
+    const auto hash = hash_combine(
+      hash_combine(std::hash<uint64_t>()(file), &field),
+      std::hash<bytes_ref>()(term));
+
+    return hash & (SIZE - 1);
+  }
+
+  entry entries_[SIZE];
+}; // term_meta_cache
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @class term_iterator_base
 /// @brief base class for term_iterator and automaton_term_iterator
@@ -1749,6 +1955,8 @@ class term_iterator_base
       postings_reader& postings,
       const index_input& terms_in,
       irs::encryption::stream* terms_cipher,
+      uint64_t terms_file_id,
+      bool cache_blocks,
       payload* pay = nullptr)
     : attributes{{
         { type<version10::term_meta>::id(), &state_ },
@@ -1758,7 +1966,9 @@ class term_iterator_base
       field_(&field),
       postings_(&postings),
       terms_in_source_(&terms_in),
-      terms_cipher_(terms_cipher) {
+      terms_cipher_(terms_cipher),
+      terms_file_id_(terms_file_id),
+      cache_blocks_(cache_blocks) {
   }
 
   // read attributes
@@ -1805,6 +2015,16 @@ class term_iterator_base
     return terms_cipher_;
   }
 
+  // load block via shared cache of term dictionary blocks unless
+  // the blocks are read in place
+  void load(block_iterator& block) {
+    if (cache_blocks_) {
+      block.load(terms_input(), terms_cipher_, terms_file_id_);
+    } else {
+      block.load(terms_input(), terms_cipher_);
+    }
+  }
+
  protected:
   void copy(const byte_type* suffix, size_t prefix_size, size_t suffix_size) {
     const auto size = prefix_size + suffix_size;
@@ -1821,6 +2041,8 @@ class term_iterator_base
   postings_reader* postings_;
   const index_input* terms_in_source_;
   irs::encryption::stream* terms_cipher_;
+  uint64_t terms_file_id_; // identifies terms file in 'block_cache'
+  bool cache_blocks_; // terms blocks are shared via 'block_cache'
   mutable version10::term_meta state_;
   frequency freq_;
   mutable index_input::ptr terms_in_;
@@ -1857,33 +2079,63 @@ class term_iterator final : public term_iterator_base {
       postings_reader& postings,
       const index_input& terms_in,
       irs::encryption::stream* terms_cipher,
-      const FST& fst)
-    : term_iterator_base(field, postings, terms_in, terms_cipher, nullptr),
-      fst_(&fst),
-      matcher_(&fst, fst::MATCH_INPUT) { // pass pointer to avoid copying FST
+      uint64_t terms_file_id,
+      bool cache_blocks,
+      std::shared_ptr<const FST> fst)
+    : term_iterator_base(field, postings, terms_in, terms_cipher,
+                         terms_file_id, cache_blocks, nullptr),
+      fst_(std::move(fst)),
+      matcher_(fst_.get(), fst::MATCH_INPUT) { // pass pointer to avoid copying FST
+    assert(fst_);
   }
 
   virtual bool next() override;
   virtual SeekResult seek_ge(const bytes_ref& term) override;
   virtual bool seek(const bytes_ref& term) override {
-    return SeekResult::FOUND == seek_equal(term);
+    const auto* cached = term_meta_cache::instance().find(
+      terms_file_id_, field(), term);
+
+    if (cached) {
+      // term state has been read by the recent lookup
+      state_ = cached->meta;
+      freq_.value = cached->freq;
+      term_.reset();
+      term_ += term;
+      reset_seek_state();
+      return true;
+    }
+
+    cache_state_ = false;
+
+    if (SeekResult::FOUND != seek_equal(term)) {
+      return false;
+    }
+
+    cache_state_ = true; // cache term state once it's read
+    return true;
   }
   virtual bool seek(
       const bytes_ref& term,
       const irs::seek_term_iterator::seek_cookie& cookie) override {
     term_iterator_base::seek(term, cookie);
-
-    // reset seek state
-    sstate_.clear();
-
-    // mark block as invalid
-    cur_block_ = nullptr;
+    reset_seek_state();
     return true;
   }
 
   virtual void read() override {
-    assert(cur_block_);
+    if (!cur_block_) {
+      // state has been restored from cookie or term state cache
+      assert(!term_.empty());
+      return;
+    }
+
     term_iterator_base::read(*cur_block_);
+
+    if (cache_state_) {
+      term_meta_cache::instance().insert(
+        terms_file_id_, field(), term_, state_, freq_.value);
+      cache_state_ = false;
+    }
   }
 
   virtual doc_iterator::ptr postings(const flags& features) const override {
@@ -1962,11 +2214,21 @@ class term_iterator final : public term_iterator_base {
     return &block_stack_.back();
   }
 
-  const FST* fst_;
+  void reset_seek_state() noexcept {
+    // reset seek state
+    sstate_.clear();
+
+    // mark block as invalid
+    cur_block_ = nullptr;
+    cache_state_ = false;
+  }
+
+  std::shared_ptr<const FST> fst_; // keeps lazily loaded FST alive
   matcher_t matcher_;
   seek_state_t sstate_;
   block_stack_t block_stack_;
   block_iterator* cur_block_{};
+  bool cache_state_{}; // iterator is at the term found by exact lookup
 }; // term_iterator
 
 // -----------------------------------------------------------------------------
@@ -1975,12 +2237,14 @@ class term_iterator final : public term_iterator_base {
 
 template<typename FST>
 bool term_iterator<FST>::next() {
+  cache_state_ = false;
+
   // iterator at the beginning or seek to cached state was called
   if (!cur_block_) {
     if (term_.empty()) {
       // iterator at the beginning
       cur_block_ = push_block(fst_->Final(fst_->Start()), 0);
-      cur_block_->load(terms_input(), terms_cipher());
+      load(*cur_block_);
     } else {
       // seek to the term with the specified state was called from
       // term_iterator::seek(const bytes_ref&, const attribute&),
@@ -2001,7 +2265,7 @@ bool term_iterator<FST>::next() {
   // pop finished blocks
   while (cur_block_->end()) {
     if (cur_block_->next_sub_block()) {
-      cur_block_->load(terms_input(), terms_cipher());
+      load(*cur_block_);
     } else if (&block_stack_.front() == cur_block_) { // root
       term_.reset();
       cur_block_->reset();
@@ -2015,7 +2279,7 @@ bool term_iterator<FST>::next() {
         // here we're currently at non block that was not loaded yet
         assert(cur_block_->prefix() < term_.size());
         cur_block_->scan_to_sub_block(term_[cur_block_->prefix()]); // to sub-block
-        cur_block_->load(terms_input(), terms_cipher());
+        load(*cur_block_);
         cur_block_->scan_to_block(start);
       }
     }
@@ -2032,7 +2296,7 @@ bool term_iterator<FST>::next() {
        EntryType::ET_BLOCK == cur_block_->type();
        cur_block_->next(copy_suffix)) {
     cur_block_ = push_block(cur_block_->block_start(), term_.size());
-    cur_block_->load(terms_input(), terms_cipher());
+    load(*cur_block_);
   }
 
   return true;
@@ -2192,7 +2456,7 @@ SeekResult term_iterator<FST>::seek_equal(const bytes_ref& term) {
     std::memcpy(term_.data() + prefix, suffix, suffix_size);
   };
 
-  cur_block_->load(terms_input(), terms_cipher());
+  load(*cur_block_);
 
   assert(starts_with(term, term_));
   return cur_block_->scan_to_term(term, append_suffix);
@@ -2200,6 +2464,8 @@ SeekResult term_iterator<FST>::seek_equal(const bytes_ref& term) {
 
 template<typename FST>
 SeekResult term_iterator<FST>::seek_ge(const bytes_ref& term) {
+  cache_state_ = false;
+
   size_t prefix;
   if (seek_to_block(term, prefix)) {
     return SeekResult::FOUND;
@@ -2216,7 +2482,7 @@ SeekResult term_iterator<FST>::seek_ge(const bytes_ref& term) {
     std::memcpy(term_.data() + prefix, suffix, suffix_size);
   };
 
-  cur_block_->load(terms_input(), terms_cipher());
+  load(*cur_block_);
 
   assert(starts_with(term, term_));
   switch (cur_block_->scan_to_term(term, append_suffix)) {
@@ -2231,7 +2497,7 @@ SeekResult term_iterator<FST>::seek_ge(const bytes_ref& term) {
         case ET_BLOCK:
           // we're at the greater block, load it and call next
           cur_block_ = push_block(cur_block_->block_start(), term_.size());
-          cur_block_->load(terms_input(), terms_cipher());
+          load(*cur_block_);
           break;
         default:
           assert(false);
@@ -2258,10 +2524,13 @@ class automaton_term_iterator final : public term_iterator_base {
                                    postings_reader& postings,
                                    const index_input& terms_in,
                                    irs::encryption::stream* terms_cipher,
-                                   const FST& fst,
+                                   uint64_t terms_file_id,
+                                   bool cache_blocks,
+                                   std::shared_ptr<const FST> fst,
                                    automaton_table_matcher& matcher)
-    : term_iterator_base(field, postings, terms_in, terms_cipher, &payload_),
-      fst_(&fst),
+    : term_iterator_base(field, postings, terms_in, terms_cipher,
+                         terms_file_id, cache_blocks, &payload_),
+      fst_(std::move(fst)),
       acceptor_(&matcher.GetFst()),
       matcher_(&matcher) {
     // init payload value
@@ -2419,7 +2688,7 @@ class automaton_term_iterator final : public term_iterator_base {
     return &block_stack_.back();
   }
 
-  const FST* fst_;
+  std::shared_ptr<const FST> fst_; // keeps lazily loaded FST alive
   const automaton* acceptor_;
   automaton_table_matcher* matcher_;
   block_stack_t block_stack_;
@@ -2435,7 +2704,7 @@ bool automaton_term_iterator<FST>::next() {
     if (term_.empty()) {
       // iterator at the beginning
       cur_block_ = push_block(fst_->Final(fst_->Start()), 0, acceptor_->Start());
-      cur_block_->load(terms_input(), terms_cipher());
+      load(*cur_block_);
     } else {
       // seek to the term with the specified state was called from
       // term_iterator::seek(const bytes_ref&, const attribute&),
@@ -2511,7 +2780,7 @@ bool automaton_term_iterator<FST>::next() {
       case ET_BLOCK: {
         copy(suffix, cur_block_->prefix(), suffix_size);
         cur_block_ = push_block(cur_block_->block_start(), term_.size(), state);
-        cur_block_->load(terms_input(), terms_cipher());
+        load(*cur_block_);
       } break;
       default: {
         assert(false);
@@ -2548,7 +2817,7 @@ bool automaton_term_iterator<FST>::next() {
         } else {
           cur_block_->next_sub_block();
         }
-        cur_block_->load(terms_input(), terms_cipher());
+        load(*cur_block_);
       } else if (&block_stack_.front() == cur_block_) { // root
         term_.reset();
         cur_block_->reset();
@@ -2561,7 +2830,7 @@ bool automaton_term_iterator<FST>::next() {
           // here we're currently at non block that was not loaded yet
           assert(cur_block_->prefix() < term_.size());
           cur_block_->scan_to_sub_block(term_[cur_block_->prefix()]); // to sub-block
-          cur_block_->load(terms_input(), terms_cipher());
+          load(*cur_block_);
           cur_block_->scan_to_block(start);
         }
       }
@@ -2600,6 +2869,7 @@ bool automaton_term_iterator<FST>::next() {
 class field_reader final : public irs::field_reader {
  public:
   explicit field_reader(irs::postings_reader::ptr&& pr);
+  virtual ~field_reader();
 
   virtual void prepare(
     const directory& dir,
@@ -2625,33 +2895,149 @@ class field_reader final : public irs::field_reader {
     virtual void prepare(index_input& in, const feature_map_t& features) override {
       term_reader_base::prepare(in, features);
 
-      // read FST
-      input_buf isb(&in);
-      std::istream input(&isb); // wrap stream to be OpenFST compliant
-      fst_.reset(FST::Read(input, fst_read_options()));
+      if constexpr (std::is_same_v<FST, immutable_byte_fst>) {
+        const bool lazy = owner_->index_mode_ != burst_trie::TermIndexMode::EAGER;
 
-      if (!fst_) {
-        throw irs::index_error(string_utils::to_string(
-          "failed to read term index for field '%s'",
-          meta().name.c_str()));
+        if (owner_->version_ >= burst_trie::Version::FST_SIZE) {
+          const uint64_t size = in.read_vlong();
+
+          if (lazy) {
+            // defer reading FST till the first access
+            fst_offset_ = in.file_pointer();
+
+            if (size > in.length() - fst_offset_) {
+              throw irs::index_error(string_utils::to_string(
+                "invalid term index size '" IR_UINT64_T_SPECIFIER "' for field '%s'",
+                size, meta().name.c_str()));
+            }
+
+            in.seek(fst_offset_ + size);
+            fst_size_ = size;
+            fst_checksum_ = in.read_long();
+            return;
+          }
+
+          fst_ = read_fst(in, false);
+          in.read_long(); // verified as a part of the whole term index
+          return;
+        } else if (lazy) {
+          // defer reading FST till the first access, size of FST isn't
+          // stored in older versions, so it's decoded to find its end
+          fst_offset_ = in.file_pointer();
+
+          if (!FST::Skip(in)) {
+            throw irs::index_error(string_utils::to_string(
+              "failed to read term index for field '%s'",
+              meta().name.c_str()));
+          }
+
+          return;
+        }
       }
+
+      fst_ = read_fst(in, false);
     }
 
     virtual seek_term_iterator::ptr iterator() const override {
       return memory::make_managed<term_iterator<FST>>(
         meta(), *owner_->pr_, *owner_->terms_in_,
-        owner_->terms_in_cipher_.get(), *fst_);
+        owner_->terms_in_cipher_.get(), owner_->terms_file_id_,
+        owner_->cache_terms_blocks_, fst());
     }
 
     virtual seek_term_iterator::ptr iterator(automaton_table_matcher& matcher) const override {
       return memory::make_managed<automaton_term_iterator<FST>>(
         meta(), *owner_->pr_, *owner_->terms_in_,
-        owner_->terms_in_cipher_.get(), *fst_, matcher);
+        owner_->terms_in_cipher_.get(), owner_->terms_file_id_,
+        owner_->cache_terms_blocks_, fst(), matcher);
     }
 
    private:
+    std::shared_ptr<const FST> read_fst(index_input& in, bool share_weights) const {
+      std::shared_ptr<const FST> fst;
+
+      if constexpr (std::is_same_v<FST, immutable_byte_fst>) {
+        fst.reset(FST::Read(in, share_weights));
+      } else {
+        UNUSED(share_weights);
+        input_buf isb(&in);
+        std::istream input(&isb); // wrap stream to be OpenFST compliant
+        fst.reset(FST::Read(input, fst_read_options()));
+      }
+
+      if (!fst) {
+        throw irs::index_error(string_utils::to_string(
+          "failed to read term index for field '%s'",
+          meta().name.c_str()));
+      }
+
+      return fst;
+    }
+
+    std::shared_ptr<const FST> fst() const {
+      if constexpr (!std::is_same_v<FST, immutable_byte_fst>) {
+        return fst_; // always read eagerly
+      } else {
+        auto fst = std::atomic_load(&fst_);
+
+        if (fst) {
+          // already loaded
+          return fst;
+        }
+
+        const bool evictable =
+          burst_trie::TermIndexMode::LAZY_EVICTABLE == owner_->index_mode_;
+        auto& cache = block_cache::instance();
+        const block_cache::key key{ owner_->index_file_id_, fst_offset_ };
+
+        if (evictable) {
+          auto cached = cache.find(key);
+
+          if (cached) {
+            return std::static_pointer_cast<const FST>(std::move(cached));
+          }
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(owner_->index_mutex_);
+
+          fst = std::atomic_load(&fst_);
+
+          if (fst) {
+            // loaded by another thread
+            return fst;
+          }
+
+          assert(owner_->index_in_);
+          owner_->index_in_->seek(fst_offset_);
+
+          if (owner_->version_ >= burst_trie::Version::FST_SIZE
+              && fst_checksum_ != owner_->index_in_->checksum(fst_size_)) {
+            throw irs::index_error(string_utils::to_string(
+              "invalid term index checksum for field '%s'",
+              meta().name.c_str()));
+          }
+
+          fst = read_fst(*owner_->index_in_, true);
+
+          if (!evictable) {
+            std::atomic_store(&fst_, fst);
+            return fst;
+          }
+        }
+
+        // FST may have been cached by another thread
+        const auto size = fst->GetImpl()->Memory();
+        return std::static_pointer_cast<const FST>(
+          cache.insert(key, std::move(fst), size));
+      }
+    }
+
     field_reader* owner_;
-    std::unique_ptr<FST> fst_;
+    mutable std::shared_ptr<const FST> fst_; // nullptr until loaded or if evictable
+    uint64_t fst_offset_{}; // offset of FST in term index
+    uint64_t fst_size_{}; // byte size of FST in term index
+    int64_t fst_checksum_{}; // checksum of FST in term index
   }; // term_reader
 
   using vector_fst_reader = term_reader<vector_byte_fst>;
@@ -2665,6 +3051,14 @@ class field_reader final : public irs::field_reader {
   irs::postings_reader::ptr pr_;
   encryption::stream::ptr terms_in_cipher_;
   index_input::ptr terms_in_;
+  encryption::stream::ptr index_in_cipher_;
+  index_input::ptr index_in_; // term index, kept open for lazy loading only
+  std::mutex index_mutex_; // guards 'index_in_'
+  uint64_t index_file_id_{ block_cache::next_file_id() };
+  uint64_t terms_file_id_{ block_cache::next_file_id() };
+  bool cache_terms_blocks_{ true }; // terms blocks aren't directly accessible
+  burst_trie::TermIndexMode index_mode_{ burst_trie::TermIndexMode::EAGER };
+  burst_trie::Version version_{ burst_trie::Version::MAX }; // term index version
 }; // field_reader
 
 // -----------------------------------------------------------------------------
@@ -2676,6 +3070,13 @@ field_reader::field_reader(irs::postings_reader::ptr&& pr)
   assert(pr_);
 }
 
+field_reader::~field_reader() {
+  auto& cache = block_cache::instance();
+  // evict FSTs of this reader, cached FSTs may reference 'index_in_' data
+  cache.erase(index_file_id_);
+  cache.erase(terms_file_id_);
+}
+
 void field_reader::prepare(
     const directory& dir,
     const segment_meta& meta,
@@ -2693,19 +3094,23 @@ void field_reader::prepare(
   state.dir = &dir;
   state.meta = &meta;
 
+  index_mode_ = burst_trie::term_index_mode();
+
   // check index header
   index_input::ptr index_in;
 
-  int64_t checksum = 0;
-
+  // term index is scanned sequentially on open, FSTs loaded lazily
+  // are read through another input opened for random access
   const auto term_index_version = burst_trie::Version(prepare_input(
     filename, index_in,
-    irs::IOAdvice::SEQUENTIAL | irs::IOAdvice::READONCE, state,
+    burst_trie::TermIndexMode::EAGER == index_mode_
+      ? irs::IOAdvice::SEQUENTIAL | irs::IOAdvice::READONCE
+      : irs::IOAdvice::SEQUENTIAL,
+    state,
     field_writer::TERMS_INDEX_EXT,
     field_writer::FORMAT_TERMS_INDEX,
     static_cast<int32_t>(burst_trie::Version::MIN),
-    static_cast<int32_t>(burst_trie::Version::MAX),
-    &checksum));
+    static_cast<int32_t>(burst_trie::Version::MAX)));
 
   constexpr const size_t FOOTER_LEN =
       sizeof(uint64_t) // fields count
@@ -2720,36 +3125,45 @@ void field_reader::prepare(
 
     fields_count = index_in->read_long();
 
-    // check index checksum
-    format_utils::check_footer(*index_in, checksum);
+    if (burst_trie::TermIndexMode::EAGER != index_mode_
+        && term_index_version >= burst_trie::Version::FST_SIZE) {
+      // don't read the whole term index on open,
+      // checksum of FST is checked once it's loaded
+      format_utils::read_checksum(*index_in);
+    } else {
+      // check index checksum
+      format_utils::check_footer(*index_in, format_utils::checksum(*index_in));
+    }
 
     index_in->seek(ptr);
   }
 
   auto* enc = get_encryption(dir.attributes());
   encryption::stream::ptr index_in_cipher;
+  uint64_t index_data_offset = 0; // offset of possibly encrypted data
 
   if (term_index_version > burst_trie::Version::MIN) {
     if (irs::decrypt(filename, *index_in, enc, index_in_cipher)) {
       assert(index_in_cipher && index_in_cipher->block_size());
 
-      const auto blocks_in_buffer = math::div_ceil64(
-        buffered_index_input::DEFAULT_BUFFER_SIZE,
-        index_in_cipher->block_size());
-
+      index_data_offset = index_in->file_pointer();
       index_in = memory::make_unique<encrypted_input>(
         std::move(index_in),
         *index_in_cipher,
-        blocks_in_buffer,
+        index_blocks_in_buffer(*index_in_cipher),
         FOOTER_LEN);
     }
   }
 
   read_segment_features(*index_in, feature_map, features);
 
+  version_ = term_index_version;
+
   // read terms for each indexed field
   if (term_index_version <= burst_trie::Version::ENCRYPTION_MIN) {
+    // lazy loading is supported for fst::fstext::ImmutableFst<...> only
     fields_ = vector_fst_readers{};
+    index_mode_ = burst_trie::TermIndexMode::EAGER;
   }
 
   std::visit([&](auto& fields) {
@@ -2784,6 +3198,29 @@ void field_reader::prepare(
     }
   }, fields_);
 
+  if (burst_trie::TermIndexMode::EAGER != index_mode_) {
+    index_in.reset();
+    index_in = dir.open(filename, irs::IOAdvice::RANDOM);
+
+    if (!index_in) {
+      throw io_error(string_utils::to_string(
+        "failed to open file, path: %s",
+        filename.c_str()));
+    }
+
+    if (index_in_cipher) {
+      index_in->seek(index_data_offset);
+      index_in = memory::make_unique<encrypted_input>(
+        std::move(index_in),
+        *index_in_cipher,
+        index_blocks_in_buffer(*index_in_cipher),
+        FOOTER_LEN);
+    }
+
+    index_in_cipher_ = std::move(index_in_cipher);
+    index_in_ = std::move(index_in);
+  }
+
   //-----------------------------------------------------------------
   // prepare terms input
   //-----------------------------------------------------------------
@@ -2810,6 +3247,12 @@ void field_reader::prepare(
     }
   }
 
+  if (!terms_in_cipher_) {
+    // blocks are read in place if the input serves persistent buffers,
+    // e.g. memory mapped files, there's nothing to gain from caching them
+    cache_terms_blocks_ = !terms_in_->read_buffer(0, BufferHint::PERSISTENT);
+  }
+
   // prepare postings reader
   pr_->prepare(*terms_in_, state, features);
 
@@ -2995,6 +3438,8 @@ class dumper : util::noncopyable {
 namespace iresearch {
 namespace burst_trie {
 
+static std::atomic<TermIndexMode> INDEX_MODE{ TermIndexMode::EAGER };
+
 irs::field_writer::ptr make_writer(
     Version version,
     irs::postings_writer::ptr&& writer,
@@ -3006,5 +3451,13 @@ irs::field_reader::ptr make_reader(irs::postings_reader::ptr&& reader) {
   return memory::make_unique<::field_reader>(std::move(reader));
 }
 
+void term_index_mode(TermIndexMode mode) noexcept {
+  INDEX_MODE.store(mode, std::memory_order_relaxed);
+}
+
+TermIndexMode term_index_mode() noexcept {
+  return INDEX_MODE.load(std::memory_order_relaxed);
+}
+
 } // burst_trie
 } // iresearch
@@ -45,9 +45,54 @@ enum class Version : int32_t {
   /// * encryption support
   /// * term dictionary stored on disk as fst::fstext::ImmutableFst<...>
   ////////////////////////////////////////////////////////////////////////////
-  MAX = 2
+  IMMUTABLE_FST = 2,
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// * encryption support
+  /// * term dictionary stored on disk as fst::fstext::ImmutableFst<...>
+  /// * byte size of a term dictionary is stored ahead of it, i.e. FSTs
+  ///   are skipped without being decoded
+  /// * checksum of a term dictionary is stored after it, i.e. FSTs loaded
+  ///   lazily are verified without reading the whole term index on open
+  ////////////////////////////////////////////////////////////////////////////
+  FST_SIZE = 3,
+
+  MAX = FST_SIZE
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief defines when term index (FST) of a field is read by 'field_reader'
+////////////////////////////////////////////////////////////////////////////////
+enum class TermIndexMode {
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief read FSTs of all fields on segment open
+  ////////////////////////////////////////////////////////////////////////////
+  EAGER,
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief read FST of a field on first access and keep it while
+  ///        the segment is open
+  ////////////////////////////////////////////////////////////////////////////
+  LAZY,
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief read FST of a field on first access and keep it in
+  ///        'block_cache::instance()', i.e. FSTs of rarely accessed fields
+  ///        are evicted once the cache budget is exceeded and read again
+  ///        on the next access
+  ////////////////////////////////////////////////////////////////////////////
+  LAZY_EVICTABLE
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sets term index mode for the readers prepared afterwards,
+///        'TermIndexMode::EAGER' by default
+/// @note segments written with 'Version::ENCRYPTION_MIN' and earlier are
+///       always read eagerly
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void term_index_mode(TermIndexMode mode) noexcept;
+IRESEARCH_API TermIndexMode term_index_mode() noexcept;
+
 irs::field_writer::ptr make_writer(
   Version version,
   irs::postings_writer::ptr&& writer,
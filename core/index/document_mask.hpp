@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_DOCUMENT_MASK_H
+#define IRESEARCH_DOCUMENT_MASK_H
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+
+#include "utils/bitvector.hpp"
+#include "utils/math_utils.hpp"
+#include "utils/type_limits.hpp"
+
+namespace iresearch {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class document_mask
+/// @brief a set of masked (i.e. removed) documents of a segment, bit 'doc' of
+///        the underlying bitvector is set for every masked 'doc', that gives
+///        constant time lookups and word-level access for postings filtering
+////////////////////////////////////////////////////////////////////////////////
+class document_mask {
+ public:
+  using word_t = bitvector::word_t;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @class const_iterator
+  /// @brief iterates over masked documents in ascending order
+  //////////////////////////////////////////////////////////////////////////////
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = doc_id_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const doc_id_t*;
+    using reference = const doc_id_t&;
+
+    reference operator*() const noexcept { return doc_; }
+
+    const_iterator& operator++() noexcept {
+      doc_ = next(doc_ + 1);
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator& rhs) const noexcept {
+      return doc_ == rhs.doc_;
+    }
+
+    bool operator!=(const const_iterator& rhs) const noexcept {
+      return !(*this == rhs);
+    }
+
+   private:
+    friend class document_mask;
+
+    const_iterator(const bitvector& bits, doc_id_t doc) noexcept
+      : bits_(&bits), doc_(doc) {
+    }
+
+    // @return first masked document not less than 'doc', or 'eof' if none
+    doc_id_t next(size_t doc) const noexcept {
+      auto i = bitset::word(doc);
+      const auto words = bits_->words();
+
+      if (i >= words) {
+        return doc_limits::eof();
+      }
+
+      // skip bits preceding 'doc' in its word
+      auto word = bits_->data()[i] & (~word_t(0) << bitset::bit(doc));
+
+      while (!word) {
+        if (++i >= words) {
+          return doc_limits::eof();
+        }
+
+        word = bits_->data()[i];
+      }
+
+      return doc_id_t(bitset::bit_offset(i) + math::math_traits<word_t>::ctz(word));
+    }
+
+    const bitvector* bits_;
+    doc_id_t doc_;
+  }; // const_iterator
+
+  using value_type = doc_id_t;
+  using iterator = const_iterator;
+
+  document_mask() = default;
+
+  document_mask(std::initializer_list<doc_id_t> docs) {
+    for (const auto doc : docs) {
+      insert(doc);
+    }
+  }
+
+  bool operator==(const document_mask& rhs) const noexcept {
+    if (count_ != rhs.count_) {
+      return false;
+    }
+
+    for (const auto doc : *this) {
+      if (!rhs.contains(doc)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool operator!=(const document_mask& rhs) const noexcept {
+    return !(*this == rhs);
+  }
+
+  const_iterator begin() const noexcept {
+    const_iterator it(bits_, doc_limits::eof());
+    it.doc_ = it.next(0);
+    return it;
+  }
+
+  const_iterator end() const noexcept {
+    return const_iterator(bits_, doc_limits::eof());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return the underlying bits, bit 'doc' is set for every masked 'doc'
+  //////////////////////////////////////////////////////////////////////////////
+  const bitvector& bits() const noexcept { return bits_; }
+
+  void clear() noexcept {
+    bits_.clear();
+    count_ = 0;
+  }
+
+  bool contains(doc_id_t doc) const noexcept { return bits_.test(doc); }
+
+  bool empty() const noexcept { return 0 == count_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief masks the specified document
+  /// @return the document was not masked before
+  //////////////////////////////////////////////////////////////////////////////
+  bool insert(doc_id_t doc) {
+    assert(!doc_limits::eof(doc));
+
+    if (bits_.test(doc)) {
+      return false;
+    }
+
+    if (doc >= bits_.capacity()) {
+      // grow geometrically, bitvector allocates exactly the requested words
+      bits_.reserve(std::max(size_t(doc) + 1, 2 * bits_.capacity()));
+    }
+
+    bits_.set(doc);
+    ++count_;
+
+    return true;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief masks every document whose bit is set in 'bits'
+  //////////////////////////////////////////////////////////////////////////////
+  void insert(bitvector&& bits) {
+    if (empty()) {
+      bits_ = std::move(bits);
+    } else {
+      bits_ |= bits;
+    }
+
+    count_ = bits_.count();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief ensures documents up to and including 'max_doc' can be masked
+  ///        without reallocation
+  //////////////////////////////////////////////////////////////////////////////
+  void reserve(doc_id_t max_doc) { bits_.reserve(size_t(max_doc) + 1); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @return number of masked documents
+  //////////////////////////////////////////////////////////////////////////////
+  size_t size() const noexcept { return count_; }
+
+ private:
+  bitvector bits_;
+  size_t count_{}; // number of masked documents
+}; // document_mask
+
+}
+
+#endif
@@ -578,12 +578,20 @@ class term_iterator : public irs::term_iterator {
       const bytes_ref*& max) {
     // refill postings
     postings_.clear();
-    postings_.insert(field.terms_.begin(), field.terms_.end());
+    postings_.reserve(field.terms_.size());
+    for (auto& posting : field.terms_) {
+      postings_.emplace_back(&posting);
+    }
+    std::sort(
+      postings_.begin(), postings_.end(),
+      [](const posting* lhs, const posting* rhs) noexcept {
+        return memcmp_less(lhs->term, rhs->term);
+    });
 
     max = min = &irs::bytes_ref::NIL;
     if (!postings_.empty()) {
-      min = &(postings_.begin()->first);
-      max = &((--postings_.end())->first);
+      min = &(postings_.front()->term);
+      max = &(postings_.back()->term);
     }
 
     field_ = &field;
@@ -601,7 +609,7 @@ class term_iterator : public irs::term_iterator {
 
   virtual const bytes_ref& value() const noexcept override {
     assert(it_ != postings_.end());
-    return it_->first;
+    return (*it_)->term;
   }
 
   virtual attribute* get_mutable(type_info::type_id) noexcept override {
@@ -616,7 +624,7 @@ class term_iterator : public irs::term_iterator {
     REGISTER_TIMER_DETAILED();
     assert(it_ != postings_.end());
 
-    return (this->*POSTINGS[size_t(field_->prox_random_access())])(it_->second);
+    return (this->*POSTINGS[size_t(field_->prox_random_access())])(**it_);
   }
 
   virtual bool next() override {   
@@ -634,17 +642,7 @@ class term_iterator : public irs::term_iterator {
   }
 
  private:
-  struct less_t {
-    bool operator()(const bytes_ref& lhs, const bytes_ref& rhs) const noexcept {
-      return memcmp_less(lhs, rhs);
-    }
-  };
-
-  typedef std::map<
-    bytes_ref,
-    std::reference_wrapper<const posting>,
-    less_t
-  > map_t;
+  typedef std::vector<const posting*> postings_t; // sorted by term
 
   typedef irs::doc_iterator::ptr(term_iterator::*postings_f)(const posting&) const;
 
@@ -682,9 +680,9 @@ class term_iterator : public irs::term_iterator {
     return memory::to_managed<irs::doc_iterator, false>(&sorting_doc_itr_);
   }
 
-  map_t postings_;
-  map_t::iterator next_{ postings_.end() };
-  map_t::iterator it_{ postings_.end() };
+  postings_t postings_;
+  postings_t::const_iterator next_{ postings_.end() };
+  postings_t::const_iterator it_{ postings_.end() };
   const field_data* field_{};
   const doc_map* doc_map_{};
   mutable detail::doc_iterator doc_itr_;
@@ -1124,12 +1122,12 @@ bool field_data::invert(
 
     const auto res = terms_.emplace(term->value);
 
-    if (terms_.end() == res.first) {
+    if (!res.first) {
       IR_FRMT_ERROR("field '%s' has invalid term '%s'", meta_.name.c_str(), ref_cast<char>(term->value).c_str());
       continue;
     }
 
-    (this->*proc_table_[size_t(res.second)])(res.first->second, id, pay, offs);
+    (this->*proc_table_[size_t(res.second)])(*res.first, id, pay, offs);
 
     if (0 == ++len_) {
       IR_FRMT_ERROR(
@@ -1177,10 +1175,13 @@ field_data& fields_data::emplace(const hashed_string_ref& name) {
   ).first->second;
 }
 
-void fields_data::flush(field_writer& fw, flush_state& state) {
-  REGISTER_TIMER_DETAILED();
-
+void fields_data::prepare(field_writer& fw, flush_state& state) {
   state.features = &features_;
+  fw.prepare(state);
+}
+
+void fields_data::flush(field_writer& fw, const flush_state& state) {
+  REGISTER_TIMER_DETAILED();
 
   struct less_t {
     bool operator()(
@@ -1198,8 +1199,6 @@ void fields_data::flush(field_writer& fw, flush_state& state) {
     fields.emplace(&entry.second);
   }
 
-  fw.prepare(state);
-
   detail::term_reader terms;
 
   for (auto* field : fields) {
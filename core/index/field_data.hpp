@@ -31,6 +31,7 @@
 #include "index/iterators.hpp"
 
 #include "utils/block_pool.hpp"
+#include "utils/hash_utils.hpp"
 #include "utils/memory.hpp"
 #include "utils/noncopyable.hpp"
 
@@ -170,7 +171,17 @@ class IRESEARCH_API fields_data: util::noncopyable {
     return *this;
   }
   const flags& features() { return features_; }
-  void flush(field_writer& fw, flush_state& state);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief prepares 'fw' for writing the accumulated fields via 'flush'
+  //////////////////////////////////////////////////////////////////////////////
+  void prepare(field_writer& fw, flush_state& state);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief writes the accumulated fields via 'fw' prepared by 'prepare',
+  ///        doesn't access the directory
+  //////////////////////////////////////////////////////////////////////////////
+  void flush(field_writer& fw, const flush_state& state);
   void reset() noexcept;
 
  private:
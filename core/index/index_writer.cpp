@@ -27,6 +27,8 @@
 #include "comparer.hpp"
 #include "formats/format_utils.hpp"
 #include "search/exclusion.hpp"
+#include "search/term_filter.hpp"
+#include "search/terms_filter.hpp"
 #include "utils/bitvector.hpp"
 #include "utils/compression.hpp"
 #include "utils/directory_utils.hpp"
@@ -92,67 +94,256 @@ std::vector<irs::index_file_refs::ref_t> extract_refs(
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief apply any document removals based on filters in the segment
-/// @param modifications where to get document update_contexts from
-/// @param docs_mask where to apply document removals to
-/// @param readers readers by segment name
-/// @param meta key used to get reader for the segment to evaluate
-/// @param min_modification_generation smallest consider modification generation
-/// @return if any new records were added (modification_queries_ modified)
+/// @class modification_matches
+/// @brief documents of a segment matched by each of the modifications,
+///        'by_term' and 'by_terms' modifications are grouped by field and
+///        resolved by a single forward pass over the sorted terms of the
+///        field instead of preparing and executing a filter per modification,
+///        other modifications are prepared and executed as is
 ////////////////////////////////////////////////////////////////////////////////
-bool add_document_mask_modified_records(
-    modification_contexts_ref& modifications, // where to get document update_contexts from
-    irs::document_mask& docs_mask, // where to apply document removals to
-    irs::readers_cache& readers, // where to get segment readers from
-    irs::segment_meta& meta, // key used to get reader for the segment to evaluate
-    size_t min_modification_generation = 0
-) {
-  if (modifications.empty()) {
-    return false; // nothing new to flush
+class modification_matches : irs::util::noncopyable {
+ public:
+  modification_matches(
+      const std::vector<modification_contexts_ref>& modifications,
+      irs::readers_cache& readers, // where to get segment readers from
+      const irs::segment_meta& meta) { // segment to evaluate
+    size_t count = 0;
+
+    offsets_.reserve(modifications.size());
+
+    for (auto& entry : modifications) {
+      offsets_.emplace_back(count);
+      count += entry.size();
+    }
+
+    if (!count) {
+      return; // nothing to resolve
+    }
+
+    auto reader = readers.emplace(meta);
+
+    if (!reader) {
+      throw irs::index_error(irs::string_utils::to_string(
+        "while resolving modification queries against segment '%s', error: failed to open segment",
+        meta.name.c_str()
+      ));
+    }
+
+    ranges_.assign(count, range_t(0, 0));
+
+    std::vector<key_t> keys;
+    size_t i = 0;
+
+    for (auto& entry : modifications) {
+      for (auto& modification : entry) {
+        const auto* filter = modification.filter.get();
+
+        if (!filter) {
+          // skip invalid or uncommitted modification queries
+        } else if (irs::type<irs::by_term>::id() == filter->type()) {
+          const auto& by_term = static_cast<const irs::by_term&>(*filter);
+
+          keys.push_back({ by_term.field(), by_term.options().term, i });
+        } else if (irs::type<irs::by_terms>::id() == filter->type()) {
+          const auto& by_terms = static_cast<const irs::by_terms&>(*filter);
+
+          for (auto& term : by_terms.options().terms) {
+            keys.push_back({ by_terms.field(), term.term, i });
+          }
+        } else {
+          execute(*filter, reader, ranges_[i]);
+        }
+
+        ++i;
+      }
+    }
+
+    resolve(keys, reader);
   }
 
-  auto reader = readers.emplace(meta);
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief invokes 'visitor(doc)' in ascending order for every document
+  ///        matched by the modification 'i' of the entry 'entry'
+  //////////////////////////////////////////////////////////////////////////////
+  template<typename Visitor>
+  void visit(size_t entry, size_t i, Visitor visitor) const {
+    assert(entry < offsets_.size());
+    i += offsets_[entry];
 
-  if (!reader) {
-    throw irs::index_error(irs::string_utils::to_string(
-      "while adding document mask modified records to document_mask of segment '%s', error: failed to open segment",
-      meta.name.c_str()
-    ));
+    if (i >= ranges_.size()) {
+      return; // nothing was resolved
+    }
+
+    for (auto doc = ranges_[i].first, end = ranges_[i].second; doc < end; ++doc) {
+      visitor(docs_[doc]);
+    }
   }
 
-  bool modified = false;
+ private:
+  using range_t = std::pair<size_t, size_t>; // [begin, end) of 'docs_'
 
-  for (auto& modification : modifications) {
-    if (!modification.filter) {
-      continue; // skip invalid or uncommitted modification queries
+  struct key_t {
+    bool operator<(const key_t& rhs) const noexcept {
+      return field < rhs.field || (field == rhs.field && term < rhs.term);
     }
 
-    auto prepared = modification.filter->prepare(reader);
+    irs::string_ref field;
+    irs::bytes_ref term;
+    size_t modification;
+  };
+
+  void execute(
+      const irs::filter& filter,
+      const irs::sub_reader& reader,
+      range_t& range) {
+    range.first = range.second = docs_.size();
+
+    auto prepared = filter.prepare(reader);
 
     if (!prepared) {
-      continue; // skip invalid prepared filters
+      return; // skip invalid prepared filters
     }
 
     auto itr = prepared->execute(reader);
 
     if (!itr) {
-      continue; // skip invalid iterators
+      return; // skip invalid iterators
     }
 
     while (itr->next()) {
-      const auto doc_id = itr->value();
+      docs_.emplace_back(itr->value());
+    }
 
-      // if the indexed doc_id was insert()ed after the request for modification
-      // or the indexed doc_id was already masked then it should be skipped
-      if (modification.generation < min_modification_generation
-          || !docs_mask.insert(doc_id).second) {
-        continue; // the current modification query does not match any records
+    range.second = docs_.size();
+  }
+
+  void resolve(std::vector<key_t>& keys, const irs::sub_reader& reader) {
+    if (keys.empty()) {
+      return;
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<std::pair<size_t, range_t>> matches; // modification, documents
+    const irs::term_reader* field = nullptr;
+    irs::seek_term_iterator::ptr terms;
+    bool positioned = false; // 'terms' points to a term not less than a key
+    range_t range(0, 0); // documents of the last resolved key
+
+    matches.reserve(keys.size());
+
+    for (size_t i = 0, size = keys.size(); i < size; ++i) {
+      auto& key = keys[i];
+
+      if (!i || key.field != keys[i - 1].field) {
+        field = reader.field(key.field);
+        terms = field ? field->iterator() : nullptr;
+        positioned = false;
+      } else if (key.term == keys[i - 1].term) {
+        matches.emplace_back(key.modification, range); // same term, same documents
+        continue;
       }
 
-      assert(meta.live_docs_count);
-      --meta.live_docs_count; // decrement count of live docs
-      modification.seen = true;
-      modified = true;
+      range.first = range.second = docs_.size();
+
+      // range pre-check against the min/max terms of the field, it skips
+      // the dictionary lookup only for keys outside of the range, e.g. for
+      // monotonic ids added after the segment was flushed, keys spread
+      // uniformly over the range are always looked up
+      if (terms && (field->min)() <= key.term && key.term <= (field->max)()) {
+        if (!positioned || terms->value() < key.term) {
+          positioned = irs::SeekResult::END != terms->seek_ge(key.term);
+        }
+
+        if (positioned && terms->value() == key.term) {
+          terms->read();
+
+          for (auto it = terms->postings(irs::flags::empty_instance()); it->next(); ) {
+            docs_.emplace_back(it->value());
+          }
+
+          range.second = docs_.size();
+        }
+      }
+
+      matches.emplace_back(key.modification, range);
+    }
+
+    // join documents of every modification matching more than one term
+    std::sort(matches.begin(), matches.end());
+
+    for (auto begin = matches.begin(), end = matches.end(); begin != end; ) {
+      auto& modification = ranges_[begin->first];
+      auto next = begin + 1;
+
+      for (; next != end && next->first == begin->first; ++next) { }
+
+      if (next - begin == 1) {
+        modification = begin->second;
+      } else {
+        modification.first = docs_.size();
+
+        for (; begin != next; ++begin) {
+          for (auto doc = begin->second.first; doc < begin->second.second; ++doc) {
+            docs_.emplace_back(docs_[doc]);
+          }
+        }
+
+        std::sort(docs_.begin() + modification.first, docs_.end());
+        docs_.erase(std::unique(docs_.begin() + modification.first, docs_.end()), docs_.end());
+        modification.second = docs_.size();
+      }
+
+      begin = next;
+    }
+  }
+
+  std::vector<size_t> offsets_; // first modification of each entry
+  std::vector<range_t> ranges_; // documents matched by each modification
+  std::vector<irs::doc_id_t> docs_;
+}; // modification_matches
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief apply any document removals based on filters in the segment
+/// @param modifications where to get document update_contexts from
+/// @param matches documents of the segment matched by 'modifications'
+/// @param docs_mask where to apply document removals to
+/// @param meta segment to evaluate
+/// @param min_modification_generation smallest consider modification generation
+/// @return if any new records were added (modification_queries_ modified)
+////////////////////////////////////////////////////////////////////////////////
+bool add_document_mask_modified_records(
+    std::vector<modification_contexts_ref>& modifications, // where to get document update_contexts from
+    const modification_matches& matches, // documents matched by 'modifications'
+    irs::document_mask& docs_mask, // where to apply document removals to
+    irs::segment_meta& meta, // segment to evaluate
+    size_t min_modification_generation = 0
+) {
+  bool modified = false;
+
+  for (size_t entry = 0, entries = modifications.size(); entry < entries; ++entry) {
+    auto& entry_modifications = modifications[entry];
+
+    for (size_t i = 0, size = entry_modifications.size(); i < size; ++i) {
+      auto& modification = entry_modifications[i];
+
+      if (!modification.filter) {
+        continue; // skip invalid or uncommitted modification queries
+      }
+
+      matches.visit(entry, i, [&](const irs::doc_id_t doc_id) {
+        // if the indexed doc_id was insert()ed after the request for modification
+        // or the indexed doc_id was already masked then it should be skipped
+        if (modification.generation < min_modification_generation
+            || !docs_mask.insert(doc_id)) {
+          return; // the current modification query does not match any records
+        }
+
+        assert(meta.live_docs_count);
+        --meta.live_docs_count; // decrement count of live docs
+        modification.seen = true;
+        modified = true;
+      });
     }
   }
 
@@ -176,42 +367,23 @@ bool add_document_mask_modified_records(
     return false; // nothing new to flush
   }
 
-  auto reader = readers.emplace(ctx.segment_.meta);
-
-  if (!reader) {
-    throw irs::index_error(irs::string_utils::to_string(
-      "while adding document mask modified records to flush_segment_context of segment '%s', error: failed to open segment",
-      ctx.segment_.meta.name.c_str()
-    ));
-  }
+  const modification_matches matches({ modifications }, readers, ctx.segment_.meta);
 
   assert(irs::doc_limits::valid(ctx.doc_id_begin_));
   assert(ctx.doc_id_begin_ <= ctx.doc_id_end_);
   assert(ctx.doc_id_end_ <= ctx.update_contexts_.size() + irs::doc_limits::min());
   bool modified = false;
 
-  for (auto& modification : modifications) {
+  for (size_t i = 0, size = modifications.size(); i < size; ++i) {
+    auto& modification = modifications[i];
+
     if (!modification.filter) {
       continue; // skip invalid or uncommitted modification queries
     }
 
-    auto prepared = modification.filter->prepare(reader);
-
-    if (!prepared) {
-      continue; // skip invalid prepared filters
-    }
-
-    auto itr = prepared->execute(reader);
-
-    if (!itr) {
-      continue; // skip invalid iterators
-    }
-
-    while (itr->next()) {
-      const auto doc_id = itr->value();
-
+    matches.visit(0, i, [&](const irs::doc_id_t doc_id) {
       if (doc_id < ctx.doc_id_begin_ || doc_id >= ctx.doc_id_end_) {
-        continue; // doc_id is not part of the current flush_context
+        return; // doc_id is not part of the current flush_context
       }
 
       auto& doc_ctx = ctx.update_contexts_[doc_id - irs::doc_limits::min()]; // valid because of asserts above
@@ -219,8 +391,8 @@ bool add_document_mask_modified_records(
       // if the indexed doc_id was insert()ed after the request for modification
       // or the indexed doc_id was already masked then it should be skipped
       if (modification.generation < doc_ctx.generation
-          || !ctx.docs_mask_.insert(doc_id).second) {
-        continue; // the current modification query does not match any records
+          || !ctx.docs_mask_.insert(doc_id)) {
+        return; // the current modification query does not match any records
       }
 
       // if an update modification and update-value record whose query was not
@@ -229,14 +401,14 @@ bool add_document_mask_modified_records(
       if (modification.update
           && doc_ctx.update_id != NON_UPDATE_RECORD
           && !ctx.modification_contexts_[doc_ctx.update_id].seen) {
-        continue; // the current modification matched a replacement document which in turn did not match any records
+        return; // the current modification matched a replacement document which in turn did not match any records
       }
 
       assert(ctx.segment_.meta.live_docs_count);
       --ctx.segment_.meta.live_docs_count; // decrement count of live docs
       modification.seen = true;
       modified = true;
-    }
+    });
   }
 
   return modified;
@@ -266,7 +438,7 @@ bool add_document_mask_unused_updates(flush_segment_context& ctx) {
 
     // if it's an update record placeholder who's query already match some record
     if (ctx.modification_contexts_[doc_ctx.update_id].seen
-        || !ctx.docs_mask_.insert(doc_id).second) {
+        || !ctx.docs_mask_.insert(doc_id)) {
       continue; // the current placeholder record is in-use and valid
     }
 
@@ -540,17 +712,25 @@ segment_reader readers_cache::emplace(const segment_meta& meta) {
 
   segment_reader cached_reader;
 
-  // FIXME consider moving open/reopen out of the scope of the lock
-  auto lock = make_lock_guard(lock_);
-  auto& reader = cache_[meta];
+  // segments are opened/reopened out of the scope of the lock,
+  // so that readers of different segments are opened concurrently
+  {
+    auto lock = make_lock_guard(lock_);
+    const auto it = cache_.find(meta);
 
-  cached_reader = std::move(reader); // clear existing reader
+    if (it != cache_.end()) {
+      cached_reader = std::move(it->second); // clear existing reader
+    }
+  }
 
-  // update cache, in case of failure reader stays empty
-  reader = cached_reader
+  auto reader = cached_reader
     ? cached_reader.reopen(meta)
     : segment_reader::open(dir_, meta);
 
+  // update cache, in case of failure reader stays empty
+  auto lock = make_lock_guard(lock_);
+  cache_[meta] = reader;
+
   return reader;
 }
 
@@ -848,7 +1028,7 @@ index_writer::flush_context_ptr index_writer::documents_context::update_segment(
     );
 
     try {
-      segment.flush();
+      segment.flush(writer_.flush_pool_);
     } catch (...) {
       IR_FRMT_ERROR(
         "while flushing segment '%s', error: failed to flush segment",
@@ -1037,11 +1217,12 @@ index_writer::segment_context::segment_context(
     directory& dir,
     segment_meta_generator_t&& meta_generator,
     const column_info_provider_t& column_info,
-    const comparer* comparator)
+    const comparer* comparator,
+    IOAdvice write_advice)
   : active_count_(0),
     buffered_docs_(0),
     dirty_(false),
-    dir_(dir),
+    dir_(dir, false, write_advice),
     meta_generator_(std::move(meta_generator)),
     uncomitted_doc_id_begin_(doc_limits::min()),
     uncomitted_generation_offset_(0),
@@ -1050,7 +1231,7 @@ index_writer::segment_context::segment_context(
   assert(meta_generator_);
 }
 
-uint64_t index_writer::segment_context::flush() {
+uint64_t index_writer::segment_context::flush(async_utils::thread_pool* pool) {
   // prevent concurrent flush related modifications
   auto lock = make_lock_guard(flush_mutex_);
 
@@ -1077,7 +1258,7 @@ uint64_t index_writer::segment_context::flush() {
 
   // flush segment_writer
   try {
-    writer_->flush(segment);
+    writer_->flush(segment, pool);
   } catch (...) {
     // failed to flush segment
     flushed_.pop_back();
@@ -1095,8 +1276,9 @@ index_writer::segment_context::ptr index_writer::segment_context::make(
     directory& dir,
     segment_meta_generator_t&& meta_generator,
     const column_info_provider_t& column_info,
-    const comparer* comparator) {
-  return memory::make_shared<segment_context>(dir, std::move(meta_generator), column_info, comparator);
+    const comparer* comparator,
+    IOAdvice write_advice) {
+  return memory::make_shared<segment_context>(dir, std::move(meta_generator), column_info, comparator, write_advice);
 }
 
 segment_writer::update_context index_writer::segment_context::make_update_context() {
@@ -1212,11 +1394,17 @@ index_writer::index_writer(
     const comparer* comparator,
     const column_info_provider_t& column_info,
     const payload_provider_t& meta_payload_provider,
+    IOAdvice segment_write_advice,
+    async_utils::thread_pool* merge_pool,
+    async_utils::thread_pool* flush_pool,
     index_meta&& meta,
     committed_state_t&& committed_state)
   : column_info_(column_info),
     meta_payload_provider_(meta_payload_provider),
     comparator_(comparator),
+    segment_write_advice_(segment_write_advice),
+    merge_pool_(merge_pool),
+    flush_pool_(flush_pool),
     cached_readers_(dir),
     codec_(codec),
     committed_state_(std::move(committed_state)),
@@ -1373,6 +1561,9 @@ index_writer::ptr index_writer::make(
     opts.comparator,
     opts.column_info ? opts.column_info : DEFAULT_COLUMN_INFO,
     opts.meta_payload_provider,
+    opts.segment_write_advice,
+    opts.merge_pool,
+    opts.flush_pool,
     std::move(meta),
     std::move(comitted_state)
   );
@@ -1520,8 +1711,8 @@ index_writer::consolidation_result index_writer::consolidate(
   consolidation_segment.meta.version = 0; // reset version for new segment
   consolidation_segment.meta.name = file_name(meta_.increment()); // increment active meta, not fn arg
 
-  ref_tracking_directory dir(dir_); // track references for new segment
-  merge_writer merger(dir, column_info_, comparator_);
+  ref_tracking_directory dir(dir_, false, segment_write_advice_); // track references for new segment
+  merge_writer merger(dir, column_info_, comparator_, merge_pool_);
   merger.reserve(result.size);
 
   // add consolidated segments to the merge_writer
@@ -1764,13 +1955,13 @@ bool index_writer::import(
     codec = codec_;
   }
 
-  ref_tracking_directory dir(dir_); // track references
+  ref_tracking_directory dir(dir_, false, segment_write_advice_); // track references
 
   index_meta::index_segment_t segment;
   segment.meta.name = file_name(meta_.increment());
   segment.meta.codec = codec;
 
-  merge_writer merger(dir, column_info_, comparator_);
+  merge_writer merger(dir, column_info_, comparator_, merge_pool_);
   merger.reserve(reader.size());
 
   for (auto& segment : reader) {
@@ -1896,7 +2087,7 @@ index_writer::active_segment_context index_writer::get_segment_context(
   };
   auto segment_ctx = segment_writer_pool_.emplace(
     dir_, std::move(meta_generator),
-    column_info_, comparator_
+    column_info_, comparator_, segment_write_advice_
   ).release();
   auto segment_memory_max = segment_limits_.segment_memory_max.load();
 
@@ -1969,7 +2160,7 @@ index_writer::pending_context_t index_writer::flush_all() {
     segment_flush_locks.emplace_back(entry.segment_->flush_mutex_); // prevent concurrent modification of segment_context properties during flush_context::emplace(...)
 
     // force a flush of the underlying segment_writer
-    max_tick = std::max(entry.segment_->flush(), max_tick);
+    max_tick = std::max(entry.segment_->flush(flush_pool_), max_tick);
 
     entry.doc_id_end_ = // may be integer_traits<size_t>::const_max if segment_meta only in this flush_context
       std::min(entry.segment_->uncomitted_doc_id_begin_, entry.doc_id_end_); // update so that can use valid value below
@@ -1986,40 +2177,71 @@ index_writer::pending_context_t index_writer::flush_all() {
 
   auto& segment_mask = ctx->segment_mask_;
 
+  // modification_queries_ range [flush_segment_context::modification_offset_begin_, segment_context::uncomitted_modification_queries_)
+  std::vector<modification_contexts_ref> modification_queries;
+  bool has_modifications = false;
+
+  modification_queries.reserve(ctx->pending_segment_contexts_.size());
+
+  for (auto& modifications : ctx->pending_segment_contexts_) {
+    auto modifications_begin = modifications.modification_offset_begin_;
+    auto modifications_end = modifications.modification_offset_end_;
+
+    assert(modifications_begin <= modifications_end);
+    assert(modifications_end <= modifications.segment_->modification_queries_.size());
+    modification_queries.emplace_back(
+      modifications.segment_->modification_queries_.data() + modifications_begin,
+      modifications_end - modifications_begin
+    );
+    has_modifications |= modifications_begin != modifications_end;
+  }
+
+  // existing segments documents of which may be masked
+  std::vector<const index_meta::index_segment_t*> existing_segments;
+
   for (auto& existing_segment : meta_) {
     // skip already masked segments
-    if (segment_mask.end() != segment_mask.find(existing_segment.meta)) {
-      continue;
+    if (segment_mask.end() == segment_mask.find(existing_segment.meta)) {
+      existing_segments.emplace_back(&existing_segment);
     }
+  }
+
+  // resolve documents matched by modifications in every existing segment
+  // concurrently, the matches are applied in segment and modification order
+  // below since modifications may match the same documents
+  std::vector<std::unique_ptr<modification_matches>> existing_matches(
+    has_modifications ? existing_segments.size() : 0
+  );
+
+  async_utils::for_each_concurrently(
+    flush_pool_, existing_matches.size(), [&](size_t i) {
+      existing_matches[i] = memory::make_unique<modification_matches>(
+        modification_queries,
+        cached_readers_, // reader cache for segments
+        existing_segments[i]->meta
+      );
+  });
 
+  for (size_t i = 0, size = existing_segments.size(); i < size; ++i) {
+    auto& existing_segment = *existing_segments[i];
     const auto segment_id = segments.size();
     segments.emplace_back(existing_segment);
 
     auto mask_modified = false;
     auto& segment = segments.back();
 
-    docs_mask.clear();
-    index_utils::read_document_mask(docs_mask, dir, segment.meta);
-
     // mask documents matching filters from segment_contexts (i.e. from new operations)
-    for (auto& modifications : ctx->pending_segment_contexts_) {
-      // modification_queries_ range [flush_segment_context::modification_offset_begin_, segment_context::uncomitted_modification_queries_)
-      auto modifications_begin = modifications.modification_offset_begin_;
-      auto modifications_end = modifications.modification_offset_end_;
-
-      assert(modifications_begin <= modifications_end);
-      assert(modifications_end <= modifications.segment_->modification_queries_.size());
-      modification_contexts_ref modification_queries(
-        modifications.segment_->modification_queries_.data() + modifications_begin,
-        modifications_end - modifications_begin
-      );
+    if (i < existing_matches.size()) {
+      docs_mask.clear();
+      index_utils::read_document_mask(docs_mask, dir, segment.meta);
 
-      mask_modified |= add_document_mask_modified_records(
+      mask_modified = add_document_mask_modified_records(
         modification_queries,
+        *existing_matches[i],
         docs_mask,
-        cached_readers_, // reader cache for segments
         segment.meta
       );
+      existing_matches[i].reset(); // release matched documents
     }
 
     // write docs_mask if masks added, if all docs are masked then mask segment
@@ -2116,29 +2338,15 @@ index_writer::pending_context_t index_writer::flush_all() {
       if (pending_segment.segment.meta.docs_count != pending_segment.segment.meta.live_docs_count) {
         index_utils::read_document_mask(docs_mask, dir, pending_segment.segment.meta);
       }
-      bool docs_mask_modified = false;
       // pending already imported/consolidated segment, apply deletes
       // mask documents matching filters from segment_contexts (i.e. from new operations)
-      for (auto& modifications: ctx->pending_segment_contexts_) {
-        // modification_queries_ range [flush_segment_context::modification_offset_begin_, segment_context::uncomitted_modification_queries_)
-        auto modifications_begin = modifications.modification_offset_begin_;
-        auto modifications_end = modifications.modification_offset_end_;
-
-        assert(modifications_begin <= modifications_end);
-        assert(modifications_end <= modifications.segment_->modification_queries_.size());
-        modification_contexts_ref modification_queries(
-          modifications.segment_->modification_queries_.data() + modifications_begin,
-          modifications_end - modifications_begin
-        );
-
-        docs_mask_modified |= add_document_mask_modified_records(
-          modification_queries,
-          docs_mask,
-          cached_readers_, // reader cache for segments
-          pending_segment.segment.meta,
-          pending_segment.generation
-        );
-      }
+      bool docs_mask_modified = has_modifications && add_document_mask_modified_records(
+        modification_queries,
+        modification_matches(modification_queries, cached_readers_, pending_segment.segment.meta),
+        docs_mask,
+        pending_segment.segment.meta,
+        pending_segment.generation
+      );
 
       // if mask left untouched, reset it, to prevent unnecessary writes
       if (!docs_mask_modified) {
@@ -2294,7 +2502,7 @@ index_writer::pending_context_t index_writer::flush_all() {
              doc_id < valid_doc_id_begin;
              ++doc_id) {
           assert(integer_traits<doc_id_t>::const_max >= doc_id);
-          if (flush_segment_ctx.docs_mask_.emplace(doc_id_t(doc_id)).second) {
+          if (flush_segment_ctx.docs_mask_.insert(doc_id_t(doc_id))) {
             assert(flush_segment_ctx.segment_.meta.live_docs_count);
             --flush_segment_ctx.segment_.meta.live_docs_count; // decrement count of live docs
           }
@@ -2306,7 +2514,7 @@ index_writer::pending_context_t index_writer::flush_all() {
              doc_id < doc_id_end;
              ++doc_id) {
           assert(integer_traits<doc_id_t>::const_max >= doc_id);
-          if (flush_segment_ctx.docs_mask_.emplace(doc_id_t(doc_id)).second) {
+          if (flush_segment_ctx.docs_mask_.insert(doc_id_t(doc_id))) {
             assert(flush_segment_ctx.segment_.meta.live_docs_count);
             --flush_segment_ctx.segment_.meta.live_docs_count; // decrement count of live docs
           }
@@ -471,6 +471,28 @@ class IRESEARCH_API index_writer
     ////////////////////////////////////////////////////////////////////////////
     size_t segment_pool_size{128}; // arbitrary size
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief access pattern advice for files of the segments created by
+    ///        flush and consolidation, e.g. IOAdvice::READONCE makes
+    ///        fs_directory write them bypassing the system caches so that
+    ///        background indexing doesn't evict data used by the readers
+    ////////////////////////////////////////////////////////////////////////////
+    IOAdvice segment_write_advice{IOAdvice::NORMAL};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief if specified, consolidation merges stored columns on the pool
+    ///        concurrently with the term dictionary and postings,
+    ///        the pool must outlive the index_writer
+    ////////////////////////////////////////////////////////////////////////////
+    async_utils::thread_pool* merge_pool{nullptr};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief if specified, segment flush writes stored columns on the pool
+    ///        concurrently with the term dictionary and postings,
+    ///        the pool must outlive the index_writer
+    ////////////////////////////////////////////////////////////////////////////
+    async_utils::thread_pool* flush_pool{nullptr};
+
     ////////////////////////////////////////////////////////////////////////////
     /// @brief aquire an exclusive lock on the repository to guard against index
     ///        corruption from multiple index_writers
@@ -857,14 +879,15 @@ class IRESEARCH_API index_writer
     segment_writer::ptr writer_;
     index_meta::index_segment_t writer_meta_; // the segment_meta this writer was initialized with
 
-    DECLARE_FACTORY(directory& dir, segment_meta_generator_t&& meta_generator, const column_info_provider_t& column_info, const comparer* comparator);
-    segment_context(directory& dir, segment_meta_generator_t&& meta_generator, const column_info_provider_t& column_info, const comparer* comparator);
+    DECLARE_FACTORY(directory& dir, segment_meta_generator_t&& meta_generator, const column_info_provider_t& column_info, const comparer* comparator, IOAdvice write_advice);
+    segment_context(directory& dir, segment_meta_generator_t&& meta_generator, const column_info_provider_t& column_info, const comparer* comparator, IOAdvice write_advice);
 
     ////////////////////////////////////////////////////////////////////////////
     /// @brief flush current writer state into a materialized segment
+    /// @param pool optional pool for concurrent flush stages
     /// @return tick of last committed transaction
     ////////////////////////////////////////////////////////////////////////////
-    uint64_t flush();
+    uint64_t flush(async_utils::thread_pool* pool);
 
     // returns context for "insert" operation
     segment_writer::update_context make_update_context();
@@ -1073,6 +1096,9 @@ class IRESEARCH_API index_writer
     const comparer* comparator,
     const column_info_provider_t& column_info,
     const payload_provider_t& meta_payload_provider,
+    IOAdvice segment_write_advice,
+    async_utils::thread_pool* merge_pool,
+    async_utils::thread_pool* flush_pool,
     index_meta&& meta,
     committed_state_t&& committed_state
   );
@@ -1090,6 +1116,9 @@ class IRESEARCH_API index_writer
   column_info_provider_t column_info_;
   payload_provider_t meta_payload_provider_; // provides payload for new segments
   const comparer* comparator_;
+  IOAdvice segment_write_advice_; // advice for files of new segments
+  async_utils::thread_pool* merge_pool_; // pool for concurrent merge stages
+  async_utils::thread_pool* flush_pool_; // pool for concurrent flush stages
   readers_cache cached_readers_; // readers by segment name
   format::ptr codec_;
   std::mutex commit_lock_; // guard for cached_segment_readers_, commit_pool_, meta_ (modification during commit()/defragment()), paylaod_buf_
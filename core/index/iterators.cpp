@@ -224,6 +224,22 @@ doc_iterator::ptr doc_iterator::empty() {
   return memory::to_managed<doc_iterator, false>(&EMPTY_DOC_ITERATOR);
 }
 
+doc_block doc_iterator::next_block() {
+  if (!next()) {
+    return {};
+  }
+
+  const auto* doc = irs::get<document>(*this);
+  assert(doc && doc->value == value());
+  const auto* freq = irs::get<frequency>(*this);
+
+  return { &doc->value, freq ? &freq->value : nullptr, 1 };
+}
+
+bool doc_iterator::exclude(const document_mask& /*mask*/) {
+  return false;
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                   field_iterator 
 // ----------------------------------------------------------------------------
@@ -32,10 +32,24 @@
 
 namespace iresearch {
 
+class document_mask;
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                    doc iterators 
 // ----------------------------------------------------------------------------
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class doc_block
+/// @brief a block of documents returned by 'doc_iterator::next_block()'
+//////////////////////////////////////////////////////////////////////////////
+struct doc_block {
+  const doc_id_t* docs{}; // document ids in ascending order
+  const uint32_t* freqs{}; // frequencies of 'docs', nullptr if not available
+  size_t size{};
+
+  bool empty() const noexcept { return 0 == size; }
+}; // doc_block
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class doc_iterator 
 /// @brief base iterator for document collections.
@@ -66,6 +80,29 @@ struct IRESEARCH_API doc_iterator
   /// (for more information see class description)
   //////////////////////////////////////////////////////////////////////////////
   virtual doc_id_t seek(doc_id_t target) = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief moves iterator over the documents following the current one up to
+  ///        the end of an internal block and returns them at once, iterator
+  ///        is positioned at the last returned document afterwards
+  /// @note frequencies are returned only if iterator exposes 'frequency'
+  /// @note returned block is valid until the subsequent call to 'next()',
+  ///       'seek(...)' or 'next_block()', empty block means that iterator
+  ///       is exhausted
+  /// @note default implementation returns blocks of a single document
+  //////////////////////////////////////////////////////////////////////////////
+  virtual doc_block next_block();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief makes iterator skip documents contained in the specified mask,
+  ///        must be called before the iterator is positioned for the first
+  ///        time, 'mask' must outlive the iterator
+  /// @return iterator filters masked documents itself, otherwise the caller
+  ///         is responsible for filtering
+  /// @note default implementation doesn't support masking, compound
+  ///       iterators forward the mask to their sub-iterators
+  //////////////////////////////////////////////////////////////////////////////
+  virtual bool exclude(const document_mask& mask);
 }; // doc_iterator
 
 // ----------------------------------------------------------------------------
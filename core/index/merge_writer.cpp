@@ -21,7 +21,9 @@
 /// @author Vasiliy Nabatchikov
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <deque>
+#include <mutex>
 #include <unordered_map>
 
 #include "merge_writer.hpp"
@@ -31,6 +33,7 @@
 #include "index/segment_reader.hpp"
 #include "index/heap_iterator.hpp"
 #include "index/comparer.hpp"
+#include "utils/async_utils.hpp"
 #include "utils/directory_utils.hpp"
 #include "utils/log.hpp"
 #include "utils/lz4compression.hpp"
@@ -1066,9 +1069,8 @@ template<typename CompoundIterator>
 bool write_columns(
     columnstore& cs,
     CompoundIterator& columns,
-    irs::directory& dir,
+    irs::column_meta_writer& column_meta_writer,
     const irs::column_info_provider_t& column_info,
-    const irs::segment_meta& meta,
     compound_column_meta_iterator_t& column_meta_itr,
     const irs::merge_writer::flush_progress_t& progress) {
   REGISTER_TIMER_DETAILED();
@@ -1094,9 +1096,6 @@ bool write_columns(
     return column_meta_itr.visit(add_iterators);
   };
 
-  auto column_meta_writer = meta.codec->get_column_meta_writer();
-  column_meta_writer->prepare(dir, meta);
-
   while (column_meta_itr.next()) {
     const auto& column_name = (*column_meta_itr).name;
     cs.reset(column_info(column_name));
@@ -1112,11 +1111,11 @@ bool write_columns(
     }
 
     if (!cs.empty()) {
-      column_meta_writer->write(column_name, cs.id());
+      column_meta_writer.write(column_name, cs.id());
     }
   }
 
-  column_meta_writer->flush();
+  column_meta_writer.flush();
 
   return true;
 }
@@ -1126,9 +1125,8 @@ bool write_columns(
 //////////////////////////////////////////////////////////////////////////////
 bool write_columns(
     columnstore& cs,
-    irs::directory& dir,
+    irs::column_meta_writer& cmw,
     const irs::column_info_provider_t& column_info,
-    const irs::segment_meta& meta,
     compound_column_meta_iterator_t& column_itr,
     const irs::merge_writer::flush_progress_t& progress) {
   REGISTER_TIMER_DETAILED();
@@ -1142,10 +1140,6 @@ bool write_columns(
     return cs.insert(segment, column.id, doc_map);
   };
 
-  auto cmw = meta.codec->get_column_meta_writer();
-
-  cmw->prepare(dir, meta);
-
   while (column_itr.next()) {
     const auto& column_name = (*column_itr).name;
     cs.reset(column_info(column_name));
@@ -1157,38 +1151,27 @@ bool write_columns(
     }
 
     if (!cs.empty()) {
-      cmw->write(column_name, cs.id());
+      cmw.write(column_name, cs.id());
     } 
   }
 
-  cmw->flush();
+  cmw.flush();
 
   return true;
 }
 
 //////////////////////////////////////////////////////////////////////////////
-/// @brief write field term data
+/// @brief write field norms
+/// @param norms [out] norm column identifier of each field
 //////////////////////////////////////////////////////////////////////////////
-bool write_fields(
+bool write_norms(
     columnstore& cs,
-    irs::directory& dir,
-    const irs::segment_meta& meta,
     compound_field_iterator& field_itr,
-    const irs::flags& fields_features,
-    const irs::merge_writer::flush_progress_t& progress
-) {
+    std::vector<irs::field_id>& norms,
+    const irs::merge_writer::flush_progress_t& progress) {
   REGISTER_TIMER_DETAILED();
   assert(cs);
 
-  irs::flush_state flush_state;
-  flush_state.dir = &dir;
-  flush_state.doc_count = meta.docs_count;
-  flush_state.features = &fields_features;
-  flush_state.name = meta.name;
-
-  auto field_writer = meta.codec->get_field_writer(true);
-  field_writer->prepare(flush_state);
-
   auto merge_norms = [&cs] (
       const irs::sub_reader& segment,
       const doc_map_f& doc_map,
@@ -1205,56 +1188,31 @@ bool write_fields(
   while (field_itr.next()) {
     cs.reset(NORM_COLUMN); // FIXME encoder for norms???
 
-    auto& field_meta = field_itr.meta();
-    auto& field_features = field_meta.features;
-
     // remap merge norms
     if (!progress() || !field_itr.visit(merge_norms)) {
       return false;
     }
 
-    // write field terms
-    auto terms = field_itr.iterator();
-
-    field_writer->write(
-      field_meta.name,
-      cs.empty() ? irs::field_limits::invalid() : cs.id(),
-      field_features,
-      *terms
-    );
+    norms.emplace_back(cs.empty() ? irs::field_limits::invalid() : cs.id());
   }
 
-  field_writer->end();
-  field_writer.reset();
-
   return !field_itr.aborted();
 }
 
 //////////////////////////////////////////////////////////////////////////////
-/// @brief write field term data
+/// @brief write field norms
+/// @param norms [out] norm column identifier of each field
 //////////////////////////////////////////////////////////////////////////////
 template<typename CompoundIterator>
-bool write_fields(
+bool write_norms(
     columnstore& cs,
-    CompoundIterator& norms,
-    irs::directory& dir,
-    const irs::segment_meta& meta,
+    CompoundIterator& norms_itr,
     compound_field_iterator& field_itr,
-    const irs::flags& fields_features,
-    const irs::merge_writer::flush_progress_t& progress
-) {
+    std::vector<irs::field_id>& norms,
+    const irs::merge_writer::flush_progress_t& progress) {
   REGISTER_TIMER_DETAILED();
   assert(cs);
 
-  irs::flush_state flush_state;
-  flush_state.dir = &dir;
-  flush_state.doc_count = meta.docs_count;
-  flush_state.features = &fields_features;
-  flush_state.name = meta.name;
-
-  auto field_writer = meta.codec->get_field_writer(true);
-  field_writer->prepare(flush_state);
-
   auto add_iterators = [&field_itr](compound_doc_iterator::iterators_t& itrs) {
     auto add_iterators = [&itrs](
         const irs::sub_reader& segment,
@@ -1282,25 +1240,69 @@ bool write_fields(
   while (field_itr.next()) {
     cs.reset(NORM_COLUMN); // FIXME encoder for norms???
 
-    auto& field_meta = field_itr.meta();
-    auto& field_features = field_meta.features;
-
     // remap merge norms
-    if (!progress() || !norms.reset(add_iterators)) {
+    if (!progress() || !norms_itr.reset(add_iterators)) {
       return false;
     }
 
-    if (!cs.insert(norms)) {
+    if (!cs.insert(norms_itr)) {
       return false; // failed to insert all values
     }
 
+    norms.emplace_back(cs.empty() ? irs::field_limits::invalid() : cs.id());
+  }
+
+  return !field_itr.aborted();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief create field writer for the specified segment
+//////////////////////////////////////////////////////////////////////////////
+irs::field_writer::ptr prepare_field_writer(
+    irs::directory& dir,
+    const irs::segment_meta& meta,
+    const irs::flags& fields_features) {
+  irs::flush_state flush_state;
+  flush_state.dir = &dir;
+  flush_state.doc_count = meta.docs_count;
+  flush_state.features = &fields_features;
+  flush_state.name = meta.name;
+
+  auto field_writer = meta.codec->get_field_writer(true);
+  field_writer->prepare(flush_state);
+
+  return field_writer;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief write field term data
+/// @param norms norm column identifier of each field, see 'write_norms'
+//////////////////////////////////////////////////////////////////////////////
+bool write_fields(
+    irs::field_writer::ptr&& field_writer,
+    compound_field_iterator& field_itr,
+    const std::vector<irs::field_id>& norms,
+    const irs::merge_writer::flush_progress_t& progress) {
+  REGISTER_TIMER_DETAILED();
+  assert(field_writer);
+
+  for (auto norm = norms.begin(); field_itr.next(); ++norm) {
+    if (!progress()) {
+      return false;
+    }
+
+    // both iterators traverse the same fields
+    assert(norm != norms.end());
+
+    auto& field_meta = field_itr.meta();
+
     // write field terms
     auto terms = field_itr.iterator();
 
     field_writer->write(
       field_meta.name,
-      cs.empty() ? irs::field_limits::invalid() : cs.id(),
-      field_features,
+      *norm,
+      field_meta.features,
       *terms
     );
   }
@@ -1311,6 +1313,83 @@ bool write_fields(
   return !field_itr.aborted();
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief thread-safe progress callback shared by the concurrent merge stages
+//////////////////////////////////////////////////////////////////////////////
+class shared_progress : irs::util::noncopyable {
+ public:
+  explicit shared_progress(
+      const irs::merge_writer::flush_progress_t& progress) noexcept
+    : progress_(&progress) {
+  }
+
+  bool operator()() {
+    if (aborted_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!(*progress_)()) {
+      abort();
+      return false;
+    }
+
+    return true;
+  }
+
+  // stops other stages as soon as they check progress
+  void abort() noexcept {
+    aborted_.store(true, std::memory_order_relaxed);
+  }
+
+ private:
+  const irs::merge_writer::flush_progress_t* progress_;
+  std::mutex mutex_;
+  std::atomic<bool> aborted_{ false };
+}; // shared_progress
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief runs 'background' on the 'pool' concurrently with 'foreground'
+///        on the current thread, runs both on the current thread if there
+///        is no pool or the pool rejects the task
+/// @return both stages succeeded
+//////////////////////////////////////////////////////////////////////////////
+template<typename Background, typename Foreground>
+bool run_stages(
+    irs::async_utils::thread_pool* pool,
+    shared_progress& progress,
+    Background&& background,
+    Foreground&& foreground) {
+  bool background_result = false;
+  bool foreground_result = false;
+
+  irs::async_utils::run_concurrently(
+    pool,
+    [&progress, &background, &background_result]() {
+      // stop the other stage on failure
+      auto abort = irs::make_finally([&progress, &background_result]() noexcept {
+        if (!background_result) {
+          progress.abort();
+        }
+      });
+
+      background_result = background();
+    },
+    [&progress, &foreground, &foreground_result]() {
+      // stop the other stage on failure
+      auto abort = irs::make_finally([&progress, &foreground_result]() noexcept {
+        if (!foreground_result) {
+          progress.abort();
+        }
+      });
+
+      foreground_result = foreground();
+    });
+
+  return background_result && foreground_result;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief computes doc_id_map and docs_count
 //////////////////////////////////////////////////////////////////////////////
@@ -1362,7 +1441,8 @@ merge_writer::reader_ctx::reader_ctx(irs::sub_reader::ptr reader) noexcept
 merge_writer::merge_writer() noexcept
   : dir_(noop_directory::instance()),
     column_info_(nullptr),
-    comparator_(nullptr) {
+    comparator_(nullptr),
+    pool_(nullptr) {
 }
 
 merge_writer::operator bool() const noexcept {
@@ -1372,13 +1452,18 @@ merge_writer::operator bool() const noexcept {
 bool merge_writer::flush(
     tracking_directory& dir,
     index_meta::index_segment_t& segment,
-    const flush_progress_t& progress) {
+    const flush_progress_t& flush_progress) {
   REGISTER_TIMER_DETAILED();
-  assert(progress);
+  assert(flush_progress);
   assert(!comparator_);
 
+  // merge stages may report progress concurrently
+  shared_progress safe_progress(flush_progress);
+  const flush_progress_t progress = std::ref(safe_progress);
+
   field_meta_map_t field_meta_map;
   compound_field_iterator fields_itr(progress);
+  compound_field_iterator norms_itr(progress);
   compound_column_meta_iterator_t columns_meta_itr;
   irs::flags fields_features;
 
@@ -1417,6 +1502,7 @@ bool merge_writer::flush(
     }
 
     fields_itr.add(reader, reader_ctx.doc_map);
+    norms_itr.add(reader, reader_ctx.doc_map);
     columns_meta_itr.add(reader, reader_ctx.doc_map);
   }
 
@@ -1441,8 +1527,10 @@ bool merge_writer::flush(
     return false; // progress callback requested termination
   }
 
-  // write columns
-  if (!write_columns(cs, dir, *column_info_, segment.meta, columns_meta_itr, progress)) {
+  // write norms first, field term data refers to their identifiers
+  std::vector<field_id> norms;
+
+  if (!write_norms(cs, norms_itr, norms, progress)) {
     return false; // flush failure
   }
 
@@ -1450,8 +1538,23 @@ bool merge_writer::flush(
     return false; // progress callback requested termination
   }
 
-  // write field meta and field term data
-  if (!write_fields(cs, dir, segment.meta, fields_itr, fields_features, progress)) {
+  // both writers create their files via the non thread-safe 'dir'
+  auto column_meta_writer = segment.meta.codec->get_column_meta_writer();
+  column_meta_writer->prepare(dir, segment.meta);
+  auto field_writer = prepare_field_writer(dir, segment.meta, fields_features);
+
+  // write columns and field term data concurrently, stages share no files
+  const bool written = run_stages(
+    pool_, safe_progress,
+    [&]() {
+      return write_columns(cs, *column_meta_writer, *column_info_,
+                           columns_meta_itr, progress);
+    },
+    [&]() {
+      return write_fields(std::move(field_writer), fields_itr, norms, progress);
+    });
+
+  if (!written) {
     return false; // flush failure
   }
 
@@ -1467,15 +1570,20 @@ bool merge_writer::flush(
 bool merge_writer::flush_sorted(
     tracking_directory& dir,
     index_meta::index_segment_t& segment,
-    const flush_progress_t& progress) {
+    const flush_progress_t& flush_progress) {
   REGISTER_TIMER_DETAILED();
-  assert(progress);
+  assert(flush_progress);
   assert(comparator_);
   assert(column_info_ && *column_info_);
 
+  // merge stages may report progress concurrently
+  shared_progress safe_progress(flush_progress);
+  const flush_progress_t progress = std::ref(safe_progress);
+
   field_meta_map_t field_meta_map;
   compound_column_meta_iterator_t columns_meta_itr;
   compound_field_iterator fields_itr(progress, comparator_);
+  compound_field_iterator norms_itr(progress, comparator_);
   irs::flags fields_features;
 
   sorting_compound_column_iterator::iterators_t itrs;
@@ -1506,6 +1614,7 @@ bool merge_writer::flush_sorted(
     }
 
     fields_itr.add(reader, reader_ctx.doc_map);
+    norms_itr.add(reader, reader_ctx.doc_map);
     columns_meta_itr.add(reader, reader_ctx.doc_map);
 
     // count total number of documents in consolidated segment
@@ -1617,8 +1726,10 @@ bool merge_writer::flush_sorted(
     return false; // progress callback requested termination
   }
 
-  // write columns
-  if (!write_columns(cs, sorting_doc_it, dir, *column_info_, segment.meta, columns_meta_itr, progress)) {
+  // write norms first, field term data refers to their identifiers
+  std::vector<field_id> norms;
+
+  if (!write_norms(cs, sorting_doc_it, norms_itr, norms, progress)) {
     return false; // flush failure
   }
 
@@ -1626,8 +1737,23 @@ bool merge_writer::flush_sorted(
     return false; // progress callback requested termination
   }
 
-  // write field meta and field term data
-  if (!write_fields(cs, sorting_doc_it, dir, segment.meta, fields_itr, fields_features, progress)) {
+  // both writers create their files via the non thread-safe 'dir'
+  auto column_meta_writer = segment.meta.codec->get_column_meta_writer();
+  column_meta_writer->prepare(dir, segment.meta);
+  auto field_writer = prepare_field_writer(dir, segment.meta, fields_features);
+
+  // write columns and field term data concurrently, stages share no files
+  const bool written = run_stages(
+    pool_, safe_progress,
+    [&]() {
+      return write_columns(cs, sorting_doc_it, *column_meta_writer,
+                           *column_info_, columns_meta_itr, progress);
+    },
+    [&]() {
+      return write_fields(std::move(field_writer), fields_itr, norms, progress);
+    });
+
+  if (!written) {
     return false; // flush failure
   }
 
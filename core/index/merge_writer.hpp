@@ -39,6 +39,10 @@ struct tracking_directory;
 struct sub_reader;
 class comparer;
 
+namespace async_utils {
+class thread_pool;
+}
+
 class IRESEARCH_API merge_writer: public util::noncopyable {
  public:
   typedef std::shared_ptr<const irs::sub_reader> sub_reader_ptr;
@@ -54,13 +58,20 @@ class IRESEARCH_API merge_writer: public util::noncopyable {
 
   merge_writer() noexcept;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param pool if specified, stored columns are merged on the 'pool'
+  ///        concurrently with the term dictionary and postings, the merged
+  ///        segment is the same regardless of the 'pool'
+  //////////////////////////////////////////////////////////////////////////////
   explicit merge_writer(
       directory& dir,
       const column_info_provider_t& column_info,
-      const comparer* comparator = nullptr) noexcept
+      const comparer* comparator = nullptr,
+      async_utils::thread_pool* pool = nullptr) noexcept
     : dir_(dir),
       column_info_(&column_info),
-      comparator_(comparator) {
+      comparator_(comparator),
+      pool_(pool) {
     assert(column_info);
   }
 
@@ -84,7 +95,8 @@ class IRESEARCH_API merge_writer: public util::noncopyable {
   //////////////////////////////////////////////////////////////////////////////
   /// @brief flush all of the added readers into a single segment
   /// @param segment the segment that was flushed
-  /// @param progress report flush progress (abort if 'progress' returns false)
+  /// @param progress report flush progress (abort if 'progress' returns false),
+  ///        calls are serialized even if the merge runs on a thread pool
   /// @return merge successful
   //////////////////////////////////////////////////////////////////////////////
   bool flush(
@@ -120,6 +132,7 @@ class IRESEARCH_API merge_writer: public util::noncopyable {
   std::vector<reader_ctx> readers_;
   const column_info_provider_t* column_info_;
   const comparer* comparator_;
+  async_utils::thread_pool* pool_;
   IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // merge_writer
 
@@ -21,11 +21,22 @@
 /// @author Vasiliy Nabatchikov
 ////////////////////////////////////////////////////////////////////////////////
 
-#include "utils/map_utils.hpp"
 #include "utils/timer_utils.hpp"
 #include "utils/type_limits.hpp"
 #include "postings.hpp"
 
+namespace {
+
+// number of slots the table starts with
+constexpr size_t MIN_SLOTS = 16;
+
+// folds a term hash into 32 bits, lower bits of the result address slots
+inline uint32_t mix(size_t hash) noexcept {
+  return uint32_t((uint64_t(hash) * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+}
+
+}
+
 namespace iresearch {
 
 // -----------------------------------------------------------------------------
@@ -36,6 +47,34 @@ postings::postings(writer_t& writer):
   writer_(writer) {
 }
 
+void postings::clear() noexcept {
+  postings_.clear();
+  std::fill(slots_.begin(), slots_.end(), EMPTY_SLOT);
+}
+
+void postings::rehash(size_t size) {
+  assert(0 == (size & (size - 1))); // power of 2
+  const size_t mask = size - 1;
+
+  std::vector<slot_t> slots(size, EMPTY_SLOT);
+
+  for (const auto slot : slots_) {
+    if (EMPTY_SLOT == slot) {
+      continue;
+    }
+
+    auto i = slot_hash(slot) & mask;
+
+    while (EMPTY_SLOT != slots[i]) {
+      i = (i + 1) & mask;
+    }
+
+    slots[i] = slot;
+  }
+
+  slots_ = std::move(slots);
+}
+
 postings::emplace_result postings::emplace(const bytes_ref& term) {
   REGISTER_TIMER_DETAILED();
   auto& parent = writer_.parent();
@@ -46,7 +85,27 @@ postings::emplace_result postings::emplace(const bytes_ref& term) {
   if (writer_t::container::block_type::SIZE < max_term_len) {
     // TODO: maybe move big terms it to a separate storage
     // reject terms that do not fit in a block
-    return std::make_pair(map_.end(), false);
+    return std::make_pair(nullptr, false);
+  }
+
+  if (2*(postings_.size() + 1) > slots_.size()) {
+    rehash(std::max(MIN_SLOTS, 2*slots_.size())); // keep load factor <= 0.5
+  }
+
+  const auto hash = mix(std::hash<bytes_ref>()(term));
+  const size_t mask = slots_.size() - 1;
+  auto i = hash & mask;
+
+  for (; EMPTY_SLOT != slots_[i]; i = (i + 1) & mask) {
+    const auto slot = slots_[i];
+
+    if (hash == slot_hash(slot)) {
+      auto& posting = postings_[slot_id(slot)];
+
+      if (posting.term == term) {
+        return std::make_pair(&posting, false);
+      }
+    }
   }
 
   const auto slice_end = writer_.pool_offset() + max_term_len;
@@ -61,24 +120,20 @@ postings::emplace_result postings::emplace(const bytes_ref& term) {
 
   assert(size() < doc_limits::eof()); // not larger then the static flag
 
-  auto generator = [&term, this](const hashed_bytes_ref& key, const posting&) {
-    // for new terms also write out their value
-    writer_.write(term.c_str(), term.size());
+  // for new terms also write out their value
+  writer_.write(term.c_str(), term.size());
 
-    // reuse hash but point ref at data in pool
-    return hashed_bytes_ref(
-      key.hash(),
-      (writer_.position() - term.size()).buffer(), term.size()
-    );
-  };
+  const auto id = uint32_t(postings_.size());
+  auto& posting = postings_.emplace_back();
 
   // replace original reference to 'term' provided by the caller
   // with a reference to the cached copy in 'writer_'
-  return map_utils::try_emplace_update_key(
-    map_,                  // container
-    generator,             // key generator
-    make_hashed_ref(term)  // key
+  posting.term = bytes_ref(
+    (writer_.position() - term.size()).buffer(), term.size()
   );
+  slots_[i] = make_slot(hash, id);
+
+  return std::make_pair(&posting, true);
 }
 
 }
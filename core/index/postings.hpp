@@ -24,11 +24,11 @@
 #ifndef IRESEARCH_POSTINGS_H
 #define IRESEARCH_POSTINGS_H
 
-#include <unordered_map>
+#include <vector>
 
 #include "shared.hpp"
 #include "utils/block_pool.hpp"
-#include "utils/hash_utils.hpp"
+#include "utils/integer.hpp"
 #include "utils/noncopyable.hpp"
 #include "utils/string.hpp"
 
@@ -37,6 +37,7 @@ namespace iresearch {
 typedef block_pool<byte_type, 32768> byte_block_pool;
 
 struct posting {
+  bytes_ref term; // term data cached in the byte pool of the field
   uint64_t doc_code;
   // ...........................................................................
   // store pointers to data in the following way:
@@ -53,30 +54,57 @@ struct posting {
   doc_id_t size{ 1 }; // length of postings
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class postings
+/// @brief in-memory term dictionary of a field, postings are stored
+///        contiguously in order of insertion, i.e. a term id is the offset of
+///        its posting, and are looked up by an open addressing hash table with
+///        linear probing over term ids, term data is stored in the byte pool
+////////////////////////////////////////////////////////////////////////////////
 class IRESEARCH_API postings: util::noncopyable {
  public:
-  typedef std::unordered_map<hashed_bytes_ref, posting> map_t;
-  typedef std::pair<map_t::iterator, bool> emplace_result;
+  typedef std::vector<posting>::const_iterator const_iterator;
+  typedef std::pair<posting*, bool> emplace_result;
   typedef byte_block_pool::inserter writer_t;
 
   postings(writer_t& writer);
 
-  inline map_t::const_iterator begin() const { return map_.begin(); }
+  inline const_iterator begin() const noexcept { return postings_.begin(); }
 
-  inline void clear() { map_.clear(); }
+  void clear() noexcept;
 
-  // on error returns std::ptr(end(), false)
+  // on error returns std::pair(nullptr, false)
   emplace_result emplace(const bytes_ref& term);
 
-  inline bool empty() const { return map_.empty(); }
+  inline bool empty() const noexcept { return postings_.empty(); }
 
-  inline map_t::const_iterator end() const { return map_.end(); }
+  inline const_iterator end() const noexcept { return postings_.end(); }
 
-  inline size_t size() const { return map_.size(); }
+  inline size_t size() const noexcept { return postings_.size(); }
 
  private:
+  // [63..32] - hash of the term, [31..0] - term id
+  typedef uint64_t slot_t;
+
+  static constexpr slot_t EMPTY_SLOT = integer_traits<slot_t>::const_max;
+
+  static constexpr slot_t make_slot(uint32_t hash, uint32_t id) noexcept {
+    return (slot_t(hash) << 32) | id;
+  }
+
+  static constexpr uint32_t slot_hash(slot_t slot) noexcept {
+    return uint32_t(slot >> 32);
+  }
+
+  static constexpr uint32_t slot_id(slot_t slot) noexcept {
+    return uint32_t(slot);
+  }
+
+  void rehash(size_t size);
+
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
-  map_t map_;
+  std::vector<posting> postings_; // postings by term id
+  std::vector<slot_t> slots_; // power of 2 slots, at most half are occupied
   writer_t& writer_;
   IRESEARCH_API_PRIVATE_VARIABLES_END
 };
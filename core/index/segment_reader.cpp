@@ -78,7 +78,7 @@ class mask_doc_iterator final : public irs::doc_iterator {
 
   virtual bool next() override {
     while (it_->next()) {
-      if (mask_.find(value()) == mask_.end()) {
+      if (!mask_.contains(value())) {
         return true;
       }
     }
@@ -89,7 +89,7 @@ class mask_doc_iterator final : public irs::doc_iterator {
   virtual irs::doc_id_t seek(irs::doc_id_t target) override {
     const auto doc = it_->seek(target);
 
-    if (mask_.find(doc) == mask_.end()) {
+    if (!mask_.contains(doc)) {
       return doc;
     }
 
@@ -125,12 +125,38 @@ class masked_docs_iterator
   }
 
   virtual bool next() override {
+    using word_t = irs::document_mask::word_t;
+
+    const auto& bits = docs_mask_.bits();
+
+    // skip masked documents a word at a time
     while (next_ < end_) {
-      current_.value = next_++;
+      const auto i = irs::bitset::word(next_);
+
+      if (i >= bits.words()) {
+        current_.value = next_++; // no masked documents past the bitset
 
-      if (docs_mask_.find(current_.value) == docs_mask_.end()) {
         return true;
       }
+
+      // unmasked documents in the word starting from 'next_'
+      const auto word = ~bits.data()[i] & (~word_t(0) << irs::bitset::bit(next_));
+
+      if (word) {
+        const auto doc = irs::doc_id_t(
+          irs::bitset::bit_offset(i) + irs::math::math_traits<word_t>::ctz(word));
+
+        if (doc >= end_) {
+          break;
+        }
+
+        current_.value = doc;
+        next_ = doc + 1;
+
+        return true;
+      }
+
+      next_ = irs::doc_id_t(irs::bitset::bit_offset(i + 1));
     }
 
     current_.value = irs::doc_limits::eof();
@@ -260,7 +286,8 @@ class segment_reader_impl : public sub_reader {
       return nullptr;
     }
 
-    if (docs_mask_.empty()) {
+    // block-decoding iterators skip masked documents themselves
+    if (docs_mask_.empty() || it->exclude(docs_mask_)) {
       return std::move(it);
     }
 
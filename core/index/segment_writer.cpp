@@ -27,6 +27,7 @@
 #include "index_meta.hpp"
 #include "analysis/token_stream.hpp"
 #include "analysis/token_attributes.hpp"
+#include "utils/async_utils.hpp"
 #include "utils/index_utils.hpp"
 #include "utils/log.hpp"
 #include "utils/lz4compression.hpp"
@@ -243,13 +244,30 @@ void segment_writer::flush_column_meta(const segment_meta& meta) {
   }
 }
 
-void segment_writer::flush_fields(const doc_map& docmap) {
-  flush_state state;
-  state.dir = &dir_;
-  state.doc_count = docs_cached();
-  state.name = seg_name_;
-  state.docmap = fields_.comparator() && !docmap.empty() ? &docmap : nullptr;
+void segment_writer::flush_columns(segment_meta& meta, const doc_map& docmap) {
+  if (fields_.comparator()) {
+    irs::sorted_column::flush_buffer_t buffer;
+    for (auto& column_entry : columns_) {
+      auto& column = column_entry.second;
 
+      if (!field_limits::valid(column.id)) {
+        // cached column
+        column.id = column.stream.flush(*col_writer_, docmap, buffer);
+      }
+    }
+  }
+
+  // flush columnstore
+  if (col_writer_->commit()) {
+    if (!columns_.empty()) {
+      flush_column_meta(meta);
+    }
+
+    meta.column_store = true;
+  }
+}
+
+void segment_writer::flush_fields(const flush_state& state) {
   try {
     fields_.flush(*field_writer_, state);
   } catch (...) {
@@ -261,14 +279,14 @@ void segment_writer::flush_fields(const doc_map& docmap) {
 
 size_t segment_writer::flush_doc_mask(const segment_meta &meta) {
   document_mask docs_mask;
-  docs_mask.reserve(docs_mask_.size());
+  docs_mask.reserve(doc_id_t(docs_mask_.size()));
 
   for (size_t doc_id = 0, doc_id_end = docs_mask_.size();
        doc_id < doc_id_end;
        ++doc_id) {
     if (docs_mask_.test(doc_id)) {
       assert(size_t(integer_traits<doc_id_t>::const_max) >= doc_id + doc_limits::min());
-      docs_mask.emplace(doc_id_t(doc_id + doc_limits::min()));
+      docs_mask.insert(doc_id_t(doc_id + doc_limits::min()));
     }
   }
 
@@ -278,7 +296,9 @@ size_t segment_writer::flush_doc_mask(const segment_meta &meta) {
   return docs_mask.size();
 }
 
-void segment_writer::flush(index_meta::index_segment_t& segment) {
+void segment_writer::flush(
+    index_meta::index_segment_t& segment,
+    async_utils::thread_pool* pool /*= nullptr*/) {
   REGISTER_TIMER_DETAILED();
 
   auto& meta = segment.meta;
@@ -292,33 +312,40 @@ void segment_writer::flush(index_meta::index_segment_t& segment) {
       *fields_.comparator()
     );
 
-    irs::sorted_column::flush_buffer_t buffer;
-    for (auto& column_entry : columns_) {
-      auto& column = column_entry.second;
-
-      if (!field_limits::valid(column.id)) {
-        // cached column
-        column.id = column.stream.flush(*col_writer_, docmap, buffer);
-      }
-    }
-
     meta.sort = sort_.id; // store sorted column id in segment meta
   }
 
-  // flush columnstore
-  if (col_writer_->commit()) {
-    if (!columns_.empty()) {
-      flush_column_meta(meta);
-    }
-
-    meta.column_store = true;
-  }
+  flush_state state;
+  state.dir = &dir_;
+  state.doc_count = docs_cached();
+  state.name = seg_name_;
+  state.docmap = fields_.comparator() && !docmap.empty() ? &docmap : nullptr;
 
-  // flush fields metadata & inverted data
+  // field writer creates its files via the non thread-safe 'dir_',
+  // prepare it before the columnstore is flushed concurrently
   if (docs_cached()) {
-    flush_fields(docmap);
+    try {
+      fields_.prepare(*field_writer_, state);
+    } catch (...) {
+      field_writer_.reset(); // invalidate field writer
+
+      throw;
+    }
   }
 
+  // flush columnstore and fields metadata & inverted data,
+  // the stages write distinct files
+  async_utils::run_concurrently(
+    pool,
+    [this, &meta, &docmap]() {
+      flush_columns(meta, docmap);
+    },
+    [this, &state]() {
+      if (docs_cached()) {
+        flush_fields(state);
+      }
+    });
+
   // write non-empty document mask
   size_t docs_mask_count = 0;
   if (docs_mask_.any()) {
@@ -41,6 +41,10 @@ class comparer;
 struct segment_meta;
 class segment_writer;
 
+namespace async_utils {
+class thread_pool;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @enum Action
 /// @brief defines how the inserting field should be processed
@@ -212,7 +216,14 @@ class IRESEARCH_API segment_writer: util::noncopyable {
     valid_ = false;
   }
 
-  void flush(index_meta::index_segment_t& segment);
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief flushes buffered documents into the specified segment
+  /// @param pool if specified, the columnstore is flushed on the 'pool'
+  ///        concurrently with the term dictionary and postings
+  //////////////////////////////////////////////////////////////////////////////
+  void flush(
+    index_meta::index_segment_t& segment,
+    async_utils::thread_pool* pool = nullptr);
 
   const std::string& name() const noexcept { return seg_name_; }
   size_t docs_cached() const noexcept { return docs_context_.size(); }
@@ -381,7 +392,8 @@ class IRESEARCH_API segment_writer: util::noncopyable {
 
   size_t flush_doc_mask(const segment_meta& meta); // flushes document mask to directory, returns number of masked documens
   void flush_column_meta(const segment_meta& meta); // flushes column meta to directory
-  void flush_fields(const doc_map& docmap); // flushes indexed fields to directory
+  void flush_columns(segment_meta& meta, const doc_map& docmap); // flushes stored columns and column meta to directory
+  void flush_fields(const flush_state& state); // flushes indexed fields via prepared field writer
 
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
   sorted_column sort_;
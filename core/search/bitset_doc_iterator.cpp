@@ -22,6 +22,7 @@
 
 #include "bitset_doc_iterator.hpp"
 #include "formats/empty_term_reader.hpp"
+#include "index/document_mask.hpp"
 #include "utils/bitset.hpp"
 #include "utils/math_utils.hpp"
 
@@ -44,6 +45,23 @@ bitset_doc_iterator::bitset_doc_iterator(const bitset& set,
     next_(begin_) {
 }
 
+bitset_doc_iterator::bitset_doc_iterator(bitset&& set)
+  : attributes{{
+      { type<document>::id(), &doc_   },
+      { type<cost>::id(),     &cost_  },
+      { type<score>::id(),    &score_ },
+    }},
+    set_(std::move(set)),
+    cost_(set_.count()),
+    doc_(cost_.estimate()
+      ? doc_limits::invalid()
+      : doc_limits::eof()),
+    score_(order::prepared::unordered()),
+    begin_(set_.begin()),
+    end_(set_.end()),
+    next_(begin_) {
+}
+
 bitset_doc_iterator::bitset_doc_iterator(
       const sub_reader& reader,
       const byte_type* stats,
@@ -72,7 +90,7 @@ bool bitset_doc_iterator::next() noexcept {
       return false;
     }
 
-    word_ = *next_++;
+    word_ = load(next_++);
     base_ += bits_required<word_t>();
   }
 
@@ -83,6 +101,40 @@ bool bitset_doc_iterator::next() noexcept {
   return true;
 }
 
+doc_block bitset_doc_iterator::next_block() noexcept {
+  while (!word_) {
+    if (next_ >= end_) {
+      doc_.value = doc_limits::eof();
+
+      return {};
+    }
+
+    word_ = load(next_++);
+    base_ += bits_required<word_t>();
+  }
+
+  size_t size = 0;
+
+  do {
+    const doc_id_t delta = math::math_traits<word_t>::ctz(word_);
+    irs::unset_bit(word_, delta);
+    block_[size++] = base_ + delta;
+  } while (word_);
+
+  doc_.value = block_[size - 1];
+
+  return { block_, nullptr, size };
+}
+
+bool bitset_doc_iterator::exclude(const document_mask& mask) noexcept {
+  const auto& bits = mask.bits();
+
+  mask_ = bits.data();
+  mask_words_ = bits.words();
+
+  return true;
+}
+
 doc_id_t bitset_doc_iterator::seek(doc_id_t target) noexcept {
   next_ = begin_ + bitset::word(target);
 
@@ -94,7 +146,7 @@ doc_id_t bitset_doc_iterator::seek(doc_id_t target) noexcept {
   }
 
   base_ = doc_id_t(std::distance(begin_, next_) * bits_required<word_t>());
-  word_ = (*next_++) & ((~word_t(0)) << bitset::bit(target));
+  word_ = load(next_++) & ((~word_t(0)) << bitset::bit(target));
 
   next();
 
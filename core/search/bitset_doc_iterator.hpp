@@ -40,6 +40,11 @@ class bitset_doc_iterator final
     : bitset_doc_iterator(set, order::prepared::unordered()) {
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief unscored iterator over a bitset owned by the iterator
+  //////////////////////////////////////////////////////////////////////////////
+  explicit bitset_doc_iterator(bitset&& set);
+
   bitset_doc_iterator(
     const sub_reader& reader,
     const byte_type* stats,
@@ -51,19 +56,43 @@ class bitset_doc_iterator final
   virtual doc_id_t seek(doc_id_t target) noexcept override;
   virtual doc_id_t value() const noexcept override { return doc_.value; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the remaining documents of the current word of a bitset
+  //////////////////////////////////////////////////////////////////////////////
+  virtual doc_block next_block() noexcept override;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief masked documents are cleared from each word of a bitset as it's
+  ///        loaded, i.e. a word of masked documents costs a single AND-NOT
+  //////////////////////////////////////////////////////////////////////////////
+  virtual bool exclude(const document_mask& mask) noexcept override;
+
  private:
   using word_t = bitset::word_t;
 
   bitset_doc_iterator(const bitset& set, const order::prepared& ord);
 
+  // returns the word at 'it' without masked documents
+  word_t load(const word_t* it) const noexcept {
+    const auto i = size_t(std::distance(begin_, it));
+
+    return i < mask_words_
+      ? *it & ~mask_[i]
+      : *it;
+  }
+
+  bitset set_; // owned bitset, empty if iterator doesn't own a bitset
   cost cost_;
   document doc_;
   score score_;
   const word_t* begin_;
   const word_t* end_;
   const word_t* next_;
+  const word_t* mask_{}; // words of masked documents, nullptr if none
+  size_t mask_words_{}; // number of words in 'mask_'
   word_t word_{};
   doc_id_t base_{doc_limits::invalid() - bits_required<word_t>()}; // before the first word
+  doc_id_t block_[bits_required<word_t>()]; // documents of the current word
 }; // bitset_doc_iterator
 
 } // ROOT
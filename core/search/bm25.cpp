@@ -30,10 +30,98 @@
 #include "index/field_meta.hpp"
 #include "utils/math_utils.hpp"
 
+#if defined(IRESEARCH_AVX2)
+#include <immintrin.h>
+#elif defined(IRESEARCH_SSE2)
+#include <emmintrin.h>
+#endif
+
 namespace {
 
 const irs::math::sqrt<uint32_t, float_t, 1024> SQRT;
 
+#if defined(IRESEARCH_AVX2)
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts unsigned 32-bit integers to floats the same way as a scalar
+///        conversion does, '_mm256_cvtepi32_ps' treats the lanes as signed
+////////////////////////////////////////////////////////////////////////////////
+FORCE_INLINE __m256 cvtepu32_ps(__m256i v) noexcept {
+  const __m256 hi = _mm256_cvtepi32_ps(_mm256_srli_epi32(v, 16));
+  const __m256 lo = _mm256_cvtepi32_ps(_mm256_and_si256(v, _mm256_set1_epi32(0xFFFF)));
+
+  // 'hi * 2^16' and 'lo' are exact, the sum is rounded once
+  return _mm256_add_ps(_mm256_mul_ps(hi, _mm256_set1_ps(65536.f)), lo);
+}
+#elif defined(IRESEARCH_SSE2)
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts unsigned 32-bit integers to floats the same way as a scalar
+///        conversion does, '_mm_cvtepi32_ps' treats the lanes as signed
+////////////////////////////////////////////////////////////////////////////////
+FORCE_INLINE __m128 cvtepu32_ps(__m128i v) noexcept {
+  const __m128 hi = _mm_cvtepi32_ps(_mm_srli_epi32(v, 16));
+  const __m128 lo = _mm_cvtepi32_ps(_mm_and_si128(v, _mm_set1_epi32(0xFFFF)));
+
+  // 'hi * 2^16' and 'lo' are exact, the sum is rounded once
+  return _mm_add_ps(_mm_mul_ps(hi, _mm_set1_ps(65536.f)), lo);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluates 'num * tf / (norm_const + norm_length * norm + tf)' for a
+///        block of documents, 'norms == nullptr' stands for BM15
+/// @note operations are performed in the same order as in the per-document
+///       scorers in order to produce the same scores
+////////////////////////////////////////////////////////////////////////////////
+void score_block(
+    float_t num,
+    float_t norm_const,
+    float_t norm_length,
+    const uint32_t* RESTRICT freqs,
+    const float_t* RESTRICT norms,
+    float_t* RESTRICT scores,
+    size_t count) noexcept {
+  size_t i = 0;
+
+#if defined(IRESEARCH_AVX2)
+  const __m256 vnum = _mm256_set1_ps(num);
+  const __m256 vnorm_const = _mm256_set1_ps(norm_const);
+  const __m256 vnorm_length = _mm256_set1_ps(norm_length);
+
+  for (; i + 8 <= count; i += 8) {
+    const __m256 tf = _mm256_sqrt_ps(cvtepu32_ps(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(freqs + i))));
+    const __m256 denom = norms
+      ? _mm256_add_ps(vnorm_const, _mm256_mul_ps(vnorm_length, _mm256_loadu_ps(norms + i)))
+      : vnorm_const;
+
+    _mm256_storeu_ps(scores + i, _mm256_div_ps(_mm256_mul_ps(vnum, tf),
+                                               _mm256_add_ps(denom, tf)));
+  }
+#elif defined(IRESEARCH_SSE2)
+  const __m128 vnum = _mm_set1_ps(num);
+  const __m128 vnorm_const = _mm_set1_ps(norm_const);
+  const __m128 vnorm_length = _mm_set1_ps(norm_length);
+
+  for (; i + 4 <= count; i += 4) {
+    const __m128 tf = _mm_sqrt_ps(cvtepu32_ps(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(freqs + i))));
+    const __m128 denom = norms
+      ? _mm_add_ps(vnorm_const, _mm_mul_ps(vnorm_length, _mm_loadu_ps(norms + i)))
+      : vnorm_const;
+
+    _mm_storeu_ps(scores + i, _mm_div_ps(_mm_mul_ps(vnum, tf),
+                                         _mm_add_ps(denom, tf)));
+  }
+#endif
+
+  // remaining documents
+  for (; i < count; ++i) {
+    const float_t tf = ::SQRT(freqs[i]);
+    const float_t denom = norms ? norm_const + norm_length * norms[i] : norm_const;
+    scores[i] = num * tf / (denom + tf);
+  }
+}
+
 irs::sort::ptr make_from_object(
     const rapidjson::Document& json,
     const irs::string_ref& args) {
@@ -514,6 +602,68 @@ class sort final : public irs::prepared_sort_basic<bm25::score_t, bm25::stats> {
     return irs::memory::make_unique<term_collector>();
   }
 
+  virtual float_t max_score(
+      const byte_type* query_stats,
+      boost_t boost,
+      uint32_t max_freq) const override {
+    if (boost < 0.f || k_ < 0.f || b_ < 0.f || b_ > 1.f) {
+      // score isn't monotonic in term frequency
+      return no_max_score();
+    }
+
+    auto& stats = stats_cast(query_stats);
+    const float_t num = boost * (k_ + 1) * stats.idf;
+
+    // the least possible denominator constant since 'norm_length * norm' >= 0,
+    // 'k' is used if either b == 0 or there are no norms for a field
+    const float_t norm_const = b_ != 0.f ? std::min(k_, stats.norm_const) : k_;
+
+    // bm25 saturates at 'num' for unbounded term frequency
+    float_t max = num;
+
+    if (max_freq != no_max_freq()) {
+      const float_t tf = ::SQRT(max_freq);
+      max = tf > 0.f ? num * tf / (norm_const + tf) : 0.f;
+    }
+
+    // documents without frequency get 'boost' as a score
+    return boost_as_score_ ? std::max(max, boost) : max;
+  }
+
+  virtual bool score_block(
+      const byte_type* query_stats,
+      boost_t boost,
+      const uint32_t* freqs,
+      const float_t* norms,
+      float_t* scores,
+      size_t count) const override {
+    assert(scores);
+
+    if (!freqs) {
+      if (!boost_as_score_ || 0.f == boost) {
+        return false; // documents aren't scored, see 'prepare_scorer(...)'
+      }
+
+      // if there is no frequency then all the scores are the same
+      std::fill_n(scores, count, boost);
+
+      return true;
+    }
+
+    auto& stats = stats_cast(query_stats);
+    const float_t num = boost * (k_ + 1) * stats.idf;
+
+    if (b_ != 0.f && norms) {
+      ::score_block(num, stats.norm_const, stats.norm_length,
+                    freqs, norms, scores, count);
+    } else {
+      // BM15
+      ::score_block(num, k_, 0.f, freqs, nullptr, scores, count);
+    }
+
+    return true;
+  }
+
  private:
   float_t k_;
   float_t b_;
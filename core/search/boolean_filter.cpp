@@ -26,8 +26,10 @@
 
 #include "conjunction.hpp"
 #include "disjunction.hpp"
+#include "maxscore_disjunction.hpp"
 #include "min_match_disjunction.hpp"
 #include "exclusion.hpp"
+#include "query_plan.hpp"
 
 namespace {
 
@@ -45,6 +47,66 @@ std::pair<const irs::filter*, bool> optimize_not(const irs::Not& node) {
 }
 
 const irs::all all_docs_zero_boost = []() {irs::all a; a.boost(0); return a;}();
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class nested_context
+/// @brief execution context for the nested queries, hides 'score_threshold'
+///        since the threshold refers to the score of a whole boolean query
+//////////////////////////////////////////////////////////////////////////////
+class nested_context final : public irs::attribute_provider {
+ public:
+  explicit nested_context(const irs::attribute_provider* ctx) noexcept
+    : ctx_(ctx) {
+  }
+
+  virtual irs::attribute* get_mutable(irs::type_info::type_id type) override {
+    if (!ctx_ || irs::type<irs::score_threshold>::id() == type) {
+      return nullptr;
+    }
+
+    return const_cast<irs::attribute_provider*>(ctx_)->get_mutable(type);
+  }
+
+  const irs::attribute_provider* get() const {
+    return ctx_ && irs::get<irs::score_threshold>(*ctx_) ? this : ctx_;
+  }
+
+ private:
+  const irs::attribute_provider* ctx_;
+}; // nested_context
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns query plan provided via the specified context, nullptr if none
+//////////////////////////////////////////////////////////////////////////////
+irs::query_plan* get_plan(const irs::attribute_provider* ctx) {
+  return ctx
+    ? irs::get_mutable<irs::query_plan>(const_cast<irs::attribute_provider*>(ctx))
+    : nullptr;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief adds a step to a query plan provided via the specified context
+//////////////////////////////////////////////////////////////////////////////
+void add_step(const irs::attribute_provider* ctx, const char* description) {
+  auto* plan = get_plan(ctx);
+
+  if (plan) {
+    plan->add(description);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns true if scores of all the specified iterators are bounded
+//////////////////////////////////////////////////////////////////////////////
+template<typename Iterators>
+bool has_max_score(const Iterators& itrs) noexcept {
+  return std::all_of(
+    itrs.begin(), itrs.end(),
+    [](const typename Iterators::value_type& it) noexcept {
+      assert(it.score);
+      return it.score->max >= 0.f && it.score->max != irs::no_max_score();
+  });
+}
 //////////////////////////////////////////////////////////////////////////////
 /// @returns disjunction iterator created from the specified queries
 //////////////////////////////////////////////////////////////////////////////
@@ -68,39 +130,126 @@ irs::doc_iterator::ptr make_disjunction(
     return irs::doc_iterator::empty();
   }
 
+  auto* plan = get_plan(ctx);
+  const size_t step = plan ? plan->add() : 0;
+
   scored_disjunction_t::doc_iterators_t itrs;
   itrs.reserve(size);
 
-  for (;begin != end; ++begin) {
-    // execute query - get doc iterator
-    auto docs = begin->execute(rdr, ord, ctx);
+  {
+    const irs::query_plan::scope scope(plan);
+    const nested_context nested_ctx(ctx);
 
-    // filter out empty iterators
-    if (!irs::doc_limits::eof(docs->value())) {
-      itrs.emplace_back(std::move(docs));
+    for (;begin != end; ++begin) {
+      // execute query - get doc iterator
+      auto docs = begin->execute(rdr, ord, nested_ctx.get());
+
+      // filter out empty iterators
+      if (!irs::doc_limits::eof(docs->value())) {
+        itrs.emplace_back(std::move(docs));
+      }
     }
   }
 
+  if (plan) {
+    (*plan)[step] = "disjunction of " + std::to_string(itrs.size())
+                  + " non-empty iterators out of " + std::to_string(size);
+  }
+
   if (ord.empty()) {
+    const irs::doc_id_t docs_count = irs::doc_id_t(rdr.docs_count());
+    // don't evaluate the costs of subqueries unless necessary
+    const auto cost = [&itrs]() {
+      return std::accumulate(
+        itrs.begin(), itrs.end(), irs::cost::cost_t(0),
+        [](irs::cost::cost_t lhs, const disjunction_t::adapter& rhs) {
+          return lhs + irs::cost::extract(rhs, 0);
+      });
+    };
+
+    if (irs::is_bitset_disjunction_cheaper(itrs.size(), cost, docs_count)) {
+      if (plan) {
+        (*plan)[step] += ", accumulated into a bitset of "
+                      + std::to_string(docs_count) + " documents";
+      }
+
+      // wide disjunctions are accumulated into a bitset
+      return irs::make_bitset_disjunction(std::move(itrs), docs_count);
+    }
+
+    if (plan && itrs.size() > 1) {
+      (*plan)[step] += ", merged by windows";
+    }
+
     return irs::make_disjunction<disjunction_t>(
       std::move(itrs), ord, std::forward<Args>(args)...);
   }
 
+  // maxscore_disjunction supports aggregation of scores only
+  if constexpr (0 == sizeof...(Args)) {
+    const auto* threshold = ctx ? irs::get<irs::score_threshold>(*ctx) : nullptr;
+
+    if (threshold && itrs.size() > 1 && has_max_score(itrs)) {
+      using maxscore_disjunction_t = irs::maxscore_disjunction<irs::doc_iterator::ptr>;
+
+      if (plan) {
+        (*plan)[step] += ", scored, skips documents below the score threshold";
+      }
+
+      return irs::memory::make_managed<maxscore_disjunction_t>(
+        std::move(itrs), ord, *threshold);
+    }
+  }
+
+  if (plan && itrs.size() > 1) {
+    (*plan)[step] += ", scored, merged by windows";
+  }
+
   return irs::make_disjunction<scored_disjunction_t>(
     std::move(itrs), ord, std::forward<Args>(args)...);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @returns true if the exclusion with the specified 'cost' should be applied
+///          to the leading iterator of a conjunction rather than to its
+///          result, i.e. if the exclusion prunes more documents of the leading
+///          iterator than the rest of the iterators do
+/// @note the leading iterator is expected to be the cheapest one, the
+///       documents of different iterators are assumed to be independent
+//////////////////////////////////////////////////////////////////////////////
+template<typename Iterators>
+bool is_lead_exclusion_cheaper(
+    const Iterators& itrs,
+    irs::cost::cost_t cost,
+    size_t docs_count) noexcept {
+  assert(!itrs.empty());
+
+  const double count = double(std::max(docs_count, size_t(1)));
+  const auto selectivity = [count](irs::cost::cost_t cost) noexcept {
+    return std::min(1., double(cost) / count);
+  };
+
+  double kept = 1.; // fraction of the documents kept by the rest of iterators
+  for (auto begin = std::next(itrs.begin()), end = itrs.end(); begin != end; ++begin) {
+    kept *= selectivity(irs::cost::extract(*begin, irs::cost::MAX));
+  }
+
+  return selectivity(cost) > 1. - kept;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @returns conjunction iterator created from the specified queries
+/// @param excl iterator over the documents to exclude, it's consumed if the
+///        exclusion is applied within a conjunction, nullptr if none
 //////////////////////////////////////////////////////////////////////////////
-template<typename QueryIterator, typename... Args>
+template<typename QueryIterator>
 irs::doc_iterator::ptr make_conjunction(
     const irs::sub_reader& rdr,
     const irs::order::prepared& ord,
     const irs::attribute_provider* ctx,
     QueryIterator begin,
     QueryIterator end,
-    Args&&... args) {
+    irs::doc_iterator::ptr& excl) {
   typedef irs::conjunction<irs::doc_iterator::ptr> conjunction_t;
 
   assert(std::distance(begin, end) >= 0);
@@ -114,23 +263,89 @@ irs::doc_iterator::ptr make_conjunction(
       return begin->execute(rdr, ord, ctx);
   }
 
+  auto* plan = get_plan(ctx);
+  const size_t step = plan ? plan->add() : 0;
+
   conjunction_t::doc_iterators_t itrs;
   itrs.reserve(size);
 
-  for (;begin != end; ++begin) {
-    auto docs = begin->execute(rdr, ord, ctx);
+  {
+    const irs::query_plan::scope scope(plan);
+    const nested_context nested_ctx(ctx);
 
-    // filter out empty iterators
-    if (irs::doc_limits::eof(docs->value())) {
-      return irs::doc_iterator::empty();
+    for (;begin != end; ++begin) {
+      auto docs = begin->execute(rdr, ord, nested_ctx.get());
+
+      // filter out empty iterators
+      if (irs::doc_limits::eof(docs->value())) {
+        if (plan) {
+          (*plan)[step] = "conjunction of " + std::to_string(size)
+                        + " iterators, iterator " + std::to_string(itrs.size())
+                        + " is empty";
+        }
+
+        return irs::doc_iterator::empty();
+      }
+
+      itrs.emplace_back(std::move(docs));
+    }
+  }
+
+  // the cheapest iterator leads, the rest is ordered by the conjunction
+  std::iter_swap(
+    itrs.begin(),
+    std::min_element(
+      itrs.begin(), itrs.end(),
+      [](const conjunction_t::doc_iterator_t& lhs,
+         const conjunction_t::doc_iterator_t& rhs) {
+        return irs::cost::extract(lhs, irs::cost::MAX)
+             < irs::cost::extract(rhs, irs::cost::MAX);
+  }));
+
+  if (plan) {
+    std::vector<irs::cost::cost_t> costs;
+    costs.reserve(itrs.size());
+    for (auto& it : itrs) {
+      costs.push_back(irs::cost::extract(it, irs::cost::MAX));
     }
+    std::sort(costs.begin(), costs.end());
 
-    itrs.emplace_back(std::move(docs));
+    auto& description = (*plan)[step];
+    description = "conjunction of " + std::to_string(size) + " iterators, costs";
+    for (auto cost : costs) {
+      description += " " + std::to_string(cost);
+    }
   }
 
-  return irs::make_conjunction<conjunction_t>(
-     std::move(itrs), ord, std::forward<Args>(args)...
-  );
+  if (ord.empty()) {
+    if (plan) {
+      (*plan)[step] += ", intersected by blocks";
+    }
+
+    // unscored conjunction intersects blocks of documents, so the
+    // exclusion is applied to its result not to break blocks of
+    // the leading iterator
+    return irs::make_conjunction<irs::block_conjunction<irs::doc_iterator::ptr>>(
+      std::move(itrs));
+  }
+
+  if (excl) {
+    const auto cost = irs::cost::extract(*excl, irs::cost::MAX);
+
+    if (is_lead_exclusion_cheaper(itrs, cost, rdr.docs_count())) {
+      if (plan) {
+        (*plan)[step] += ", exclusion of cost " + std::to_string(cost)
+                      + " is applied to the leading iterator";
+      }
+
+      auto& lead = itrs.front();
+      lead = conjunction_t::doc_iterator_t(
+        irs::memory::make_managed<irs::exclusion>(
+          std::move(lead.it), std::move(excl)));
+    }
+  }
+
+  return irs::make_conjunction<conjunction_t>(std::move(itrs), ord);
 }
 
 } // LOCAL
@@ -157,18 +372,40 @@ class boolean_query : public filter::prepared {
     }
 
     assert(excl_);
-    auto incl = execute(rdr, ord, ctx, begin(), begin() + excl_);
+    auto* plan = get_plan(ctx);
+
+    doc_iterator::ptr excl;
+    size_t step = 0;
+    if (excl_ < size()) {
+      step = plan ? plan->add("exclusion") : 0;
+      const query_plan::scope scope(plan);
 
-    // exclusion part does not affect scoring at all
-    auto excl = ::make_disjunction(rdr, order::prepared::unordered(), ctx,
-                                   begin() + excl_, end());
+      // exclusion part does not affect scoring at all
+      excl = ::make_disjunction(rdr, order::prepared::unordered(), ctx,
+                                begin() + excl_, end());
 
-    // got empty iterator for excluded
-    if (doc_limits::eof(excl->value())) {
+      // got empty iterator for excluded
+      if (doc_limits::eof(excl->value())) {
+        excl.reset();
+
+        if (plan) {
+          (*plan)[step] += ", nothing to exclude";
+        }
+      }
+    }
+
+    // the exclusion may be consumed by the included part
+    auto incl = execute(rdr, ord, ctx, begin(), begin() + excl_, excl);
+
+    if (!excl) {
       // pure conjunction/disjunction
       return incl;
     }
 
+    if (plan) {
+      (*plan)[step] += ", applied to the result";
+    }
+
     return memory::make_managed<exclusion>(std::move(incl), std::move(excl));
   }
 
@@ -210,12 +447,17 @@ class boolean_query : public filter::prepared {
   size_t size() const { return queries_.size(); }
 
  protected:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @param excl iterator over the documents to exclude, nullptr if none,
+  ///        may be consumed by an implementation
+  //////////////////////////////////////////////////////////////////////////////
   virtual doc_iterator::ptr execute(
     const sub_reader& rdr,
     const order::prepared& ord,
     const attribute_provider* ctx,
     iterator begin,
-    iterator end) const = 0;
+    iterator end,
+    doc_iterator::ptr& excl) const = 0;
 
  private:
   // 0..excl_-1 - included queries
@@ -236,8 +478,9 @@ class and_query final : public boolean_query {
       const order::prepared& ord,
       const attribute_provider* ctx,
       iterator begin,
-      iterator end) const override {
-    return ::make_conjunction(rdr, ord, ctx, begin, end);
+      iterator end,
+      doc_iterator::ptr& excl) const override {
+    return ::make_conjunction(rdr, ord, ctx, begin, end, excl);
   }
 };
 
@@ -252,7 +495,8 @@ class or_query final : public boolean_query {
       const order::prepared& ord,
       const attribute_provider* ctx,
       iterator begin,
-      iterator end) const override {
+      iterator end,
+      doc_iterator::ptr& /*excl*/) const override {
     return ::make_disjunction(rdr, ord, ctx, begin, end);
   }
 }; // or_query
@@ -278,7 +522,8 @@ class min_match_query final : public boolean_query {
       const order::prepared& ord,
       const attribute_provider* ctx,
       iterator begin,
-      iterator end) const override {
+      iterator end,
+      doc_iterator::ptr& excl) const override {
     assert(std::distance(begin, end) >= 0);
     const size_t size = size_t(std::distance(begin, end));
 
@@ -291,7 +536,7 @@ class min_match_query final : public boolean_query {
       return doc_iterator::empty();
     } else if (min_match_count == size) {
       // pure conjunction
-      return ::make_conjunction(rdr, ord, ctx, begin, end);
+      return ::make_conjunction(rdr, ord, ctx, begin, end, excl);
     }
 
     // min_match_count <= size
@@ -300,9 +545,11 @@ class min_match_query final : public boolean_query {
     disjunction_t::doc_iterators_t itrs;
     itrs.reserve(size);
 
+    const nested_context nested_ctx(ctx);
+
     for (;begin != end; ++begin) {
       // execute query - get doc iterator
-      auto docs = begin->execute(rdr, ord, ctx);
+      auto docs = begin->execute(rdr, ord, nested_ctx.get());
 
       // filter out empty iterators
       if (!doc_limits::eof(docs->value())) {
@@ -333,6 +580,16 @@ class min_match_query final : public boolean_query {
     if (min_match_count == size) {
       typedef conjunction<doc_iterator::ptr> conjunction_t;
 
+      if (ord.empty()) {
+        typedef block_conjunction<doc_iterator::ptr> block_conjunction_t;
+
+        // pure unscored conjunction
+        return memory::make_managed<block_conjunction_t>(
+          block_conjunction_t::doc_iterators_t(
+            std::make_move_iterator(itrs.begin()),
+            std::make_move_iterator(itrs.end())));
+      }
+
       // pure conjunction
       return memory::make_managed<conjunction_t>(
         conjunction_t::doc_iterators_t(
@@ -471,6 +728,7 @@ filter::prepared::ptr And::prepare(
   //optimization step
   // if include group empty itself or has 'empty' -> this whole conjunction is empty
   if (incl.empty() || incl.back()->type() == irs::type<irs::empty>::id()) {
+    add_step(ctx, "And: matches nothing, has no or empty filters");
     return prepared::empty();
   }
 
@@ -484,6 +742,7 @@ filter::prepared::ptr And::prepare(
     }
   }
   if (all_count != 0) {
+    add_step(ctx, "And: 'all' filters are merged");
     const auto non_all_count = incl.size() - all_count;
     auto it = std::remove_if(
       incl.begin(), incl.end(),
@@ -518,6 +777,7 @@ filter::prepared::ptr And::prepare(
   }
   boost *= this->boost();
   if (1 == incl.size() && excl.empty()) {
+    add_step(ctx, "And: reduced to a single filter");
     // single node case
     return incl.front()->prepare(rdr, ord, boost, ctx);
   }
@@ -549,6 +809,7 @@ filter::prepared::ptr Or::prepare(
   boost *= this->boost();
 
   if (0 == min_match_count_) { // only explicit 0 min match counts!
+    add_step(ctx, "Or: matches all documents, min match count is 0");
     // all conditions are satisfied
     return all().prepare(rdr, ord, boost, ctx);
   }
@@ -558,6 +819,7 @@ filter::prepared::ptr Or::prepare(
   }
 
   if (incl.empty()) {
+    add_step(ctx, "Or: matches nothing, has no filters");
     return prepared::empty();
   }
 
@@ -580,11 +842,13 @@ filter::prepared::ptr Or::prepare(
       // if we have at least one all in include group - all other filters are not necessary
       // in case there is no scoring and 'all' count satisfies  min_match
       assert(incl_all != nullptr);
+      add_step(ctx, "Or: reduced to 'all' filter, no scoring");
       incl.resize(1);
       incl.front() = incl_all;
       optimized_match_count = all_count - 1;
     } else {
       // Here Or differs from And. Last All should be left in include group
+      add_step(ctx, "Or: 'all' filters are merged");
       auto it = std::remove_if(
         incl.begin(), incl.end(),
         [](const irs::filter* filter) {
@@ -604,12 +868,14 @@ filter::prepared::ptr Or::prepare(
                                         1;
 
   if (adjusted_min_match_count > incl.size()) {
+    add_step(ctx, "Or: matches nothing, min match count exceeds number of filters");
     // can't satisfy 'min_match_count' conditions
     // having only 'incl.size()' queries
     return prepared::empty();
   }
 
   if (1 == incl.size() && excl.empty()) {
+    add_step(ctx, "Or: reduced to a single filter");
     // single node case
     return incl.front()->prepare(rdr, ord, boost, ctx);
   }
@@ -618,6 +884,7 @@ filter::prepared::ptr Or::prepare(
 
   memory::managed_ptr<boolean_query> q;
   if (adjusted_min_match_count == incl.size()) {
+    add_step(ctx, "Or: min match count equals number of filters, executed as And");
     q = memory::make_managed<and_query>();
   } else if (1 == adjusted_min_match_count) {
     q = memory::make_managed<or_query>();
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#include "conjunction.hpp"
+
+#if defined(IRESEARCH_AVX2)
+#include <immintrin.h>
+#elif defined(IRESEARCH_SSE4_2)
+#include <nmmintrin.h>
+#elif defined(IRESEARCH_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+using namespace irs;
+
+#if defined(IRESEARCH_SSE4_2) && !defined(IRESEARCH_AVX2)
+
+// intersects 4 candidates with 4 documents of a block at once by comparing
+// all pairs via rotations of the documents, the vector with the lesser last
+// value is consumed, the candidates of the other one not greater than that
+// value are decided as well
+// returns the first undecided candidate
+const doc_id_t* intersect_block_sse42(
+    doc_id_t*& out,
+    const doc_id_t* begin,
+    const doc_id_t* end,
+    const doc_id_t*& block,
+    const doc_id_t* block_end) noexcept {
+  while (end - begin >= 4 && block_end - block >= 4) {
+    const __m128i candidates = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const __m128i docs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    const doc_id_t last_candidate = begin[3];
+    const doc_id_t last_doc = block[3];
+
+    __m128i mask = _mm_cmpeq_epi32(candidates, docs);
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi32(
+      candidates, _mm_shuffle_epi32(docs, _MM_SHUFFLE(0, 3, 2, 1))));
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi32(
+      candidates, _mm_shuffle_epi32(docs, _MM_SHUFFLE(1, 0, 3, 2))));
+    mask = _mm_or_si128(mask, _mm_cmpeq_epi32(
+      candidates, _mm_shuffle_epi32(docs, _MM_SHUFFLE(2, 1, 0, 3))));
+
+    // candidates not greater than 'last_doc' are decided
+    size_t decided = 4;
+    if (last_doc < last_candidate) {
+      for (decided = 0; begin[decided] <= last_doc; ++decided) { }
+    }
+
+    if (!_mm_testz_si128(mask, mask)) {
+      // matched candidates are always decided, 'out' never passes 'begin'
+      const int matched = _mm_movemask_ps(_mm_castsi128_ps(mask));
+
+      for (size_t i = 0; i < decided; ++i) {
+        *out = begin[i];
+        out += (matched >> i) & 1;
+      }
+    }
+
+    begin += decided;
+
+    if (last_doc <= last_candidate) {
+      block += 4;
+    }
+  }
+
+  return begin;
+}
+
+#endif
+
+}
+
+namespace iresearch {
+
+const doc_id_t* intersect_block(
+    doc_id_t*& out,
+    const doc_id_t* begin,
+    const doc_id_t* end,
+    const doc_id_t*& block,
+    const doc_id_t* block_end) noexcept {
+  assert(out <= begin);
+
+#if defined(IRESEARCH_SSE4_2) && !defined(IRESEARCH_AVX2)
+  begin = intersect_block_sse42(out, begin, end, block, block_end);
+#endif
+
+  for (; begin != end; ++begin) {
+    const doc_id_t target = *begin;
+
+#if defined(IRESEARCH_AVX2)
+    // skip 8 documents at once while all of them are less than the target,
+    // then compare the target against the next 8 documents
+    for (; block_end - block >= 8 && block[7] < target; block += 8) { }
+
+    if (block_end - block >= 8) {
+      const __m256i docs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+      const __m256i mask = _mm256_cmpeq_epi32(docs, _mm256_set1_epi32(int32_t(target)));
+
+      *out = target;
+      out += !_mm256_testz_si256(mask, mask);
+      continue;
+    }
+#elif defined(IRESEARCH_SSE2)
+    // skip 4 documents at once while all of them are less than the target,
+    // then compare the target against the next 4 documents
+    for (; block_end - block >= 4 && block[3] < target; block += 4) { }
+
+    if (block_end - block >= 4) {
+      const __m128i docs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+      const __m128i mask = _mm_cmpeq_epi32(docs, _mm_set1_epi32(int32_t(target)));
+
+      *out = target;
+      out += (0 != _mm_movemask_epi8(mask));
+      continue;
+    }
+#endif
+
+    // scalar tail of the block
+    for (; block != block_end && *block < target; ++block) { }
+
+    if (block == block_end) {
+      break; // the rest of candidates is greater than any document of a block
+    }
+
+    *out = target;
+    out += (*block == target);
+  }
+
+  return begin;
+}
+
+} // ROOT
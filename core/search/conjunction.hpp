@@ -76,6 +76,21 @@ struct score_iterator_adapter {
   const irs::score* score{};
 }; // score_iterator_adapter
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief forwards 'doc_iterator::exclude(...)' to every iterator in a range
+/// @return number of iterators which filter masked documents themselves
+////////////////////////////////////////////////////////////////////////////////
+template<typename Iterator>
+size_t exclude_each(Iterator begin, Iterator end, const document_mask& mask) {
+  size_t excluded = 0;
+
+  for (; begin != end; ++begin) {
+    excluded += size_t((*begin)->exclude(mask));
+  }
+
+  return excluded;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @class conjunction
 ///-----------------------------------------------------------------------------
@@ -104,8 +119,9 @@ class conjunction
       : itrs(std::move(itrs)) {
       assert(!this->itrs.empty());
 
-      // sort subnodes in ascending order by their cost
-      std::sort(this->itrs.begin(), this->itrs.end(),
+      // sort subnodes in ascending order by their cost, the first
+      // of equally expensive subnodes leads
+      std::stable_sort(this->itrs.begin(), this->itrs.end(),
         [](const doc_iterator_t& lhs, const doc_iterator_t& rhs) {
           return cost::extract(lhs, cost::MAX) < cost::extract(rhs, cost::MAX);
       });
@@ -152,6 +168,14 @@ class conjunction
     return front_doc_->value;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a conjunction never matches a document skipped by any of
+  ///        sub-iterators
+  //////////////////////////////////////////////////////////////////////////////
+  virtual bool exclude(const document_mask& mask) override {
+    return 0 != exclude_each(itrs_.begin(), itrs_.end(), mask);
+  }
+
   virtual bool next() override {
     if (!front_->next()) {
       return false;
@@ -273,6 +297,211 @@ class conjunction
   order::prepared::merger merger_;
 }; // conjunction
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief intersects sorted candidates [begin, end) with a sorted block of
+///        documents [block, block_end), matched candidates are written to
+///        'out' which must not be located after 'begin'
+/// @returns the first unprocessed candidate, i.e. either 'end' or the first
+///          candidate greater than any document of the block, 'block' is
+///          advanced past the documents less than the processed candidates
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API const doc_id_t* intersect_block(
+  doc_id_t*& out,
+  const doc_id_t* begin,
+  const doc_id_t* end,
+  const doc_id_t*& block,
+  const doc_id_t* block_end) noexcept;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class block_conjunction
+/// @brief unscored conjunction intersecting blocks of documents returned by
+///        'doc_iterator::next_block()' rather than converging iterators one
+///        document at a time, a block of the lead iterator is intersected
+///        with decoded blocks of the other iterators, 'seek(...)' is used only
+///        to jump over the documents which can't match
+/// @note sub-iterators aren't positioned at the current document, hence the
+///       iterator is suitable only if their attributes aren't accessed
+////////////////////////////////////////////////////////////////////////////////
+template<typename DocIterator>
+class block_conjunction : public frozen_attributes<2, doc_iterator> {
+ public:
+  using doc_iterator_t = score_iterator_adapter<DocIterator>;
+  using doc_iterators_t = std::vector<doc_iterator_t>;
+  using doc_iterators = typename conjunction<DocIterator>::doc_iterators;
+
+  explicit block_conjunction(doc_iterators&& itrs)
+    : attributes{{
+        { type<document>::id(), &doc_                              },
+        { type<cost>::id(),     irs::get_mutable<cost>(itrs.front) },
+      }},
+      itrs_(std::move(itrs.itrs)),
+      front_(itrs.front) {
+    assert(itrs_.size() > 1);
+    assert(front_);
+
+    rest_.reserve(itrs_.size() - 1);
+    for (auto it = itrs_.begin() + 1, end = itrs_.end(); it != end; ++it) {
+      rest_.emplace_back(it->it.get());
+    }
+  }
+
+  // size of conjunction
+  size_t size() const noexcept { return itrs_.size(); }
+
+  virtual doc_id_t value() const override final {
+    return doc_.value;
+  }
+
+  virtual bool exclude(const document_mask& mask) override {
+    return 0 != exclude_each(itrs_.begin(), itrs_.end(), mask);
+  }
+
+  virtual bool next() override {
+    if (begin_ != end_) {
+      doc_.value = *begin_++;
+      return true;
+    }
+
+    while (!exhausted_) {
+      const auto block = front_->next_block();
+
+      if (block.empty()) {
+        break;
+      }
+
+      if (refill(block.docs, block.size)) {
+        doc_.value = *begin_++;
+        return true;
+      }
+    }
+
+    doc_.value = doc_limits::eof();
+    return false;
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    if (target <= doc_.value) {
+      return doc_.value;
+    }
+
+    // try matched documents first
+    begin_ = std::lower_bound(begin_, end_, target);
+
+    if (begin_ != end_) {
+      return (doc_.value = *begin_++);
+    }
+
+    if (!exhausted_) {
+      const doc_id_t doc = front_->seek(target);
+
+      if (!doc_limits::eof(doc) && refill(&doc, 1)) {
+        return (doc_.value = *begin_++);
+      }
+
+      if (!doc_limits::eof(doc)) {
+        next();
+        return doc_.value;
+      }
+    }
+
+    return (doc_.value = doc_limits::eof());
+  }
+
+  virtual doc_block next_block() override {
+    if (begin_ == end_) {
+      if (!next()) {
+        return {};
+      }
+
+      --begin_;
+    }
+
+    const doc_block block{ begin_, nullptr, size_t(end_ - begin_) };
+    doc_.value = end_[-1];
+    begin_ = end_;
+
+    return block;
+  }
+
+ private:
+  // decoded documents of a sub-iterator which aren't processed yet
+  struct cursor {
+    explicit cursor(doc_iterator* it) noexcept : it(it) { }
+
+    doc_iterator* it;
+    const doc_id_t* begin{};
+    const doc_id_t* end{};
+    doc_id_t doc{}; // storage for a document returned by 'seek(...)'
+    bool seeked{}; // the rest of a block isn't decoded after 'seek(...)'
+  }; // cursor
+
+  // intersects specified candidates with all sub-iterators except the lead
+  bool refill(const doc_id_t* docs, size_t size) {
+    buf_.assign(docs, docs + size);
+
+    doc_id_t* begin = buf_.data();
+    doc_id_t* end = begin + size;
+
+    for (auto& c : rest_) {
+      if (begin == (end = intersect(c, begin, end))) {
+        break;
+      }
+    }
+
+    begin_ = begin;
+    end_ = end;
+
+    return begin_ != end_;
+  }
+
+  // intersects candidates with a sub-iterator
+  // returns the end of the matched candidates
+  doc_id_t* intersect(cursor& c, doc_id_t* begin, const doc_id_t* end) {
+    doc_id_t* out = begin;
+
+    for (const doc_id_t* it = begin;
+         (it = intersect_block(out, it, end, c.begin, c.end)) != end; ) {
+      // all decoded documents are less than the candidate
+      if (c.seeked) {
+        // decode the rest of the block iterator is positioned at
+        c.seeked = false;
+        const auto block = c.it->next_block();
+
+        if (block.empty()) {
+          exhausted_ = true;
+          break;
+        }
+
+        c.begin = block.docs;
+        c.end = block.docs + block.size;
+      } else {
+        // jump over the documents which can't match
+        c.doc = c.it->seek(*it);
+
+        if (doc_limits::eof(c.doc)) {
+          exhausted_ = true;
+          break;
+        }
+
+        c.begin = &c.doc;
+        c.end = c.begin + 1;
+        c.seeked = true;
+      }
+    }
+
+    return out;
+  }
+
+  document doc_;
+  doc_iterators_t itrs_;
+  std::vector<cursor> rest_;
+  std::vector<doc_id_t> buf_; // matched documents of the current block
+  const doc_id_t* begin_{}; // the next matched document
+  const doc_id_t* end_{}; // the end of matched documents
+  doc_iterator* front_;
+  bool exhausted_{}; // no more documents can be matched
+}; // block_conjunction
+
 //////////////////////////////////////////////////////////////////////////////
 /// @returns conjunction iterator created from the specified sub iterators 
 //////////////////////////////////////////////////////////////////////////////
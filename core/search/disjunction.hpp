@@ -26,6 +26,7 @@
 #include <queue>
 
 #include "conjunction.hpp"
+#include "bitset_doc_iterator.hpp"
 #include "index/iterators.hpp"
 #include "utils/std.hpp"
 #include "utils/type_limits.hpp"
@@ -143,6 +144,42 @@ class score_buffer {
   std::unique_ptr<byte_type[]> buf_;
 }; // score_buffer
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the way scores are accumulated within a score buffer
+////////////////////////////////////////////////////////////////////////////////
+enum class ScoreMerge {
+  NONE,            // no scoring
+  GENERIC,         // via 'order::prepared::merger'
+  FLOAT_AGGREGATE, // flat 'float_t' buffer, '+='
+  FLOAT_MAX        // flat 'float_t' buffer, 'max'
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @returns the way scores denoted by 'merger' can be accumulated, i.e.
+///          orders consisting of a single 'float_t' bucket with default
+///          merge functions are merged directly within a flat 'float_t'
+///          buffer without indirect calls
+////////////////////////////////////////////////////////////////////////////////
+inline ScoreMerge score_merge(
+    const order::prepared& ord,
+    const order::prepared::merger& merger) noexcept {
+  if (ord.empty()) {
+    return ScoreMerge::NONE;
+  }
+
+  if (1 == ord.size() && sizeof(float_t) == ord.score_size()) {
+    if (merger == &score_traits<float_t>::aggregate) {
+      return ScoreMerge::FLOAT_AGGREGATE;
+    }
+
+    if (merger == &score_traits<float_t>::max) {
+      return ScoreMerge::FLOAT_MAX;
+    }
+  }
+
+  return ScoreMerge::GENERIC;
+}
+
 struct empty_score_buffer {
   explicit empty_score_buffer(const order::prepared&, size_t) noexcept { }
 
@@ -191,6 +228,10 @@ class unary_disjunction final : public compound_doc_iterator<Adapter> {
     return it_.doc->value;
   }
 
+  virtual bool exclude(const document_mask& mask) override {
+    return it_->exclude(mask);
+  }
+
   virtual bool next() override {
     return it_->next();
   }
@@ -248,6 +289,17 @@ class basic_disjunction final
     return doc_.value;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a disjunction skips a document only if all of sub-iterators do,
+  ///        the mask is still forwarded to every sub-iterator so that the
+  ///        ones capable of filtering don't return masked documents
+  //////////////////////////////////////////////////////////////////////////////
+  virtual bool exclude(const document_mask& mask) override {
+    const bool lhs = lhs_->exclude(mask);
+    const bool rhs = rhs_->exclude(mask);
+    return lhs && rhs;
+  }
+
   virtual bool next() override {
     next_iterator_impl(lhs_);
     next_iterator_impl(rhs_);
@@ -430,6 +482,10 @@ class small_disjunction final
     return doc_.value;
   }
 
+  virtual bool exclude(const document_mask& mask) override {
+    return itrs_.size() == exclude_each(itrs_.begin(), itrs_.end(), mask);
+  }
+
   bool next_iterator_impl(adapter& it) {
     const auto doc = it.value();
 
@@ -691,6 +747,10 @@ class disjunction final
     return doc_.value;
   }
 
+  virtual bool exclude(const document_mask& mask) override {
+    return itrs_.size() == exclude_each(itrs_.begin(), itrs_.end(), mask);
+  }
+
   virtual bool next() override {
     if (doc_limits::eof(doc_.value)) {
       return false;
@@ -952,6 +1012,8 @@ struct block_disjunction_traits {
 ////////////////////////////////////////////////////////////////////////////////
 /// @class block_disjunction
 /// @brief the implementation reads ahead 64*NumBlocks documents
+/// @note scores of the orders consisting of a single 'float_t' bucket are
+///       accumulated within a flat 'float_t' buffer, see 'score_merge(...)'
 /// @note the implementation isn't optimized for conjunction case
 ///       when the requected min match count equals to a number of input
 ///       iterators. It's better to to use a dedicated "conjunction" iterator.
@@ -1026,6 +1088,10 @@ class block_disjunction final
     return doc_.value;
   }
 
+  virtual bool exclude(const document_mask& mask) override {
+    return itrs_.size() == exclude_each(itrs_.begin(), itrs_.end(), mask);
+  }
+
   virtual bool next() override {
     do {
       while (!cur_) {
@@ -1084,6 +1150,9 @@ class block_disjunction final
 
       doc_base_ = block_base + block_offset * block_size();
       begin_ = mask_ + block_offset + 1;
+      if constexpr (traits_type::min_match() || traits_type::score()) {
+        buf_offset_ = block_offset * block_size();
+      }
 
       assert(begin_ > std::begin(mask_) && begin_ <= std::end(mask_));
       cur_ = begin_[-1] & ((~UINT64_C(0)) << target % block_size());
@@ -1208,7 +1277,8 @@ class block_disjunction final
       cost_(std::forward<Estimation>(estimation)),
       score_buf_(ord, window()),
       match_buf_(min_match_count),
-      merger_(ord.prepare_merger(merge_type)) {
+      merger_(ord.prepare_merger(merge_type)),
+      score_merge_(detail::score_merge(ord, merger_)) {
     if (traits_type::score() && !ord.empty()) {
       score_.reset(this, [](score_ctx* ctx) noexcept -> const byte_type* {
         return static_cast<block_disjunction*>(ctx)->score_value_;
@@ -1305,11 +1375,18 @@ class block_disjunction final
 
         if constexpr (traits_type::score()) {
           if (!it.score->is_default()) {
-            return this->refill<true>(it, empty);
+            switch (score_merge_) {
+              case detail::ScoreMerge::FLOAT_AGGREGATE:
+                return this->refill<detail::ScoreMerge::FLOAT_AGGREGATE>(it, empty);
+              case detail::ScoreMerge::FLOAT_MAX:
+                return this->refill<detail::ScoreMerge::FLOAT_MAX>(it, empty);
+              default:
+                return this->refill<detail::ScoreMerge::GENERIC>(it, empty);
+            }
           }
         }
 
-        return this->refill<false>(it, empty);
+        return this->refill<detail::ScoreMerge::NONE>(it, empty);
       });
     } while (empty && !itrs_.empty());
 
@@ -1334,7 +1411,7 @@ class block_disjunction final
     return true;
   }
 
-  template<bool Score>
+  template<detail::ScoreMerge Merge>
   bool refill(adapter& it, bool& empty) {
     assert(it.doc);
     const auto* doc = &it.doc->value;
@@ -1358,9 +1435,16 @@ class block_disjunction final
 
       irs::set_bit(mask_[offset / block_size()], offset % block_size());
 
-      if constexpr (Score) {
+      if constexpr (detail::ScoreMerge::GENERIC == Merge) {
         assert(it.score);
         merger_(score_buf_.get(offset), it.score->evaluate());
+      } else if constexpr (detail::ScoreMerge::FLOAT_AGGREGATE == Merge) {
+        assert(it.score);
+        float_score_buf()[offset] += sort::score_cast<float_t>(it.score->evaluate());
+      } else if constexpr (detail::ScoreMerge::FLOAT_MAX == Merge) {
+        assert(it.score);
+        auto& dst = float_score_buf()[offset];
+        dst = std::max(dst, sort::score_cast<float_t>(it.score->evaluate()));
       }
 
       if constexpr (traits_type::min_match()) {
@@ -1376,6 +1460,13 @@ class block_disjunction final
     }
   }
 
+  float_t* float_score_buf() noexcept {
+    assert(detail::ScoreMerge::FLOAT_AGGREGATE == score_merge_
+           || detail::ScoreMerge::FLOAT_MAX == score_merge_);
+    assert(sizeof(float_t) == score_buf_.bucket_size());
+    return reinterpret_cast<float_t*>(score_buf_.data());
+  }
+
   doc_iterators_t itrs_;
   uint64_t mask_[num_blocks()]{};
   uint64_t* begin_{std::end(mask_)};
@@ -1392,6 +1483,7 @@ class block_disjunction final
   min_match_buffer_type match_buf_;
   const byte_type* score_value_{score_buf_.data()};
   order::prepared::merger merger_;
+  detail::ScoreMerge score_merge_;
 }; // block_disjunction
 
 template<
@@ -1474,6 +1566,76 @@ doc_iterator::ptr make_disjunction(
     std::forward<Args>(args)...);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @returns true if accumulating documents of 'size' unscored iterators with
+///          the total estimated 'cost' into a bitset of 'docs_count' documents
+///          is cheaper than merging them via 'disjunction_iterator'
+/// @note 'disjunction_iterator' visits every iterator for every window of
+///       documents, while each iterator is visited just once to fill a bitset
+///       which is then scanned word by word
+//////////////////////////////////////////////////////////////////////////////
+inline bool is_bitset_disjunction_cheaper(
+    size_t size,
+    cost::cost_t cost,
+    doc_id_t docs_count) noexcept {
+  using traits_t = block_disjunction_traits<false, MatchType::MATCH, false>;
+
+  constexpr size_t num_blocks = traits_t::num_blocks();
+  constexpr size_t window = bits_required<uint64_t>()*num_blocks;
+
+  if (size <= num_blocks) {
+    // windows are cheaper to scan than the whole bitset
+    return false;
+  }
+
+  const cost::cost_t windows = std::min(cost, cost::cost_t(docs_count / window + 1));
+
+  return size*windows > docs_count / bits_required<bitset::word_t>();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief same as above, but the total cost is evaluated lazily, i.e. only
+///        if the number of iterators allows using a bitset
+//////////////////////////////////////////////////////////////////////////////
+template<typename Estimation,
+         typename = std::enable_if_t<std::is_invocable_r_v<cost::cost_t, Estimation>>>
+bool is_bitset_disjunction_cheaper(
+    size_t size,
+    Estimation&& estimation,
+    doc_id_t docs_count) {
+  using traits_t = block_disjunction_traits<false, MatchType::MATCH, false>;
+
+  return size > traits_t::num_blocks()
+    && is_bitset_disjunction_cheaper(size, estimation(), docs_count);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @returns unscored iterator over the documents of the specified sub
+///          iterators accumulated into a bitset of 'docs_count' documents
+/// @note sub iterators are drained via 'doc_iterator::next_block()'
+//////////////////////////////////////////////////////////////////////////////
+template<typename DocIterators>
+doc_iterator::ptr make_bitset_disjunction(
+    DocIterators&& itrs,
+    doc_id_t docs_count) {
+  if (itrs.empty()) {
+    return doc_iterator::empty();
+  }
+
+  bitset set(doc_limits::min() + docs_count);
+
+  for (auto& it : itrs) {
+    for (auto block = it->next_block(); !block.empty(); block = it->next_block()) {
+      for (auto* doc = block.docs, *end = doc + block.size; doc != end; ++doc) {
+        assert(*doc < set.size());
+        set.set(*doc);
+      }
+    }
+  }
+
+  return memory::make_managed<bitset_doc_iterator>(std::move(set));
+}
+
 } // ROOT
 
 #endif // IRESEARCH_DISJUNCTION_H
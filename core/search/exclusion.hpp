@@ -47,6 +47,11 @@ class exclusion final : public doc_iterator {
     return incl_doc_->value;
   }
 
+  // excluded documents don't matter once the included ones are filtered
+  virtual bool exclude(const document_mask& mask) override {
+    return incl_->exclude(mask);
+  }
+
   virtual bool next() override {
     if (!incl_->next()) {
       return false;
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_MAXSCORE_DISJUNCTION_H
+#define IRESEARCH_MAXSCORE_DISJUNCTION_H
+
+#include "disjunction.hpp"
+
+namespace iresearch {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class maxscore_disjunction
+/// @brief disjunction which skips documents that can't get into the current
+///        top-k result, i.e. whose score is guaranteed to be less than
+///        a 'score_threshold' maintained by a collector (MaxScore algorithm)
+/// @note applicable only for orders supporting score bounds, all sub-iterators
+///       must expose finite non-negative 'score::max', scores are aggregated
+/// ----------------------------------------------------------------------------
+///  Non-essential iterators   Essential iterators
+///   [0]   [1]   [2]        |   [3]    [4]     [5]
+///    ^                     |    ^                    ^
+///    |                     |    |                    |
+///   begin                  |   essential            end
+/// ----------------------------------------------------------------------------
+/// Iterators are sorted by their score upper bounds. The sum of upper bounds of
+/// the non-essential iterators is less than the threshold, therefore only
+/// documents matched by at least one essential iterator are considered as
+/// candidates while non-essential iterators are used for scoring only.
+/// Single term iterators exposing 'block_impact' are additionally bounded by
+/// the maximum term frequency of the postings block containing a candidate,
+/// which allows to reject candidates before they are scored (Block-Max
+/// MaxScore).
+////////////////////////////////////////////////////////////////////////////////
+template<typename DocIterator, typename Adapter = score_iterator_adapter<DocIterator>>
+class maxscore_disjunction final
+    : public frozen_attributes<3, doc_iterator>,
+      private score_ctx {
+ public:
+  using adapter = Adapter;
+  using doc_iterators_t = std::vector<adapter>;
+
+  maxscore_disjunction(
+      doc_iterators_t&& itrs,
+      const order::prepared& ord,
+      const score_threshold& threshold)
+    : attributes{{
+        { type<document>::id(), &doc_   },
+        { type<cost>::id(),     &cost_  },
+        { type<score>::id(),    &score_ },
+      }},
+      itrs_(std::move(itrs)),
+      bounds_(itrs_.size()),
+      blocks_(itrs_.size()),
+      block_bounds_(itrs_.size()),
+      threshold_(&threshold),
+      doc_(itrs_.empty()
+        ? doc_limits::eof()
+        : doc_limits::invalid()),
+      score_(ord),
+      cost_([this](){
+        return std::accumulate(
+          itrs_.begin(), itrs_.end(), cost::cost_t(0),
+          [](cost::cost_t lhs, const adapter& rhs) {
+            return lhs + cost::extract(rhs, 0);
+        });
+      }) {
+    assert(!ord.empty());
+    assert(sizeof(float_t) == ord.score_size());
+
+    // sort sub-iterators in ascending order by their score upper bounds
+    std::sort(
+      itrs_.begin(), itrs_.end(),
+      [](const adapter& lhs, const adapter& rhs) noexcept {
+        return lhs.score->max < rhs.score->max;
+    });
+
+    // precompute cumulative upper bounds
+    float_t bound = 0.f;
+    for (size_t i = 0, size = itrs_.size(); i < size; ++i) {
+      assert(itrs_[i].score);
+      assert(itrs_[i].score->max >= 0.f);
+      assert(itrs_[i].score->max != no_max_score());
+      bounds_[i] = (bound += itrs_[i].score->max);
+
+      if (itrs_[i].score->term) {
+        blocks_[i].impact = irs::get_mutable<block_impact>(&itrs_[i]);
+      }
+    }
+
+    score_.max = bound;
+    score_.reset(this, [](score_ctx* ctx) -> const byte_type* {
+      // score has been already evaluated while looking for the document
+      return static_cast<maxscore_disjunction*>(ctx)->score_.data();
+    });
+  }
+
+  virtual doc_id_t value() const noexcept override {
+    return doc_.value;
+  }
+
+  virtual bool exclude(const document_mask& mask) override {
+    return itrs_.size() == exclude_each(itrs_.begin(), itrs_.end(), mask);
+  }
+
+  virtual bool next() override {
+    if (doc_limits::eof(doc_.value)) {
+      return false;
+    }
+
+    return !doc_limits::eof(find(doc_.value + 1));
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    if (target <= doc_.value) {
+      return doc_.value;
+    }
+
+    return find(target);
+  }
+
+ private:
+  static float_t evaluate(const adapter& it) {
+    return sort::score_cast<float_t>(it.score->evaluate());
+  }
+
+  // upper bound of the score of a specified iterator for a candidate
+  float_t block_max(size_t i, doc_id_t target) {
+    auto& block = blocks_[i];
+    const auto& score = *itrs_[i].score;
+
+    if (!block.impact) {
+      return score.max;
+    }
+
+    if (!(target <= block.last)) {
+      block.last = block.impact->shallow_seek(target);
+      block.max = std::min(score.max, score.term.max_score(block.impact->max_freq));
+    }
+
+    return block.max;
+  }
+
+  // move iterators which can't produce competitive documents on their own
+  // to a non-essential part
+  void update_essential() noexcept {
+    const float_t threshold = threshold_->value;
+
+    while (essential_ < bounds_.size() && bounds_[essential_] < threshold) {
+      ++essential_;
+    }
+  }
+
+  doc_id_t find(doc_id_t target) {
+    for (;;) {
+      update_essential();
+
+      const auto begin = itrs_.begin() + essential_;
+      const auto end = itrs_.end();
+
+      // find the next candidate among the essential iterators
+      doc_id_t min = doc_limits::eof();
+
+      for (auto it = begin; it != end; ++it) {
+        auto doc = it->value();
+
+        if (doc < target) {
+          doc = (*it)->seek(target);
+        }
+
+        min = std::min(min, doc);
+      }
+
+      if (doc_limits::eof(min)) {
+        return doc_.value = doc_limits::eof();
+      }
+
+      // bound the candidate by the blocks containing it
+      const float_t threshold = threshold_->value;
+      float_t bound = 0.f;
+
+      for (size_t i = 0; i < essential_; ++i) {
+        block_bounds_[i] = (bound += block_max(i, min));
+      }
+
+      for (auto it = begin; it != end; ++it) {
+        if (min == it->value()) {
+          bound += block_max(size_t(it - itrs_.begin()), min);
+        }
+      }
+
+      if (bound < threshold) {
+        target = min + 1; // candidate can't get into the top-k result
+        continue;
+      }
+
+      // score the candidate by the essential iterators
+      float_t score = 0.f;
+
+      for (auto it = begin; it != end; ++it) {
+        if (min == it->value()) {
+          score += evaluate(*it);
+        }
+      }
+
+      // add scores of non-essential iterators in descending order of their
+      // upper bounds while the candidate is still competitive
+      size_t i = essential_;
+
+      for (; i && !(score + block_bounds_[i - 1] < threshold); --i) {
+        auto& it = itrs_[i - 1];
+        auto doc = it.value();
+
+        if (doc < min) {
+          doc = it->seek(min);
+        }
+
+        if (min == doc) {
+          score += evaluate(it);
+        }
+      }
+
+      if (!i && !(score < threshold)) {
+        sort::score_cast<float_t>(score_.data()) = score;
+        return doc_.value = min;
+      }
+
+      // candidate can't get into the top-k result
+      target = min + 1;
+    }
+  }
+
+  // upper bound of a sub-iterator within a postings block, see 'block_impact'
+  struct block_bound {
+    block_impact* impact{}; // nullptr if not bounded by blocks
+    doc_id_t last{ doc_limits::invalid() }; // last document of the block
+    float_t max{};
+  };
+
+  doc_iterators_t itrs_;
+  std::vector<float_t> bounds_; // cumulative upper bounds of 'itrs_'
+  std::vector<block_bound> blocks_; // block upper bounds of 'itrs_'
+  std::vector<float_t> block_bounds_; // cumulative block upper bounds of non-essential 'itrs_'
+  const score_threshold* threshold_;
+  size_t essential_{0}; // index of the first essential iterator
+  document doc_;
+  score score_;
+  cost cost_;
+}; // maxscore_disjunction
+
+} // ROOT
+
+#endif // IRESEARCH_MAXSCORE_DISJUNCTION_H
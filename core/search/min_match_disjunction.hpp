@@ -108,6 +108,10 @@ class min_match_disjunction
     return doc_.value;
   }
 
+  virtual bool exclude(const document_mask& mask) override {
+    return itrs_.size() == exclude_each(itrs_.begin(), itrs_.end(), mask);
+  }
+
   virtual bool next() override {
     if (doc_limits::eof(doc_.value)) {
       return false;
@@ -103,6 +103,13 @@ doc_iterator::ptr multiterm_query::execute(
   }
 
   if (ord.empty()) {
+    const doc_id_t docs_count = doc_id_t(segment.docs_count());
+
+    if (is_bitset_disjunction_cheaper(itrs.size(), state->estimation(), docs_count)) {
+      // wide expansions are accumulated into a bitset
+      return make_bitset_disjunction(std::move(itrs), docs_count);
+    }
+
     return make_disjunction<disjunction_t>(
       std::move(itrs), ord, merge_type_, state->estimation());
   }
@@ -104,6 +104,10 @@ class ngram_similarity_doc_iterator final
     return doc_->value;
   }
 
+  virtual bool exclude(const document_mask& mask) override {
+    return approx_.exclude(mask);
+  }
+
   virtual doc_id_t seek(doc_id_t target) override {
     if (doc_->value >= target) {
       return doc_->value;
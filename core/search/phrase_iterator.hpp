@@ -473,6 +473,10 @@ class phrase_iterator final : public doc_iterator {
     return doc_->value;
   }
 
+  virtual bool exclude(const document_mask& mask) override {
+    return approx_.exclude(mask);
+  }
+
   virtual bool next() override {
     bool next = false;
     while ((next = approx_.next()) && !freq_()) {}
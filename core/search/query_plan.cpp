@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#include "query_plan.hpp"
+#include "shared.hpp"
+
+namespace iresearch {
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                       query_plan
+// ----------------------------------------------------------------------------
+
+REGISTER_ATTRIBUTE(query_plan);
+
+std::string query_plan::to_string() const {
+  std::string str;
+
+  for (auto& step : steps_) {
+    str.append(2*step.level, ' ');
+    str.append(step.description);
+    str.push_back('\n');
+  }
+
+  return str;
+}
+
+} // ROOT
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_QUERY_PLAN_H
+#define IRESEARCH_QUERY_PLAN_H
+
+#include <string>
+#include <vector>
+
+#include "utils/attributes.hpp"
+#include "utils/noncopyable.hpp"
+
+namespace iresearch {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class query_plan
+/// @brief human readable description of the plans chosen by the queries, i.e.
+///        the rewrites applied by 'filter::prepare(...)' and the iterators
+///        picked by 'filter::prepared::execute(...)' for a segment
+/// @note filled in only if provided via the context of the calls above
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API query_plan final : attribute {
+  //////////////////////////////////////////////////////////////////////////////
+  /// @class scope
+  /// @brief steps added within a scope are nested into the preceding step
+  //////////////////////////////////////////////////////////////////////////////
+  class scope : private util::noncopyable {
+   public:
+    explicit scope(query_plan* plan) noexcept
+      : plan_(plan) {
+      if (plan_) {
+        ++plan_->level_;
+      }
+    }
+
+    ~scope() {
+      if (plan_) {
+        --plan_->level_;
+      }
+    }
+
+   private:
+    query_plan* plan_;
+  }; // scope
+
+  struct step {
+    size_t level; // nesting level
+    std::string description;
+  }; // step
+
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::query_plan";
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief adds a step at the current nesting level
+  /// @returns index of the added step, so that its description can be
+  ///          amended once a decision is made
+  //////////////////////////////////////////////////////////////////////////////
+  size_t add(std::string&& description = {}) {
+    steps_.push_back({ level_, std::move(description) });
+    return steps_.size() - 1;
+  }
+
+  std::string& operator[](size_t i) noexcept {
+    assert(i < steps_.size());
+    return steps_[i].description;
+  }
+
+  const std::vector<step>& steps() const noexcept {
+    return steps_;
+  }
+
+  void clear() noexcept {
+    steps_.clear();
+    level_ = 0;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns steps, one per line, indented according to their nesting level
+  //////////////////////////////////////////////////////////////////////////////
+  std::string to_string() const;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::vector<step> steps_;
+  size_t level_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // query_plan
+
+}
+
+#endif // IRESEARCH_QUERY_PLAN_H
@@ -41,6 +41,9 @@ namespace iresearch {
 // --SECTION--                                                            score
 // ----------------------------------------------------------------------------
 
+REGISTER_ATTRIBUTE(score_threshold);
+REGISTER_ATTRIBUTE(block_impact);
+
 /*static*/ const irs::score& score::no_score() noexcept {
   return EMPTY_SCORE;
 }
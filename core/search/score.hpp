@@ -25,6 +25,7 @@
 
 #include "sort.hpp"
 #include "utils/attributes.hpp"
+#include "utils/type_limits.hpp"
 
 namespace iresearch {
 
@@ -65,6 +66,7 @@ class IRESEARCH_API score : public attribute {
     assert(score.func_);
     func_.reset(const_cast<score_ctx*>(score.func_.ctx()),
                 score.func_.func());
+    max = score.max;
   }
 
   void reset(std::unique_ptr<score_ctx>&& ctx, const score_f func) noexcept {
@@ -100,6 +102,37 @@ class IRESEARCH_API score : public attribute {
     std::memset(const_cast<byte_type*>(buf_.data()), 0, buf_.size());
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief upper bound of the scores produced for the documents of an
+  ///        iterator, see 'order::prepared::max_score(...)'
+  //////////////////////////////////////////////////////////////////////////////
+  float_t max{ no_max_score() };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief arguments the scorers of a single term iterator were prepared
+  ///        with, allow to evaluate the scores of blocks of documents via
+  ///        'order::prepared::score_block(...)' and to bound the scores of
+  ///        postings blocks, see 'block_impact'
+  /// @note set by 'term_query' only, empty for the other iterators
+  //////////////////////////////////////////////////////////////////////////////
+  struct term_args {
+    explicit operator bool() const noexcept { return nullptr != ord; }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @returns upper bound of the scores of the documents with a term
+    ///          frequency not greater than 'max_freq'
+    ////////////////////////////////////////////////////////////////////////////
+    float_t max_score(uint32_t max_freq) const {
+      assert(ord);
+      return ord->max_score(stats, boost, max_freq);
+    }
+
+    const order::prepared* ord{};
+    const byte_type* stats{};
+    const term_reader* field{};
+    boost_t boost{ no_boost() };
+  } term;
+
  private:
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
   bstring buf_;
@@ -109,6 +142,50 @@ class IRESEARCH_API score : public attribute {
   IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // score
 
+////////////////////////////////////////////////////////////////////////////////
+/// @class score_threshold
+/// @brief a score which a document has to reach in order to get into the
+///        current top-k result, provided by top-k collectors via the context of
+///        'filter::prepared::execute(...)' and raised as collection progresses
+/// @note iterators may skip documents which scores are guaranteed to be less
+///       than the threshold, i.e. whose 'score::max' is below the threshold
+/// @note meaningful only if 'order::prepared::max_score(...)' is supported
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API score_threshold final : attribute {
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::score_threshold";
+  }
+
+  float_t value{ 0.f };
+}; // score_threshold
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class block_impact
+/// @brief per-block impact metadata of a postings list, i.e. the maximum term
+///        frequency within a block of documents, allows to evaluate block-level
+///        score upper bounds via 'order::prepared::max_score(...)' and to skip
+///        blocks which can't get into the current top-k result
+////////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API block_impact : attribute {
+  static constexpr string_ref type_name() noexcept {
+    return "iresearch::block_impact";
+  }
+
+  virtual ~block_impact() = default;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief moves to the block containing a specified target without
+  ///        advancing the underlying iterator and updates 'doc' and 'max_freq'
+  /// @note targets must not decrease between the subsequent calls
+  /// @returns the last document of the block, 'doc_limits::eof()' if the block
+  ///          is the last one
+  //////////////////////////////////////////////////////////////////////////////
+  virtual doc_id_t shallow_seek(doc_id_t target) = 0;
+
+  doc_id_t doc{ doc_limits::invalid() }; // last document of the current block
+  uint32_t max_freq{ no_max_freq() }; // max term frequency in the current block
+}; // block_impact
+
 IRESEARCH_API void reset(
   irs::score& score, order::prepared::scorers&& scorers);
 
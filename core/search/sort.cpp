@@ -228,6 +228,40 @@ void order::prepared::prepare_collectors(
   }
 }
 
+float_t order::prepared::max_score(
+    const byte_type* stats_buf,
+    boost_t boost,
+    uint32_t max_freq) const {
+  if (1 != order_.size() || !order_.front().reverse) {
+    return no_max_score();
+  }
+
+  auto& entry = order_.front();
+  assert(entry.bucket); // ensured by order::prepared
+  assert(stats_buf);
+
+  return entry.bucket->max_score(stats_buf + entry.stats_offset, boost, max_freq);
+}
+
+bool order::prepared::score_block(
+    const byte_type* stats_buf,
+    boost_t boost,
+    const uint32_t* freqs,
+    const float_t* norms,
+    float_t* scores,
+    size_t count) const {
+  if (1 != order_.size()) {
+    return false;
+  }
+
+  auto& entry = order_.front();
+  assert(entry.bucket); // ensured by order::prepared
+  assert(stats_buf);
+
+  return entry.bucket->score_block(stats_buf + entry.stats_offset, boost,
+                                   freqs, norms, scores, count);
+}
+
 bool order::prepared::less(const byte_type* lhs, const byte_type* rhs) const {
   if (!lhs) {
     return rhs != nullptr; // lhs(nullptr) == rhs(nullptr)
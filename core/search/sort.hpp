@@ -24,6 +24,7 @@
 #ifndef IRESEARCH_SORT_H
 #define IRESEARCH_SORT_H
 
+#include <limits>
 #include <vector>
 
 #include "utils/attributes.hpp"
@@ -45,6 +46,20 @@ struct term_reader;
 //////////////////////////////////////////////////////////////////////////////
 constexpr boost_t no_boost() noexcept { return 1.f; }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief represents unknown upper bound of a score
+//////////////////////////////////////////////////////////////////////////////
+constexpr float_t no_max_score() noexcept {
+  return std::numeric_limits<float_t>::max();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief represents unknown upper bound of a term frequency
+//////////////////////////////////////////////////////////////////////////////
+constexpr uint32_t no_max_freq() noexcept {
+  return std::numeric_limits<uint32_t>::max();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class filter_boost
 /// @brief represents an addition to score from filter specific to a particular
@@ -391,6 +406,43 @@ class IRESEARCH_API sort {
     ////////////////////////////////////////////////////////////////////////////
     virtual term_collector::ptr prepare_term_collector() const = 0;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief evaluate an upper bound of the scores produced by the scorer
+    ///        returned from 'prepare_scorer(...)' for the same 'stats' and
+    ///        'boost' given that a term frequency never exceeds 'max_freq'
+    /// @note the bound is meaningful for the scorers with 'float_t' scores only
+    /// @return 'no_max_score()' if the scores can't be bounded
+    ////////////////////////////////////////////////////////////////////////////
+    virtual float_t max_score(
+        const byte_type* /*stats*/,
+        boost_t /*boost*/,
+        uint32_t /*max_freq*/) const {
+      return no_max_score();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief evaluate the scores of a block of documents at once, i.e. the
+    ///        scores produced by the scorer returned from 'prepare_scorer(...)'
+    ///        for the same 'stats' and 'boost' without per-document calls
+    /// @param freqs term frequencies of the documents, nullptr if there are no
+    ///        frequencies for a field
+    /// @param norms length norms of the documents, nullptr if there are no
+    ///        norms for a field
+    /// @param scores 'count' evaluated scores
+    /// @note the block is meaningful for the scorers with 'float_t' scores only,
+    ///       'filter_boost' of the documents isn't taken into account
+    /// @return false if block scoring isn't supported
+    ////////////////////////////////////////////////////////////////////////////
+    virtual bool score_block(
+        const byte_type* /*stats*/,
+        boost_t /*boost*/,
+        const uint32_t* /*freqs*/,
+        const float_t* /*norms*/,
+        float_t* /*scores*/,
+        size_t /*count*/) const {
+      return false;
+    }
+
     ////////////////////////////////////////////////////////////////////////////////
     /// @brief compare two score containers and determine if 'lhs' < 'rhs', i.e. <
     ////////////////////////////////////////////////////////////////////////////////
@@ -1041,6 +1093,34 @@ class IRESEARCH_API order final {
     bool less(const byte_type* lhs, const byte_type* rhs) const;
     void add(byte_type* lhs, const byte_type* rhs) const;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief evaluate an upper bound of the scores produced for a term
+    ///        denoted by 'stats' which frequency never exceeds 'max_freq'
+    /// @note bounds are supported only for the orders consisting of a single
+    ///       descending bucket, i.e. where the top documents are ones with
+    ///       the highest scores
+    /// @return 'no_max_score()' if the scores can't be bounded
+    ////////////////////////////////////////////////////////////////////////////
+    float_t max_score(
+      const byte_type* stats,
+      boost_t boost,
+      uint32_t max_freq = no_max_freq()) const;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief evaluate the scores of a block of documents matching a term
+    ///        denoted by 'stats', see 'sort::prepared::score_block(...)'
+    /// @note block scoring is supported only for the orders consisting of a
+    ///       single bucket
+    /// @return false if block scoring isn't supported
+    ////////////////////////////////////////////////////////////////////////////
+    bool score_block(
+      const byte_type* stats,
+      boost_t boost,
+      const uint32_t* freqs,
+      const float_t* norms,
+      float_t* scores,
+      size_t count) const;
+
     template<typename T>
     constexpr const T& get(const byte_type* score, size_t i) const noexcept {
       // MacOS can't handle asserts in non-debug constexpr functions
@@ -22,6 +22,7 @@
 
 #include "term_query.hpp"
 
+#include "analysis/token_attributes.hpp"
 #include "index/index_reader.hpp"
 #include "search/score.hpp"
 
@@ -78,6 +79,13 @@ doc_iterator::ptr term_query::execute(
         *docs, boost());
 
       irs::reset(*score, std::move(scorers));
+
+      // total term frequency bounds term frequency in any document
+      const auto* term_freq = irs::get<frequency>(*terms);
+      score->max = ord.max_score(
+        stats_.c_str(), boost(),
+        term_freq ? term_freq->value : no_max_freq());
+      score->term = { &ord, stats_.c_str(), state->reader, boost() };
     }
   }
 
@@ -30,10 +30,89 @@
 #include "index/field_meta.hpp"
 #include "utils/math_utils.hpp"
 
+#if defined(IRESEARCH_AVX2)
+#include <immintrin.h>
+#elif defined(IRESEARCH_SSE2)
+#include <emmintrin.h>
+#endif
+
 namespace {
 
 const irs::math::sqrt<uint32_t, float_t, 1024> SQRT;
 
+#if defined(IRESEARCH_AVX2)
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts unsigned 32-bit integers to floats the same way as a scalar
+///        conversion does, '_mm256_cvtepi32_ps' treats the lanes as signed
+////////////////////////////////////////////////////////////////////////////////
+FORCE_INLINE __m256 cvtepu32_ps(__m256i v) noexcept {
+  const __m256 hi = _mm256_cvtepi32_ps(_mm256_srli_epi32(v, 16));
+  const __m256 lo = _mm256_cvtepi32_ps(_mm256_and_si256(v, _mm256_set1_epi32(0xFFFF)));
+
+  // 'hi * 2^16' and 'lo' are exact, the sum is rounded once
+  return _mm256_add_ps(_mm256_mul_ps(hi, _mm256_set1_ps(65536.f)), lo);
+}
+#elif defined(IRESEARCH_SSE2)
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts unsigned 32-bit integers to floats the same way as a scalar
+///        conversion does, '_mm_cvtepi32_ps' treats the lanes as signed
+////////////////////////////////////////////////////////////////////////////////
+FORCE_INLINE __m128 cvtepu32_ps(__m128i v) noexcept {
+  const __m128 hi = _mm_cvtepi32_ps(_mm_srli_epi32(v, 16));
+  const __m128 lo = _mm_cvtepi32_ps(_mm_and_si128(v, _mm_set1_epi32(0xFFFF)));
+
+  // 'hi * 2^16' and 'lo' are exact, the sum is rounded once
+  return _mm_add_ps(_mm_mul_ps(hi, _mm_set1_ps(65536.f)), lo);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluates 'idf * sqrt(freq) * norm' for a block of documents,
+///        'norms == nullptr' stands for no normalization
+////////////////////////////////////////////////////////////////////////////////
+void score_block(
+    float_t idf,
+    const uint32_t* RESTRICT freqs,
+    const float_t* RESTRICT norms,
+    float_t* RESTRICT scores,
+    size_t count) noexcept {
+  size_t i = 0;
+
+#if defined(IRESEARCH_AVX2)
+  const __m256 vidf = _mm256_set1_ps(idf);
+
+  for (; i + 8 <= count; i += 8) {
+    __m256 score = _mm256_mul_ps(vidf, _mm256_sqrt_ps(cvtepu32_ps(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(freqs + i)))));
+
+    if (norms) {
+      score = _mm256_mul_ps(score, _mm256_loadu_ps(norms + i));
+    }
+
+    _mm256_storeu_ps(scores + i, score);
+  }
+#elif defined(IRESEARCH_SSE2)
+  const __m128 vidf = _mm_set1_ps(idf);
+
+  for (; i + 4 <= count; i += 4) {
+    __m128 score = _mm_mul_ps(vidf, _mm_sqrt_ps(cvtepu32_ps(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(freqs + i)))));
+
+    if (norms) {
+      score = _mm_mul_ps(score, _mm_loadu_ps(norms + i));
+    }
+
+    _mm_storeu_ps(scores + i, score);
+  }
+#endif
+
+  // remaining documents
+  for (; i < count; ++i) {
+    const float_t score = idf * SQRT(freqs[i]);
+    scores[i] = norms ? score * norms[i] : score;
+  }
+}
+
 irs::sort::ptr make_from_bool(
     const rapidjson::Document& json,
     const irs::string_ref& //args
@@ -431,6 +510,51 @@ class sort final: public irs::prepared_sort_basic<tfidf::score_t, tfidf::idf> {
     return irs::memory::make_unique<term_collector>();
   }
 
+  virtual float_t max_score(
+      const byte_type* stats_buf,
+      boost_t boost,
+      uint32_t max_freq) const override {
+    if (boost < 0.f || max_freq == no_max_freq()) {
+      // tf-idf isn't bounded for unbounded term frequency
+      return no_max_score();
+    }
+
+    auto& stats = stats_cast(stats_buf);
+
+    // norm is '1 / sqrt(# of terms)' and never exceeds 1
+    const float_t max = ::tfidf(max_freq, boost * stats.value);
+
+    // documents without frequency get 'boost' as a score
+    return boost_as_score_ ? std::max(max, boost) : max;
+  }
+
+  virtual bool score_block(
+      const byte_type* stats_buf,
+      boost_t boost,
+      const uint32_t* freqs,
+      const float_t* norms,
+      float_t* scores,
+      size_t count) const override {
+    assert(scores);
+
+    if (!freqs) {
+      if (!boost_as_score_ || 0.f == boost) {
+        return false; // documents aren't scored, see 'prepare_scorer(...)'
+      }
+
+      // if there is no frequency then all the scores are the same
+      std::fill_n(scores, count, boost);
+
+      return true;
+    }
+
+    auto& stats = stats_cast(stats_buf);
+    ::score_block(boost * stats.value, freqs, normalize_ ? norms : nullptr,
+                  scores, count);
+
+    return true;
+  }
+
  private:
   bool normalize_;
   bool boost_as_score_;
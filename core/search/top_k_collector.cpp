@@ -0,0 +1,452 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#include "top_k_collector.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#include "analysis/token_attributes.hpp"
+#include "index/field_meta.hpp"
+#include "index/index_reader.hpp"
+#include "utils/async_utils.hpp"
+#include "utils/thread_utils.hpp"
+
+namespace {
+
+using namespace irs;
+
+// min-heap comparator, the worst document is on top
+inline bool less(
+    const top_k_collector::entry& lhs,
+    const top_k_collector::entry& rhs) noexcept {
+  return lhs.score > rhs.score;
+}
+
+}
+
+namespace iresearch {
+
+top_k_collector::top_k_collector(size_t k)
+  : k_(k) {
+  heap_.reserve(k_);
+}
+
+void top_k_collector::clear() noexcept {
+  heap_.clear();
+  threshold_.value = 0.f;
+  hits_ = 0;
+  raised_ = false;
+}
+
+void top_k_collector::collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    const order::prepared& ord) {
+  for (auto& segment : index) {
+    collect(segment, filter, ord);
+  }
+}
+
+void top_k_collector::collect(
+    const sub_reader& segment,
+    const filter::prepared& filter,
+    const order::prepared& ord) {
+  collect(segment, filter, ord, doc_limits::min(), doc_limits::eof());
+}
+
+void top_k_collector::collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    const order::prepared& ord,
+    async_utils::thread_pool& pool,
+    size_t max_range_docs /*= 0*/) {
+  if (!k_) {
+    return;
+  }
+
+  struct range {
+    const sub_reader* segment;
+    doc_id_t min;
+    doc_id_t max;
+  };
+
+  std::vector<range> ranges;
+  ranges.reserve(index.size());
+
+  for (auto& segment : index) {
+    const doc_id_t last = doc_id_t(doc_limits::min() + segment.docs_count() - 1);
+
+    if (!max_range_docs || segment.docs_count() <= max_range_docs) {
+      ranges.push_back({ &segment, doc_limits::min(), doc_limits::eof() });
+      continue;
+    }
+
+    for (doc_id_t min = doc_limits::min(); min <= last; ) {
+      const doc_id_t max = doc_id_t(std::min<size_t>(min + max_range_docs - 1, last));
+      ranges.push_back({ &segment, min, max == last ? doc_limits::eof() : max });
+
+      if (max == last) {
+        break;
+      }
+
+      min = max + 1;
+    }
+  }
+
+  if (ranges.empty()) {
+    return;
+  }
+
+  // state is shared with the pool tasks which may start after all ranges
+  // are processed by the other workers
+  struct state {
+    explicit state(std::vector<range>&& ranges, float_t threshold)
+      : ranges(std::move(ranges)),
+        pending(this->ranges.size()),
+        threshold(threshold) {
+    }
+
+    std::vector<range> ranges;
+    std::deque<top_k_collector> collectors; // address stable
+    std::atomic<size_t> next{ 0 };
+    std::mutex mutex;
+    std::condition_variable finished;
+    size_t pending;
+    std::exception_ptr error;
+    std::atomic<float_t> threshold; // shared between workers
+  };
+
+  // the threshold of the current result is a lower bound for the workers
+  auto shared = std::make_shared<state>(
+    std::move(ranges), full() ? threshold_.value : 0.f);
+
+  for (size_t i = 0, size = shared->ranges.size(); i < size; ++i) {
+    shared->collectors.emplace_back(k_).shared_ = &shared->threshold;
+  }
+
+  // 'filter' and 'ord' are accessed only while there are pending ranges
+  auto worker = [shared, &filter, &ord]() noexcept {
+    const size_t size = shared->ranges.size();
+
+    for (size_t i; (i = shared->next++) < size; ) {
+      try {
+        auto& r = shared->ranges[i];
+        shared->collectors[i].collect(*r.segment, filter, ord, r.min, r.max);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        if (!shared->error) {
+          shared->error = std::current_exception();
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(shared->mutex);
+      if (!--shared->pending) {
+        shared->finished.notify_one();
+      }
+    }
+  };
+
+  // current thread is a worker as well
+  for (size_t i = 1, size = std::min(shared->ranges.size(), pool.max_threads());
+       i < size && pool.run(worker); ++i) {
+  }
+  worker();
+
+  {
+    auto lock = make_unique_lock(shared->mutex);
+    shared->finished.wait(lock, [&shared]() noexcept { return !shared->pending; });
+  }
+
+  if (shared->error) {
+    std::rethrow_exception(shared->error);
+  }
+
+  // merge results in order of ranges
+  for (auto& collector : shared->collectors) {
+    hits_ += collector.hits_;
+
+    for (auto& entry : collector.heap_) {
+      if (!full()) {
+        push(*entry.segment, entry.doc, entry.score);
+      } else if (threshold_.value < entry.score) {
+        std::pop_heap(heap_.begin(), heap_.end(), &::less);
+        heap_.back() = entry;
+        std::push_heap(heap_.begin(), heap_.end(), &::less);
+        update_threshold();
+      }
+    }
+  }
+}
+
+void top_k_collector::collect(
+    const sub_reader& segment,
+    const filter::prepared& filter,
+    const order::prepared& ord,
+    doc_id_t min, doc_id_t max) {
+  if (!k_) {
+    return;
+  }
+
+  assert(ord.empty() || sizeof(float_t) == ord.score_size());
+
+  auto docs = segment.mask(filter.execute(segment, ord, &ctx_));
+  assert(docs);
+
+  const auto* doc = irs::get<document>(*docs);
+  assert(doc);
+
+  // moves iterator to the next document within the range
+  auto next = [&docs, doc, min, max]() {
+    const bool valid = doc_limits::valid(doc->value) || doc_limits::min() == min
+      ? docs->next()
+      : !doc_limits::eof(docs->seek(min));
+
+    return valid && doc->value <= max;
+  };
+
+  if (ord.empty()) {
+    // all documents have the same score, nothing can beat the collected ones
+    for (; !full() && next(); ++hits_) {
+      push(segment, doc->value, 0.f);
+    }
+
+    return;
+  }
+
+  const auto& score = irs::score::get(*docs);
+
+  if (shared_) {
+    sync_threshold();
+  }
+
+  // iterator can't produce documents better than the collected ones
+  if (!competitive(score.max)) {
+    return;
+  }
+
+  if (score.term && collect_blocks(segment, *docs, score, min, max)) {
+    return;
+  }
+
+  // the scoring function is resolved once per segment, every document
+  // is evaluated by a single indirect call without virtual dispatch
+  while (next()) {
+    ++hits_;
+
+    const float_t value = sort::score_cast<float_t>(score.evaluate());
+
+    if (shared_) {
+      sync_threshold();
+    }
+
+    if (!competitive(value)) {
+      continue;
+    }
+
+    if (!full()) {
+      push(segment, doc->value, value);
+    } else {
+      std::pop_heap(heap_.begin(), heap_.end(), &::less);
+      heap_.back() = entry(segment, doc->value, value);
+      std::push_heap(heap_.begin(), heap_.end(), &::less);
+      update_threshold();
+    }
+
+    if (!competitive(score.max)) {
+      break; // remaining documents can't get into the result
+    }
+  }
+}
+
+bool top_k_collector::collect_blocks(
+    const sub_reader& segment,
+    doc_iterator& docs,
+    const score& score,
+    doc_id_t min, doc_id_t max) {
+  const auto& term = score.term;
+  assert(term && term.field);
+  const auto& ord = *term.ord;
+  const auto* doc = irs::get<document>(docs);
+  const auto* freq = irs::get<frequency>(docs);
+  float_t value;
+
+  // the order has to support block scoring for the term, probe it with an
+  // empty block before any document is consumed
+  if (!doc || !freq
+      || !ord.score_block(term.stats, term.boost, &freq->value, nullptr, &value, 0)) {
+    return false;
+  }
+
+  // length norms are read for the documents of a block at once
+  irs::document norm_doc;
+  irs::norm norm;
+  const bool has_norms = norm.reset(segment, term.field->meta().norm, norm_doc);
+  std::vector<float_t> norms;
+  std::vector<float_t> scores;
+
+  // scores documents within the range and collects the competitive ones
+  auto collect_docs = [&](const doc_id_t* ids, const uint32_t* freqs, size_t count) {
+    count = size_t(std::upper_bound(ids, ids + count, max) - ids);
+
+    if (!count) {
+      return;
+    }
+
+    if (has_norms) {
+      norms.resize(count);
+
+      for (size_t i = 0; i < count; ++i) {
+        norm_doc.value = ids[i];
+        norms[i] = norm.read();
+      }
+    }
+
+    scores.resize(count);
+    ord.score_block(term.stats, term.boost, freqs,
+                    has_norms ? norms.data() : nullptr, scores.data(), count);
+    hits_ += count;
+
+    if (shared_) {
+      sync_threshold();
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      if (!competitive(scores[i])) {
+        continue;
+      }
+
+      if (!full()) {
+        push(segment, ids[i], scores[i]);
+      } else {
+        std::pop_heap(heap_.begin(), heap_.end(), &::less);
+        heap_.back() = entry(segment, ids[i], scores[i]);
+        std::push_heap(heap_.begin(), heap_.end(), &::less);
+        update_threshold();
+      }
+    }
+  };
+
+  if (doc_limits::min() != min) {
+    if (doc_limits::eof(docs.seek(min))) {
+      return true;
+    }
+
+    collect_docs(&doc->value, &freq->value, 1);
+  }
+
+  // per-block upper bounds of the term frequency, if provided by the postings
+  auto* impact = irs::get_mutable<block_impact>(&docs);
+
+  while (doc->value < max && competitive(score.max)) {
+    if (impact && (full() || raised_)) {
+      // skip postings blocks whose best document can't get into the result
+      const doc_id_t last = impact->shallow_seek(doc->value + 1);
+
+      if (!competitive(term.max_score(impact->max_freq))) {
+        if (doc_limits::eof(last) || last >= max
+            || doc_limits::eof(docs.seek(last + 1))) {
+          break;
+        }
+
+        collect_docs(&doc->value, &freq->value, 1);
+        continue;
+      }
+    }
+
+    const auto block = docs.next_block();
+
+    if (block.empty()) {
+      break;
+    }
+
+    assert(block.freqs);
+    collect_docs(block.docs, block.freqs, block.size);
+  }
+
+  return true;
+}
+
+void top_k_collector::push(
+    const sub_reader& segment,
+    doc_id_t doc,
+    float_t score) {
+  assert(!full());
+
+  heap_.emplace_back(segment, doc, score);
+  std::push_heap(heap_.begin(), heap_.end(), &::less);
+
+  if (full()) {
+    update_threshold();
+  }
+}
+
+void top_k_collector::update_threshold() noexcept {
+  assert(full());
+  const float_t score = heap_.front().score;
+
+  if (raised_ && !(threshold_.value < score)) {
+    return; // shared threshold is still better
+  }
+
+  threshold_.value = score;
+
+  if (shared_) {
+    // publish the threshold to the other workers
+    auto current = shared_->load(std::memory_order_relaxed);
+    while (current < score
+           && !shared_->compare_exchange_weak(current, score,
+                                              std::memory_order_relaxed)) { }
+  }
+}
+
+void top_k_collector::sync_threshold() noexcept {
+  assert(shared_);
+  const float_t score = shared_->load(std::memory_order_relaxed);
+
+  if (threshold_.value < score) {
+    threshold_.value = score;
+    raised_ = true;
+  }
+}
+
+std::vector<top_k_collector::entry> top_k_collector::top() const {
+  std::vector<entry> top = heap_;
+
+  std::sort(
+    top.begin(), top.end(),
+    [](const entry& lhs, const entry& rhs) noexcept {
+      if (lhs.score != rhs.score) {
+        return lhs.score > rhs.score;
+      }
+
+      return lhs.doc < rhs.doc;
+  });
+
+  return top;
+}
+
+} // ROOT
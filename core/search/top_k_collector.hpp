@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_TOP_K_COLLECTOR_H
+#define IRESEARCH_TOP_K_COLLECTOR_H
+
+#include <atomic>
+#include <vector>
+
+#include "shared.hpp"
+#include "filter.hpp"
+#include "score.hpp"
+#include "utils/noncopyable.hpp"
+
+namespace iresearch {
+
+struct index_reader;
+struct sub_reader;
+
+namespace async_utils {
+class thread_pool;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class top_k_collector
+/// @brief collects 'k' best scored documents matched by a filter, documents
+///        are ranked by a single 'float_t' score in descending order
+/// @note the score of the worst collected document is exposed to iterators
+///       as 'score_threshold' via the context of 'filter::prepared::execute'
+///       once 'k' documents are collected, which allows them to skip
+///       documents that can't get into the result
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API top_k_collector : private util::noncopyable {
+ public:
+  struct entry {
+    entry(const sub_reader& segment, doc_id_t doc, float_t score) noexcept
+      : segment(&segment), doc(doc), score(score) {
+    }
+
+    const sub_reader* segment;
+    doc_id_t doc;
+    float_t score;
+  }; // entry
+
+  explicit top_k_collector(size_t k);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects documents matched by a specified filter in every segment
+  ///        of a specified index
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    const order::prepared& ord);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects documents matched by a specified filter in a specified
+  ///        segment
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(
+    const sub_reader& segment,
+    const filter::prepared& filter,
+    const order::prepared& ord);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects documents matched by a specified filter in every segment
+  ///        of a specified index using a specified thread pool, segments
+  ///        with more than 'max_range_docs' documents are split into
+  ///        document ranges processed independently (0 - don't split)
+  /// @note workers share the best known threshold, so the ranges processed
+  ///       later are able to skip documents that can't get into the result
+  /// @note the result may differ from the sequential one only in the order of
+  ///       documents with equal scores, blocks until all ranges are processed
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(
+    const index_reader& index,
+    const filter::prepared& filter,
+    const order::prepared& ord,
+    async_utils::thread_pool& pool,
+    size_t max_range_docs = 0);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns collected documents ordered by score in descending order,
+  ///          documents with equal scores are ordered by id
+  //////////////////////////////////////////////////////////////////////////////
+  std::vector<entry> top() const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns number of evaluated documents
+  /// @note documents skipped by iterators due to the threshold aren't counted
+  //////////////////////////////////////////////////////////////////////////////
+  size_t hits() const noexcept { return hits_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns the score a document has to exceed in order to get into the
+  ///          result, 0 until 'k' documents are collected
+  //////////////////////////////////////////////////////////////////////////////
+  float_t threshold() const noexcept { return threshold_.value; }
+
+  size_t k() const noexcept { return k_; }
+  size_t size() const noexcept { return heap_.size(); }
+  bool full() const noexcept { return heap_.size() == k_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief resets collector to the initial state
+  //////////////////////////////////////////////////////////////////////////////
+  void clear() noexcept;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief exposes current threshold to the iterators
+  //////////////////////////////////////////////////////////////////////////////
+  struct context final : attribute_provider {
+    explicit context(score_threshold& threshold) noexcept
+      : threshold(&threshold) {
+    }
+
+    virtual attribute* get_mutable(type_info::type_id id) noexcept override {
+      return type<score_threshold>::id() == id ? threshold : nullptr;
+    }
+
+    score_threshold* threshold;
+  }; // context
+
+  void collect(
+    const sub_reader& segment,
+    const filter::prepared& filter,
+    const order::prepared& ord,
+    doc_id_t min, doc_id_t max);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects documents of a single term iterator by blocks, i.e.
+  ///        scores every block returned by 'doc_iterator::next_block()' via
+  ///        'order::prepared::score_block(...)', postings blocks which can't
+  ///        get into the result according to 'block_impact' are skipped
+  /// @return false if block scoring isn't supported for the iterator
+  //////////////////////////////////////////////////////////////////////////////
+  bool collect_blocks(
+    const sub_reader& segment,
+    doc_iterator& docs,
+    const score& score,
+    doc_id_t min, doc_id_t max);
+
+  // a score that can get into the result
+  bool competitive(float_t score) const noexcept {
+    return !(full() || raised_) || threshold_.value < score;
+  }
+
+  void push(const sub_reader& segment, doc_id_t doc, float_t score);
+  void update_threshold() noexcept;
+  void sync_threshold() noexcept;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::vector<entry> heap_; // min-heap by score
+  score_threshold threshold_;
+  context ctx_{ threshold_ };
+  size_t k_;
+  size_t hits_{};
+  std::atomic<float_t>* shared_{}; // threshold shared between workers
+  bool raised_{}; // threshold is raised by the shared one
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // top_k_collector
+
+} // ROOT
+
+#endif // IRESEARCH_TOP_K_COLLECTOR_H
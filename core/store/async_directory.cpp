@@ -0,0 +1,333 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#include "async_directory.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+
+#include "error/error.hpp"
+#include "utils/async_utils.hpp"
+#include "utils/memory.hpp"
+#include "utils/string_utils.hpp"
+#include "utils/thread_utils.hpp"
+
+namespace {
+
+using namespace irs;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @struct read_request
+/// @brief region of a file read ahead on a thread pool
+//////////////////////////////////////////////////////////////////////////////
+struct read_request : private util::noncopyable {
+  using ptr = std::shared_ptr<read_request>;
+
+  enum class State { PENDING, RUNNING, DONE, FAILED };
+
+  read_request(size_t offset, size_t length) noexcept
+    : offset(offset), length(length) {
+  }
+
+  bool contains(size_t pos) const noexcept {
+    return offset <= pos && pos < offset + length;
+  }
+
+  // executed by a pool thread unless the request has been
+  // claimed by a reader before the thread got to it
+  void read(index_input& in) noexcept {
+    {
+      auto lock = make_unique_lock(mutex);
+
+      if (State::PENDING != state) {
+        return;
+      }
+
+      state = State::RUNNING;
+    }
+
+    auto result = State::FAILED;
+
+    try {
+      data.resize(length);
+      in.seek(offset);
+
+      if (length == in.read_bytes(&data[0], length)) {
+        result = State::DONE;
+      }
+    } catch (...) {
+    }
+
+    {
+      auto lock = make_unique_lock(mutex);
+      state = result;
+    }
+
+    cond.notify_all();
+  }
+
+  // returns true if the data has been read ahead, a reader waits
+  // for a request being executed but never for a pending one,
+  // since a pool may be busy or stopped, it claims the request
+  // and reads the region itself instead
+  bool wait() noexcept {
+    auto lock = make_unique_lock(mutex);
+
+    if (State::PENDING == state) {
+      state = State::FAILED;
+      return false;
+    }
+
+    cond.wait(lock, [this]() { return State::RUNNING != state; });
+
+    return State::DONE == state;
+  }
+
+  const size_t offset;
+  const size_t length;
+  bstring data; // published via 'state'
+  std::mutex mutex;
+  std::condition_variable cond;
+  State state{State::PENDING};
+}; // read_request
+
+//////////////////////////////////////////////////////////////////////////////
+/// @struct file_state
+/// @brief regions of a file read ahead, shared by all duplicates of an input
+///        since a region may be prefetched via one input and read via another
+//////////////////////////////////////////////////////////////////////////////
+struct file_state : private util::noncopyable {
+  explicit file_state(size_t max_requests) noexcept
+    : max_requests(max_requests) {
+  }
+
+  read_request::ptr find(size_t pos) const {
+    auto lock = make_lock_guard(mutex);
+
+    for (auto& request : requests) {
+      if (request->contains(pos)) {
+        return request;
+      }
+    }
+
+    return nullptr;
+  }
+
+  void remove(const read_request::ptr& request) {
+    auto lock = make_lock_guard(mutex);
+
+    const auto it = std::find(requests.begin(), requests.end(), request);
+
+    if (it != requests.end()) {
+      requests.erase(it);
+    }
+  }
+
+  mutable std::mutex mutex;
+  std::deque<read_request::ptr> requests; // oldest first
+  const size_t max_requests;
+}; // file_state
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class async_index_input
+/// @brief reads via the wrapped input unless a region has been read ahead
+//////////////////////////////////////////////////////////////////////////////
+class async_index_input final : public buffered_index_input {
+ public:
+  async_index_input(
+      index_input::ptr&& impl,
+      async_utils::thread_pool& pool,
+      size_t max_prefetched)
+    : impl_(std::move(impl)),
+      state_(std::make_shared<file_state>(max_prefetched)),
+      pool_(&pool),
+      pos_(0) {
+    assert(impl_);
+  }
+
+  virtual int64_t checksum(size_t offset) const override {
+    impl_->seek(file_pointer());
+    return impl_->checksum(offset);
+  }
+
+  virtual ptr dup() const override {
+    return memory::make_unique<async_index_input>(*this, impl_->dup());
+  }
+
+  virtual ptr reopen() const override {
+    return memory::make_unique<async_index_input>(*this, impl_->reopen());
+  }
+
+  virtual size_t length() const override {
+    return impl_->length();
+  }
+
+  virtual void prefetch(size_t offset, size_t length) const noexcept override {
+    const auto size = this->length();
+
+    if (!length || offset >= size) {
+      return;
+    }
+
+    length = (std::min)(length, size - offset);
+
+    try {
+      {
+        auto lock = make_lock_guard(state_->mutex);
+
+        for (auto& request : state_->requests) {
+          if (request->contains(offset) && request->contains(offset + length - 1)) {
+            return; // already requested
+          }
+        }
+      }
+
+      auto request = std::make_shared<read_request>(offset, length);
+      std::shared_ptr<index_input> in(impl_->dup()); // used by a pool thread
+
+      if (!pool_->run([request, in]() { request->read(*in); })) {
+        return; // pool isn't active
+      }
+
+      read_request::ptr dropped;
+
+      {
+        auto lock = make_lock_guard(state_->mutex);
+
+        state_->requests.emplace_back(request);
+
+        if (state_->requests.size() > state_->max_requests) {
+          dropped = std::move(state_->requests.front());
+          state_->requests.pop_front();
+        }
+      }
+
+      if (dropped) {
+        // don't read a region nobody is going to look up
+        auto lock = make_unique_lock(dropped->mutex);
+
+        if (read_request::State::PENDING == dropped->state) {
+          dropped->state = read_request::State::FAILED;
+        }
+      }
+    } catch (...) {
+      // prefetching is just a hint
+    }
+  }
+
+  async_index_input(const async_index_input& rhs, index_input::ptr&& impl) noexcept
+    : buffered_index_input(rhs),
+      impl_(std::move(impl)),
+      state_(rhs.state_),
+      pool_(rhs.pool_),
+      pos_(rhs.pos_) {
+    assert(impl_);
+  }
+
+ protected:
+  virtual void seek_internal(size_t pos) override {
+    if (pos >= length()) {
+      throw io_error(string_utils::to_string(
+        "seek out of range for input file, length '" IR_SIZE_T_SPECIFIER "', position '" IR_SIZE_T_SPECIFIER "'",
+        length(), pos));
+    }
+
+    pos_ = pos;
+  }
+
+  virtual size_t read_internal(byte_type* b, size_t len) override {
+    assert(b);
+    size_t read = 0;
+
+    while (read < len) {
+      const auto request = state_->find(pos_);
+
+      if (!request || !request->wait()) {
+        if (request) {
+          state_->remove(request);
+        }
+
+        // read the rest synchronously
+        impl_->seek(pos_);
+        const auto size = impl_->read_bytes(b + read, len - read);
+        pos_ += size;
+        read += size;
+        break;
+      }
+
+      const auto size = (std::min)(len - read, request->offset + request->length - pos_);
+      std::memcpy(b + read, request->data.c_str() + (pos_ - request->offset), size);
+      pos_ += size;
+      read += size;
+    }
+
+    return read;
+  }
+
+ private:
+  async_index_input& operator=(const async_index_input&) = delete;
+
+  index_input::ptr impl_;
+  std::shared_ptr<file_state> state_;
+  async_utils::thread_pool* pool_;
+  size_t pos_; // current input stream position
+}; // async_index_input
+
+}
+
+namespace iresearch {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                    async_directory implementation
+// -----------------------------------------------------------------------------
+
+async_directory::async_directory(
+    const std::string& dir,
+    async_utils::thread_pool& pool,
+    size_t max_prefetched /*= DEFAULT_MAX_PREFETCHED*/)
+  : fs_directory(dir),
+    pool_(&pool),
+    max_prefetched_((std::max)(size_t(1), max_prefetched)) {
+}
+
+index_input::ptr async_directory::open(
+    const std::string& name,
+    IOAdvice advice) const noexcept {
+  auto impl = fs_directory::open(name, advice);
+
+  if (!impl) {
+    return nullptr;
+  }
+
+  try {
+    return memory::make_unique<async_index_input>(
+      std::move(impl), *pool_, max_prefetched_);
+  } catch (...) {
+  }
+
+  return nullptr;
+}
+
+} // ROOT
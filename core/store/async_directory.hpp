@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_ASYNC_DIRECTORY_H
+#define IRESEARCH_ASYNC_DIRECTORY_H
+
+#include "fs_directory.hpp"
+
+namespace iresearch {
+
+namespace async_utils {
+class thread_pool;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class async_directory
+/// @brief serves 'index_input::prefetch(...)' hints by reading the requested
+///        regions up front via positional reads on a thread pool, subsequent
+///        reads of the regions are served from memory
+/// @note the pool must outlive the directory and the inputs opened from it
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API async_directory : public fs_directory {
+ public:
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief default max number of regions read ahead per file, the oldest
+  ///        region is dropped once the limit is reached
+  ////////////////////////////////////////////////////////////////////////////
+  static constexpr size_t DEFAULT_MAX_PREFETCHED = 16;
+
+  async_directory(
+    const std::string& dir,
+    async_utils::thread_pool& pool,
+    size_t max_prefetched = DEFAULT_MAX_PREFETCHED);
+
+  virtual index_input::ptr open(
+    const std::string& name,
+    IOAdvice advice
+  ) const noexcept override final;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  async_utils::thread_pool* pool_;
+  size_t max_prefetched_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // async_directory
+
+} // ROOT
+
+#endif // IRESEARCH_ASYNC_DIRECTORY_H
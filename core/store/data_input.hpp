@@ -122,6 +122,11 @@ struct IRESEARCH_API index_input : public data_input {
   // specified offset without changing current position
   virtual int64_t checksum(size_t offset) const = 0;
 
+  // hints that the specified region is going to be read soon, so
+  // an implementation may start loading it asynchronously, e.g. to
+  // issue several block reads up front instead of one at a time
+  virtual void prefetch(size_t /*offset*/, size_t /*length*/) const noexcept { }
+
  private:
   index_input& operator=( const index_input& ) = delete;
 }; // index_input
@@ -143,6 +143,21 @@ struct IRESEARCH_API directory : private util::noncopyable {
   ////////////////////////////////////////////////////////////////////////////
   virtual index_output::ptr create(const std::string& name) noexcept = 0;
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief opens output stream associated with the file
+  /// @param[in] name name of the file to open
+  /// @param[in] advice expected access pattern for the data once written,
+  ///            e.g. IOAdvice::READONCE denotes data that isn't going to be
+  ///            accessed in the near future, so it may bypass system caches
+  /// @returns output stream associated with the file with the specified name
+  ////////////////////////////////////////////////////////////////////////////
+  virtual index_output::ptr create(
+      const std::string& name,
+      IOAdvice advice) noexcept {
+    UNUSED(advice);
+    return create(name);
+  }
+
   ////////////////////////////////////////////////////////////////////////////
   /// @brief check whether the file specified by the given name exists
   /// @param[out] true if file already exists
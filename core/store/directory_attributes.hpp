@@ -64,8 +64,10 @@ class IRESEARCH_API memory_allocator : public stored_attribute {
 
 //////////////////////////////////////////////////////////////////////////////
 /// @class fd_pool_size
-/// @brief the size of file descriptor pools
-///        where applicable, e.g. fs_directory
+/// @brief the size of file descriptor pools where applicable
+/// @deprecated ignored, no directory pools file descriptors anymore, e.g.
+///             fs_directory reads via positional reads on a single shared
+///             descriptor, kept for API compatibility and to be removed
 //////////////////////////////////////////////////////////////////////////////
 struct IRESEARCH_API fd_pool_size: public stored_attribute {
   DECLARE_FACTORY();
@@ -27,7 +27,7 @@
 #include "error/error.hpp"
 #include "utils/locale_utils.hpp"
 #include "utils/log.hpp"
-#include "utils/object_pool.hpp"
+#include "utils/memory.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/utf8_path.hpp"
 #include "utils/file_utils.hpp"
@@ -167,6 +167,100 @@ class fs_lock : public index_lock {
   file_utils::lock_handle_t handle_;
 }; // fs_lock
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class fs_direct_index_output
+/// @brief writes bypassing the system caches, data is staged in an aligned
+///        buffer and written in large aligned chunks, an unaligned tail is
+///        written through the caches on close
+//////////////////////////////////////////////////////////////////////////////
+class fs_direct_index_output final : public buffered_index_output {
+ public:
+  DEFINE_FACTORY_INLINE(index_output)
+
+  static constexpr size_t ALIGNMENT = 4096; // covers logical block sizes
+  static constexpr size_t STAGING_SIZE = 256*ALIGNMENT;
+
+  // returns nullptr if direct I/O isn't supported for a specified file
+  static index_output::ptr open(file_utils::handle_t& handle) noexcept {
+    assert(handle);
+
+    if (!irs::file_utils::direct_io(handle.get(), true)) {
+      return nullptr;
+    }
+
+    try {
+      return fs_direct_index_output::make<fs_direct_index_output>(std::move(handle));
+    } catch (...) {
+      irs::file_utils::direct_io(handle.get(), false);
+    }
+
+    return nullptr;
+  }
+
+  virtual void close() override {
+    buffered_index_output::close();
+
+    if (staged_) {
+      // tail isn't aligned, write it through the caches
+      irs::file_utils::direct_io(handle_.get(), false);
+      write_staged();
+    }
+
+    handle_.reset(nullptr);
+  }
+
+  virtual int64_t checksum() const override {
+    const_cast<fs_direct_index_output*>(this)->flush();
+    return crc_.checksum();
+  }
+
+ protected:
+  virtual void flush_buffer(const byte_type* b, size_t len) override {
+    crc_.process_bytes(b, len);
+
+    while (len) {
+      const auto to_copy = (std::min)(len, STAGING_SIZE - staged_);
+      std::memcpy(staging_ + staged_, b, to_copy);
+      staged_ += to_copy;
+      b += to_copy;
+      len -= to_copy;
+
+      if (STAGING_SIZE == staged_) {
+        write_staged();
+      }
+    }
+  }
+
+ private:
+  explicit fs_direct_index_output(file_utils::handle_t&& handle)
+    : buffered_index_output(DEFAULT_BUFFER_SIZE),
+      buf_(memory::make_unique<byte_type[]>(STAGING_SIZE + ALIGNMENT)),
+      staging_(reinterpret_cast<byte_type*>(
+        memory::align_up(reinterpret_cast<size_t>(buf_.get()), ALIGNMENT))),
+      handle_(std::move(handle)) {
+  }
+
+  void write_staged() {
+    assert(handle_);
+
+    const auto written = irs::file_utils::fwrite(handle_.get(), staging_, staged_);
+
+    if (written != staged_) {
+      throw io_error(string_utils::to_string(
+        "failed to write buffer, written '" IR_SIZE_T_SPECIFIER "' out of '" IR_SIZE_T_SPECIFIER "' bytes",
+        written, staged_));
+    }
+
+    staged_ = 0;
+  }
+
+  std::unique_ptr<byte_type[]> buf_;
+  byte_type* staging_; // 'buf_' aligned to ALIGNMENT
+  file_utils::handle_t handle_; // initialized last, not consumed on failure
+  size_t staged_{}; // number of bytes in 'staging_'
+  crc32c crc_;
+}; // fs_direct_index_output
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class fs_index_output
 //////////////////////////////////////////////////////////////////////////////
@@ -174,7 +268,7 @@ class fs_index_output : public buffered_index_output {
  public:
   DEFINE_FACTORY_INLINE(index_output)
 
-  static index_output::ptr open(const file_path_t name) noexcept {
+  static index_output::ptr open(const file_path_t name, IOAdvice advice) noexcept {
     assert(name);
 
     file_utils::handle_t handle(irs::file_utils::open(name, 
@@ -197,6 +291,15 @@ class fs_index_output : public buffered_index_output {
       return nullptr;
     }
 
+    if (bool(advice & IOAdvice::READONCE)) {
+      // file isn't going to be read soon, don't pollute the caches
+      auto out = fs_direct_index_output::open(handle);
+
+      if (out) {
+        return out;
+      }
+    }
+
     const auto buf_size = buffer_size(handle.get());
 
     try {
@@ -245,14 +348,14 @@ class fs_index_output : public buffered_index_output {
 
 //////////////////////////////////////////////////////////////////////////////
 /// @class fs_index_input
+/// @brief reads via positional reads on a descriptor shared by all
+///        duplicates of an input, so 'dup()' and 'reopen()' are cheap and
+///        concurrent readers don't interfere with each other
 //////////////////////////////////////////////////////////////////////////////
-class pooled_fs_index_input; // predeclaration used by fs_index_input
-class fs_index_input : public buffered_index_input {
+class fs_index_input final : public buffered_index_input {
  public:
-  using buffered_index_input::read_internal;
-
-  virtual int64_t checksum(size_t offset) const override final {
-    const auto begin = handle_->pos;
+  virtual int64_t checksum(size_t offset) const override {
+    const auto begin = file_pointer();
     const auto end = (std::min)(begin + offset, handle_->size);
 
     crc32c crc;
@@ -260,8 +363,16 @@ class fs_index_input : public buffered_index_input {
 
     for (auto pos = begin; pos < end; ) {
       const auto to_read = (std::min)(end - pos, sizeof buf);
-      pos += const_cast<fs_index_input*>(this)->read_internal(buf, to_read);
-      crc.process_bytes(buf, to_read);
+      const auto read = irs::file_utils::pread(*handle_, buf, to_read, pos);
+
+      if (read != to_read) {
+        throw io_error(string_utils::to_string(
+          "failed to read from input file, read '" IR_SIZE_T_SPECIFIER "' out of '" IR_SIZE_T_SPECIFIER "' bytes, error '%d'",
+          read, to_read, irs::file_utils::ferror(*handle_)));
+      }
+
+      crc.process_bytes(buf, read);
+      pos += read;
     }
 
     return crc.checksum();
@@ -272,12 +383,11 @@ class fs_index_input : public buffered_index_input {
   }
 
   static index_input::ptr open(
-      const file_path_t name, size_t pool_size, IOAdvice advice) noexcept {
+      const file_path_t name, IOAdvice advice) noexcept {
     assert(name);
 
     auto handle = file_handle::make();
-    handle->posix_open_advice = get_posix_fadvice(advice);
-    handle->handle = irs::file_utils::open(name, irs::file_utils::OpenMode::Read, handle->posix_open_advice);
+    handle->handle = irs::file_utils::open(name, irs::file_utils::OpenMode::Read, get_posix_fadvice(advice));
 
     if (nullptr == handle->handle) {
       typedef std::remove_pointer<file_path_t>::type char_t;
@@ -320,10 +430,7 @@ class fs_index_input : public buffered_index_input {
     const auto buf_size = ::buffer_size(handle->handle.get());
 
     try {
-      return ptr(new fs_index_input(
-        std::move(handle),
-        buf_size,
-        pool_size));
+      return ptr(new fs_index_input(std::move(handle), buf_size));
     } catch(...) {
     }
 
@@ -334,7 +441,16 @@ class fs_index_input : public buffered_index_input {
     return handle_->size;
   }
 
-  virtual ptr reopen() const override;
+  virtual ptr reopen() const override {
+    // positional reads don't depend on the state of a descriptor
+    return dup();
+  }
+
+  virtual void prefetch(size_t offset, size_t length) const noexcept override {
+    if (length && offset < handle_->size) {
+      irs::file_utils::prefetch(*handle_, offset, (std::min)(length, handle_->size - offset));
+    }
+  }
 
  protected:
   virtual void seek_internal(size_t pos) override {
@@ -353,17 +469,8 @@ class fs_index_input : public buffered_index_input {
 
     void* fd = *handle_;
 
-    if (handle_->pos != pos_) {
-      if (irs::file_utils::fseek(fd, static_cast<long>(pos_), SEEK_SET) != 0) {
-        throw io_error(string_utils::to_string(
-          "failed to seek to '" IR_SIZE_T_SPECIFIER "' for input file, error '%d'",
-          pos_, irs::file_utils::ferror(fd)));
-      }
-      handle_->pos = pos_;
-    }
-
-    size_t read = irs::file_utils::fread(fd, b, sizeof(byte_type) * len);
-    pos_ = handle_->pos += read;
+    const size_t read = irs::file_utils::pread(fd, b, sizeof(byte_type) * len, pos_);
+    pos_ += read;
 
     if (read != len) {
       if (0 == read) {
@@ -378,16 +485,10 @@ class fs_index_input : public buffered_index_input {
         read, len, irs::file_utils::ferror(fd)));
     }
 
-    assert(handle_->pos == pos_);
     return read;
   }
 
  private:
-  friend pooled_fs_index_input;
-
-  /* use shared wrapper here since we don't want to
-  * call "ftell" every time we need to know current 
-  * position */
   struct file_handle {
     using ptr = std::shared_ptr<file_handle>;
     static ptr make();
@@ -396,114 +497,24 @@ class fs_index_input : public buffered_index_input {
 
     file_utils::handle_t handle; /* native file handle */
     size_t size{}; /* file size */
-    size_t pos{}; /* current file position*/
-    int posix_open_advice{ IR_FADVICE_NORMAL };
   }; // file_handle
 
-  fs_index_input(
-      file_handle::ptr&& handle,
-      size_t buffer_size,
-      size_t pool_size) noexcept
+  fs_index_input(file_handle::ptr&& handle, size_t buffer_size) noexcept
     : buffered_index_input(buffer_size),
       handle_(std::move(handle)),
-      pool_size_(pool_size),
       pos_(0) {
     assert(handle_);
   }
 
+  fs_index_input(const fs_index_input&) = default;
   fs_index_input& operator=(const fs_index_input&) = delete;
 
   file_handle::ptr handle_; // shared file handle
-  size_t pool_size_; // size of pool for instances of pooled_fs_index_input
   size_t pos_; // current input stream position
 }; // fs_index_input
 
 DEFINE_FACTORY_DEFAULT(fs_index_input::file_handle)
 
-class pooled_fs_index_input final : public fs_index_input {
- public:
-  explicit pooled_fs_index_input(const fs_index_input& in);
-  virtual ~pooled_fs_index_input() noexcept;
-  virtual index_input::ptr dup() const override {
-    return ptr(new pooled_fs_index_input(*this));
-  }
-  virtual index_input::ptr reopen() const override;
-
- private:
-  typedef unbounded_object_pool<file_handle> fd_pool_t;
-  std::shared_ptr<fd_pool_t> fd_pool_;
-
-  pooled_fs_index_input(const pooled_fs_index_input& in) = default;
-  file_handle::ptr reopen(const file_handle& src) const;
-}; // pooled_fs_index_input
-
-index_input::ptr fs_index_input::reopen() const {
-  return memory::make_unique<pooled_fs_index_input>(*this);
-}
-
-pooled_fs_index_input::pooled_fs_index_input(const fs_index_input& in)
-  : fs_index_input(in),
-    fd_pool_(memory::make_shared<fd_pool_t>(pool_size_)) {
-  handle_ = reopen(*handle_);
-}
-
-pooled_fs_index_input::~pooled_fs_index_input() noexcept {
-  handle_.reset(); // release handle before the fs_pool_ is deallocated
-}
-
-index_input::ptr pooled_fs_index_input::reopen() const {
-  auto ptr = dup();
-  assert(ptr);
-
-  auto& in = static_cast<pooled_fs_index_input&>(*ptr);
-  in.handle_ = reopen(*handle_); // reserve a new handle from pool
-  assert(in.handle_ && in.handle_->handle);
-
-  return ptr;
-}
-
-fs_index_input::file_handle::ptr pooled_fs_index_input::reopen(
-  const file_handle& src
-) const {
-  // reserve a new handle from the pool
-  auto handle = const_cast<pooled_fs_index_input*>(this)->fd_pool_->emplace().release();
-
-  if (!handle->handle) {
-    handle->handle = irs::file_utils::open(src, irs::file_utils::OpenMode::Read, src.posix_open_advice); // same permission as in fs_index_input::open(...)
-
-    if (!handle->handle) {
-      // even win32 uses 'errno' for error codes in calls to file_open(...)
-      throw io_error(string_utils::to_string(
-        "Failed to reopen input file, error: %d",
-#ifdef _WIN32
-        GetLastError()
-#else
-        errno
-#endif
-      ));
-    }
-    handle->posix_open_advice = src.posix_open_advice;
-  }
-
-  const auto pos = irs::file_utils::ftell(handle->handle.get()); // match position of file descriptor
-
-  if (pos < 0) {
-    throw io_error(string_utils::to_string(
-      "Failed to obtain current position of input file, error: %d",
-#ifdef _WIN32
-      GetLastError()
-#else
-      errno
-#endif
-    ));
-  }
-
-  handle->pos = pos;
-  handle->size = src.size;
-
-  return handle;
-}
-
 // -----------------------------------------------------------------------------
 // --SECTION--                                       fs_directory implementation
 // -----------------------------------------------------------------------------
@@ -517,12 +528,18 @@ attribute_store& fs_directory::attributes() noexcept {
 }
 
 index_output::ptr fs_directory::create(const std::string& name) noexcept {
+  return create(name, IOAdvice::NORMAL);
+}
+
+index_output::ptr fs_directory::create(
+    const std::string& name,
+    IOAdvice advice) noexcept {
   try {
     utf8_path path;
 
     (path/=dir_)/=name;
 
-    auto out = fs_index_output::open(path.c_str());
+    auto out = fs_index_output::open(path.c_str(), advice);
 
     if (!out) {
       IR_FRMT_ERROR("Failed to open output file, path: %s", name.c_str());
@@ -579,12 +596,10 @@ index_input::ptr fs_directory::open(
     IOAdvice advice) const noexcept {
   try {
     utf8_path path;
-    auto pool_size =
-      const_cast<attribute_store&>(attributes()).emplace<fd_pool_size>()->size;
 
     (path/=dir_)/=name;
 
-    return fs_index_input::open(path.c_str(), pool_size, advice);
+    return fs_index_input::open(path.c_str(), advice);
   } catch(...) {
   }
 
@@ -42,6 +42,14 @@ class IRESEARCH_API fs_directory : public directory {
 
   virtual index_output::ptr create(const std::string& name) noexcept override;
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @note IOAdvice::READONCE makes the output bypass the system caches
+  ///       where supported
+  ////////////////////////////////////////////////////////////////////////////
+  virtual index_output::ptr create(
+    const std::string& name,
+    IOAdvice advice) noexcept override;
+
   const std::string& directory() const noexcept;
 
   virtual bool exists(
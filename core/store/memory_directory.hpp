@@ -274,6 +274,7 @@ class IRESEARCH_API memory_directory final : public directory {
 
   virtual attribute_store& attributes() noexcept override;
 
+  using directory::create;
   virtual index_output::ptr create(const std::string& name) noexcept override;
 
   virtual bool exists(
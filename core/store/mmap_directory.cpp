@@ -67,7 +67,8 @@ class mmap_index_input : public irs::bytes_ref_input {
  public:
   static irs::index_input::ptr open(
       const file_path_t file,
-      irs::IOAdvice advice) noexcept {
+      irs::IOAdvice advice,
+      irs::MmapOptions options) noexcept {
     assert(file);
 
     mmap_handle_ptr handle;
@@ -78,7 +79,9 @@ class mmap_index_input : public irs::bytes_ref_input {
       return nullptr;
     }
 
-    if (!handle->open(file)) {
+    const bool populate = bool(options & irs::MmapOptions::POPULATE);
+
+    if (!handle->open(file, populate ? IR_MMAP_POPULATE : 0)) {
       IR_FRMT_ERROR("Failed to open mmapped input file, path: " IR_FILEPATH_SPECIFIER, file);
       return nullptr;
     }
@@ -89,6 +92,19 @@ class mmap_index_input : public irs::bytes_ref_input {
       IR_FRMT_ERROR("Failed to madvise input file, path: " IR_FILEPATH_SPECIFIER ", error %d", file, errno);
     }
 
+    if (populate && !IR_MMAP_POPULATE && !handle->advise(IR_MADVICE_WILLNEED)) {
+      IR_FRMT_WARN("Failed to prefault input file, path: " IR_FILEPATH_SPECIFIER ", error %d", file, errno);
+    }
+
+    if (bool(options & irs::MmapOptions::HUGE_PAGES) && IR_MADVICE_HUGEPAGE
+        && !handle->advise(IR_MADVICE_HUGEPAGE)) {
+      IR_FRMT_WARN("Failed to use huge pages for input file, path: " IR_FILEPATH_SPECIFIER ", error %d", file, errno);
+    }
+
+    if (bool(options & irs::MmapOptions::LOCK) && !handle->lock()) {
+      IR_FRMT_WARN("Failed to lock input file in memory, path: " IR_FILEPATH_SPECIFIER ", error %d", file, errno);
+    }
+
     handle->dontneed(bool(advice & irs::IOAdvice::READONCE));
 
     try {
@@ -106,6 +122,10 @@ class mmap_index_input : public irs::bytes_ref_input {
     return dup();
   }
 
+  virtual void prefetch(size_t offset, size_t length) const noexcept override {
+    handle_->advise(IR_MADVICE_WILLNEED, offset, length);
+  }
+
  private:
   mmap_index_input(mmap_handle_ptr&& handle) noexcept
     : handle_(std::move(handle)) {
@@ -133,8 +153,32 @@ namespace iresearch {
 // --SECTION--                                     mmap_directory implementation
 // -----------------------------------------------------------------------------
 
-mmap_directory::mmap_directory(const std::string& path)
-  : fs_directory(path) {
+mmap_directory::mmap_directory(const std::string& path, options_t options)
+  : fs_directory(path),
+    options_(std::move(options)) {
+}
+
+MmapOptions mmap_directory::options(const std::string& name) const noexcept {
+  if (options_.empty()) {
+    return MmapOptions::NONE;
+  }
+
+  const auto pos = name.rfind('.');
+
+  if (std::string::npos == pos) {
+    return MmapOptions::NONE;
+  }
+
+  try {
+    const auto it = options_.find(name.substr(pos + 1));
+
+    if (it != options_.end()) {
+      return it->second;
+    }
+  } catch (...) {
+  }
+
+  return MmapOptions::NONE;
 }
 
 index_input::ptr mmap_directory::open(
@@ -148,7 +192,7 @@ index_input::ptr mmap_directory::open(
     return nullptr;
   }
 
-  return mmap_index_input::open(path.c_str(), advice);
+  return mmap_index_input::open(path.c_str(), advice, options(name));
 }
 
 } // ROOT
@@ -25,19 +25,59 @@
 
 #include "fs_directory.hpp"
 
+#include <unordered_map>
+
 namespace iresearch {
 
+//////////////////////////////////////////////////////////////////////////////
+/// @enum MmapOptions
+/// @brief defines how files are mapped into memory
+//////////////////////////////////////////////////////////////////////////////
+enum class MmapOptions : uint32_t {
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief map files with no additional options
+  ////////////////////////////////////////////////////////////////////////////
+  NONE = 0,
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief pre-fault pages of a file once it's opened
+  ////////////////////////////////////////////////////////////////////////////
+  POPULATE = 1,
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief lock pages of a file in memory, subject to RLIMIT_MEMLOCK
+  ////////////////////////////////////////////////////////////////////////////
+  LOCK = 2,
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief back a file with transparent huge pages where supported
+  ////////////////////////////////////////////////////////////////////////////
+  HUGE_PAGES = 4
+}; // MmapOptions
+
+ENABLE_BITMASK_ENUM(MmapOptions); // enable bitmap operations on the enum
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class mmap_directory
 //////////////////////////////////////////////////////////////////////////////
 class IRESEARCH_API mmap_directory : public fs_directory {
  public:
-  explicit mmap_directory(const std::string& dir);
+  // options by file extension, e.g. { "ti", MmapOptions::POPULATE }
+  using options_t = std::unordered_map<std::string, MmapOptions>;
+
+  explicit mmap_directory(const std::string& dir, options_t options = {});
 
   virtual index_input::ptr open(
     const std::string& name,
     IOAdvice advice
   ) const noexcept override final;
+
+ private:
+  MmapOptions options(const std::string& name) const noexcept;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  options_t options_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // mmap_directory
 
 } // ROOT
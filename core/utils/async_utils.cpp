@@ -554,5 +554,166 @@ void thread_pool::worker_impl(std::unique_lock<std::mutex>& lock,
   }
 }
 
+void run_concurrently(
+    thread_pool* pool,
+    const std::function<void()>& background,
+    const std::function<void()>& foreground) {
+  struct state_t {
+    explicit state_t(const std::function<void()>& background)
+      : background(background) {
+    }
+
+    // invokes 'background' unless it's already claimed by another thread
+    void process() noexcept {
+      {
+        auto lock = make_lock_guard(mutex);
+
+        if (started) {
+          return;
+        }
+
+        started = true;
+      }
+
+      std::exception_ptr error;
+
+      try {
+        background();
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      auto lock = make_lock_guard(mutex);
+      this->error = std::move(error);
+      done = true;
+      finished.notify_one();
+    }
+
+    const std::function<void()>& background;
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+    bool started{ false }; // pool task started after that must not touch 'background'
+    bool done{ false };
+  };
+
+  // pool task may start after the function returned, hence shared state
+  auto state = std::make_shared<state_t>(background);
+
+  if (pool) {
+    pool->run([state]() noexcept { state->process(); });
+  }
+
+  std::exception_ptr error;
+
+  try {
+    foreground();
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  // run 'background' inline if the pool didn't start it yet, e.g. all
+  // threads of the pool are busy waiting for the caller
+  state->process();
+
+  // started pool task references the caller's state, wait for it in any case
+  {
+    auto lock = make_unique_lock(state->mutex);
+    state->finished.wait(lock, [&state]() noexcept { return state->done; });
+  }
+
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void for_each_concurrently(
+    thread_pool* pool,
+    size_t count,
+    const std::function<void(size_t)>& fn) {
+  struct state_t {
+    explicit state_t(const std::function<void(size_t)>& fn, size_t count)
+      : fn(fn), count(count) {
+    }
+
+    // invokes 'fn' until there is nothing left to process
+    void process() noexcept {
+      try {
+        for (size_t i; (i = next++) < count; ) {
+          fn(i);
+        }
+      } catch (...) {
+        next = count; // cancel the rest
+
+        auto lock = make_lock_guard(mutex);
+
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+
+    const std::function<void(size_t)>& fn;
+    const size_t count;
+    std::atomic<size_t> next{ 0 };
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+    size_t active{ 0 }; // number of pool tasks invoking 'fn'
+    bool closed{ false }; // pool tasks started after that must not touch 'fn'
+  };
+
+  if (!count) {
+    return;
+  }
+
+  // pool tasks may start after the function returned, hence shared state
+  auto state = std::make_shared<state_t>(fn, count);
+  const size_t tasks = pool ? std::min(count - 1, pool->max_threads()) : 0;
+
+  for (size_t i = 0; i < tasks; ++i) {
+    const bool scheduled = pool->run([state]() noexcept {
+      {
+        auto lock = make_lock_guard(state->mutex);
+
+        if (state->closed) {
+          return; // everything is processed already
+        }
+
+        ++state->active;
+      }
+
+      state->process();
+
+      auto lock = make_lock_guard(state->mutex);
+
+      if (!--state->active) {
+        state->finished.notify_one();
+      }
+    });
+
+    if (!scheduled) {
+      break;
+    }
+  }
+
+  state->process();
+
+  // started pool tasks reference 'fn', wait for them in any case
+  {
+    auto lock = make_unique_lock(state->mutex);
+    state->closed = true;
+    state->finished.wait(lock, [&state]() noexcept { return !state->active; });
+  }
+
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
 }
 }
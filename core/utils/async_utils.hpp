@@ -196,6 +196,32 @@ class IRESEARCH_API thread_pool {
   IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // thread_pool
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief runs 'background' on the 'pool' concurrently with 'foreground' on
+///        the current thread, 'background' runs on the current thread after
+///        'foreground' if there is no 'pool' or the 'pool' didn't start it
+///        by then, e.g. all of its threads are busy
+/// @note returns only after both functions finished, an exception thrown by
+///       'background' is rethrown in preference to the one of 'foreground'
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void run_concurrently(
+  thread_pool* pool,
+  const std::function<void()>& background,
+  const std::function<void()>& foreground);
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief invokes 'fn(i)' for every 'i' in [0, count) on the current thread
+///        and on up to 'count - 1' tasks of the 'pool', runs everything on
+///        the current thread if there is no 'pool' or it rejects the tasks
+/// @note returns only after every invocation finished, the first exception
+///       thrown by 'fn' cancels the not yet started invocations and is
+///       rethrown
+//////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void for_each_concurrently(
+  thread_pool* pool,
+  size_t count,
+  const std::function<void(size_t)>& fn);
+
 } // async_utils
 } // namespace iresearch {
 
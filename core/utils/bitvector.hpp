@@ -263,13 +263,19 @@ class bitvector final {
   }
 
   void reset(size_t i, bool set) {
+    const auto bits = std::max(size(), i + 1);
+
     if (!set && bitset::word(i) >= set_.words()) {
-      size_ = std::max(size(), i + 1);
+      size_ = bits;
 
       return; // nothing to do
     }
 
-    resize(std::max(size(), i + 1), true); // ensure capacity
+    // ensure capacity, bits past 'size_' are always unset so unlike resize()
+    // there is no need to clear trailing words, which would make a sequence
+    // of reset() calls quadratic in the reserved capacity
+    reserve(bits);
+    size_ = bits;
     set_.reset(i, set);
   }
 
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#include "block_cache.hpp"
+
+#include "utils/hash_utils.hpp"
+
+namespace iresearch {
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                      block_cache
+// ----------------------------------------------------------------------------
+
+/*static*/ block_cache& block_cache::instance() {
+  static block_cache INSTANCE;
+  return INSTANCE;
+}
+
+/*static*/ uint64_t block_cache::next_file_id() noexcept {
+  static std::atomic<uint64_t> NEXT_ID{0};
+  return NEXT_ID.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*static*/ void block_cache::unlink(shard& shard, const key& key) noexcept {
+  const auto it = shard.files.find(key.file);
+  assert(it != shard.files.end());
+
+  it->second.erase(key.offset);
+
+  if (it->second.empty()) {
+    shard.files.erase(it);
+  }
+}
+
+block_cache::block_cache(size_t budget, size_t shards)
+  : budget_(budget) {
+  shards_.resize(std::max(size_t(1), shards));
+  for (auto& shard : shards_) {
+    shard = std::make_unique<block_cache::shard>();
+  }
+}
+
+block_cache::shard& block_cache::get_shard(const key& key) noexcept {
+  // low bits of the offset are likely to be the same for all blocks
+  const size_t hash = hash_combine(key.file, key.offset >> 8);
+  return *shards_[hash % shards_.size()];
+}
+
+void block_cache::evict(shard& shard, size_t budget) noexcept {
+  while (shard.size > budget && !shard.lru.empty()) {
+    auto& entry = shard.lru.back();
+    shard.size -= entry.size;
+    unlink(shard, entry.key);
+    shard.lru.pop_back();
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+block_cache::value_ptr block_cache::find(const key& key) {
+  auto& shard = get_shard(key);
+
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto file = shard.files.find(key.file);
+
+    if (file != shard.files.end()) {
+      const auto it = file->second.find(key.offset);
+
+      if (it != file->second.end()) {
+        // mark as the most recently used
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return it->second->value;
+      }
+    }
+  }
+
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+block_cache::value_ptr block_cache::insert(
+    const key& key,
+    value_ptr&& value,
+    size_t size) {
+  assert(value);
+  const size_t budget = shard_budget();
+
+  if (size > budget) {
+    // block doesn't fit the cache at all
+    return std::move(value);
+  }
+
+  auto& shard = get_shard(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto& blocks = shard.files[key.file];
+  const auto it = blocks.find(key.offset);
+
+  if (it != blocks.end()) {
+    // block has been cached by a concurrent reader
+    return it->second->value;
+  }
+
+  shard.lru.push_front(entry{key, value, size});
+
+  try {
+    blocks.emplace(key.offset, shard.lru.begin());
+  } catch (...) {
+    shard.lru.pop_front();
+    throw;
+  }
+
+  shard.size += size;
+  evict(shard, budget);
+
+  return std::move(value);
+}
+
+void block_cache::erase(uint64_t file) {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    const auto it = shard->files.find(file);
+
+    if (it == shard->files.end()) {
+      continue;
+    }
+
+    for (auto& block : it->second) {
+      shard->size -= block.second->size;
+      shard->lru.erase(block.second);
+    }
+
+    shard->files.erase(it);
+  }
+}
+
+void block_cache::clear() {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->files.clear();
+    shard->lru.clear();
+    shard->size = 0;
+  }
+}
+
+void block_cache::budget(size_t budget) {
+  budget_.store(budget, std::memory_order_relaxed);
+
+  const size_t shard_budget = this->shard_budget();
+
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    evict(*shard, shard_budget);
+  }
+}
+
+block_cache::statistics block_cache::stats() const {
+  statistics stats;
+  stats.hits = hits_.load(std::memory_order_relaxed);
+  stats.misses = misses_.load(std::memory_order_relaxed);
+  stats.evictions = evictions_.load(std::memory_order_relaxed);
+
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    stats.count += shard->lru.size();
+    stats.size += shard->size;
+  }
+
+  return stats;
+}
+
+} // ROOT
@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_BLOCK_CACHE_H
+#define IRESEARCH_BLOCK_CACHE_H
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "shared.hpp"
+#include "noncopyable.hpp"
+
+namespace iresearch {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class block_cache
+/// @brief thread-safe cache of decoded blocks bounded by the total size of
+///        the cached blocks in bytes, the least recently used blocks are
+///        evicted first
+/// @note the cache is split into independently locked shards, each of them
+///       is bounded by an equal part of the budget
+/// @note evicted blocks stay alive while they're referenced by the readers
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API block_cache : private util::noncopyable {
+ public:
+  using value_ptr = std::shared_ptr<const void>;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief default budget of the process-wide cache in bytes
+  //////////////////////////////////////////////////////////////////////////////
+  static constexpr size_t DEFAULT_BUDGET = size_t(256) << 20;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief default number of shards
+  //////////////////////////////////////////////////////////////////////////////
+  static constexpr size_t DEFAULT_SHARDS = 16;
+
+  struct key {
+    uint64_t file; // unique identifier of a file, see 'next_file_id()'
+    uint64_t offset; // offset of a block within a file
+
+    bool operator==(const key& rhs) const noexcept {
+      return file == rhs.file && offset == rhs.offset;
+    }
+  }; // key
+
+  struct statistics {
+    size_t hits{};
+    size_t misses{};
+    size_t evictions{};
+    size_t count{}; // number of cached blocks
+    size_t size{}; // total size of cached blocks in bytes
+  }; // statistics
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns process-wide cache instance
+  //////////////////////////////////////////////////////////////////////////////
+  static block_cache& instance();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns unique identifier of a file for the keys of a cache
+  //////////////////////////////////////////////////////////////////////////////
+  static uint64_t next_file_id() noexcept;
+
+  explicit block_cache(
+    size_t budget = DEFAULT_BUDGET,
+    size_t shards = DEFAULT_SHARDS);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns cached block denoted by 'key', nullptr if none
+  //////////////////////////////////////////////////////////////////////////////
+  value_ptr find(const key& key);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief caches 'value' of 'size' bytes denoted by 'key'
+  /// @returns already cached value if any, 'value' otherwise
+  //////////////////////////////////////////////////////////////////////////////
+  value_ptr insert(const key& key, value_ptr&& value, size_t size);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes all blocks of the specified file from the cache
+  //////////////////////////////////////////////////////////////////////////////
+  void erase(uint64_t file);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes all blocks from the cache
+  //////////////////////////////////////////////////////////////////////////////
+  void clear();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sets the total size of cached blocks in bytes, evicts blocks
+  ///        if necessary
+  //////////////////////////////////////////////////////////////////////////////
+  void budget(size_t budget);
+
+  size_t budget() const noexcept {
+    return budget_.load(std::memory_order_relaxed);
+  }
+
+  statistics stats() const;
+
+ private:
+  struct entry {
+    struct key key;
+    value_ptr value;
+    size_t size;
+  }; // entry
+
+  struct shard {
+    using lru_t = std::list<entry>; // most recently used first
+    using blocks_t = std::unordered_map<uint64_t, lru_t::iterator>; // by offset
+
+    std::mutex mutex;
+    lru_t lru;
+    // blocks are grouped by file, so that blocks of a file are removed
+    // without visiting blocks of the other files
+    std::unordered_map<uint64_t, blocks_t> files;
+    size_t size{}; // total size of cached blocks in bytes
+  }; // shard
+
+  // removes a block denoted by 'key' from the lookup table of a shard
+  static void unlink(shard& shard, const key& key) noexcept;
+
+  shard& get_shard(const key& key) noexcept;
+
+  // evicts least recently used blocks until the shard fits 'budget'
+  void evict(shard& shard, size_t budget) noexcept;
+
+  size_t shard_budget() const noexcept {
+    return budget() / shards_.size();
+  }
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::vector<std::unique_ptr<shard>> shards_;
+  std::atomic<size_t> budget_;
+  std::atomic<size_t> hits_{};
+  std::atomic<size_t> misses_{};
+  std::atomic<size_t> evictions_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // block_cache
+
+}
+
+#endif // IRESEARCH_BLOCK_CACHE_H
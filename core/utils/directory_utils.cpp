@@ -265,23 +265,28 @@ tracking_directory::tracking_directory(
 index_output::ptr tracking_directory::create(
   const std::string& name
 ) noexcept {
-  try {
-    files_.emplace(name);
-  } catch (...) {
-  }
-
-  auto result = impl_.create(name);
+  return track(name, impl_.create(name));
+}
 
-  if (result) {
-    return result;
-  }
+index_output::ptr tracking_directory::create(
+    const std::string& name,
+    IOAdvice advice
+) noexcept {
+  return track(name, impl_.create(name, advice));
+}
 
-  try {
-    files_.erase(name); // revert change
-  } catch (...) {
+index_output::ptr tracking_directory::track(
+    const std::string& name,
+    index_output::ptr&& out
+) noexcept {
+  if (out) {
+    try {
+      files_.emplace(name);
+    } catch (...) {
+    }
   }
 
-  return nullptr;
+  return std::move(out);
 }
 
 index_input::ptr tracking_directory::open(
@@ -348,9 +353,11 @@ void tracking_directory::flush_tracked(file_set& other) noexcept {
 
 ref_tracking_directory::ref_tracking_directory(
     directory& impl,
-    bool track_open /*= false*/
+    bool track_open /*= false*/,
+    IOAdvice create_advice /*= IOAdvice::NORMAL*/
 ) : attribute_(impl.attributes().emplace<index_file_refs>()),
     impl_(impl),
+    create_advice_(create_advice),
     track_open_(track_open) {
 }
 
@@ -360,6 +367,7 @@ ref_tracking_directory::ref_tracking_directory(
   : attribute_(other.attribute_), // references do not require std::move(...)
     impl_(other.impl_), // references do not require std::move(...)
     refs_(std::move(other.refs_)),
+    create_advice_(other.create_advice_),
     track_open_(std::move(other.track_open_)) {
 }
 
@@ -370,9 +378,16 @@ void ref_tracking_directory::clear_refs() const noexcept {
 
 index_output::ptr ref_tracking_directory::create(
   const std::string& name
+) noexcept {
+  return create(name, create_advice_);
+}
+
+index_output::ptr ref_tracking_directory::create(
+    const std::string& name,
+    IOAdvice advice
 ) noexcept {
   try {
-    auto result = impl_.create(name);
+    auto result = impl_.create(name, advice);
 
     // only track ref on successful call to impl_
     if (result) {
@@ -124,6 +124,10 @@ struct IRESEARCH_API tracking_directory final : public directory {
 
   virtual index_output::ptr create(const std::string& name) noexcept override;
 
+  virtual index_output::ptr create(
+    const std::string& name,
+    IOAdvice advice) noexcept override;
+
   void clear_tracked() noexcept;
 
   virtual bool exists(
@@ -172,6 +176,10 @@ struct IRESEARCH_API tracking_directory final : public directory {
   }
 
  private:
+  index_output::ptr track(
+    const std::string& name,
+    index_output::ptr&& out) noexcept;
+
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
   mutable file_set files_;
   directory& impl_;
@@ -188,7 +196,11 @@ struct IRESEARCH_API ref_tracking_directory: public directory {
   using ptr = std::unique_ptr<ref_tracking_directory>;
 
   // @param track_open - track file refs for calls to open(...)
-  explicit ref_tracking_directory(directory& impl, bool track_open = false);
+  // @param create_advice - advice for files created via create(name)
+  explicit ref_tracking_directory(
+    directory& impl,
+    bool track_open = false,
+    IOAdvice create_advice = IOAdvice::NORMAL);
   ref_tracking_directory(ref_tracking_directory&& other) noexcept;
 
   directory& operator*() noexcept {
@@ -204,6 +216,10 @@ struct IRESEARCH_API ref_tracking_directory: public directory {
 
   virtual index_output::ptr create(const std::string &name) noexcept override;
 
+  virtual index_output::ptr create(
+    const std::string& name,
+    IOAdvice advice) noexcept override;
+
   virtual bool exists(
       bool& result, const std::string& name
   ) const noexcept override {
@@ -257,6 +273,7 @@ struct IRESEARCH_API ref_tracking_directory: public directory {
   directory& impl_;
   mutable std::mutex mutex_; // for use with refs_
   mutable refs_t refs_;
+  IOAdvice create_advice_;
   bool track_open_;
   IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // ref_tracking_directory
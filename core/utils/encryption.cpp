@@ -319,10 +319,14 @@ int64_t encrypted_input::checksum(size_t offset) const {
   const auto begin = file_pointer();
   const auto end = (std::min)(begin + offset, this->length());
 
-  auto restore_position = make_finally([begin, this](){
-    const_cast<encrypted_input*>(this)->seek_internal(begin);
+  // position of the underlying stream differs from 'file_pointer()'
+  // once the data is buffered, so it's restored as is
+  auto restore_position = make_finally([pos = in_->file_pointer(), this](){
+    in_->seek(pos);
   });
 
+  in_->seek(start_ + begin);
+
   crc32c crc;
   byte_type buf[DEFAULT_BUFFER_SIZE];
 
@@ -203,6 +203,58 @@ size_t fread(void* fd, void* buf, size_t size) {
 }
 
 
+size_t pread(void* fd, void* buf, size_t size, uint64_t offset) {
+  size_t left = size;
+  auto current = static_cast<byte_type*>(buf);
+#ifdef _WIN32
+  constexpr size_t maxRead = MAXDWORD;
+  while (left > 0) {
+    DWORD to_read = static_cast<DWORD>((std::min)(maxRead, left));
+    DWORD read{ 0 };
+    OVERLAPPED ov{};
+    ov.Offset = static_cast<DWORD>(offset);
+    ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    if (ReadFile(fd, current, to_read, &read, &ov) && read > 0) {
+      left -= read;
+      current += read;
+      offset += read;
+    } else {
+      break;
+    }
+  }
+#else
+  constexpr size_t readLimit = 0x7ffff000;
+  const int descriptor = handle_cast(fd);
+  while (left > 0) {
+    size_t to_read = (std::min)(left, readLimit);
+    const ssize_t read = ::pread(descriptor, current, to_read, static_cast<off_t>(offset));
+    if (read < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    } else if (read > 0) {
+      left -= read;
+      current += read;
+      offset += read;
+    } else {
+      break; // EOF reached
+    }
+  }
+#endif
+  return size - left;
+}
+
+void prefetch(void* fd, uint64_t offset, size_t size) noexcept {
+#if !defined(_WIN32) && (_XOPEN_SOURCE >= 600 || _POSIX_C_SOURCE >= 200112L) && !defined(__APPLE__)
+  posix_fadvise(handle_cast(fd), static_cast<off_t>(offset), static_cast<off_t>(size), POSIX_FADV_WILLNEED);
+#else
+  UNUSED(fd);
+  UNUSED(offset);
+  UNUSED(size);
+#endif
+}
+
 int fseek(void* fd, long pos, int origin) {
 #ifdef _WIN32
   LARGE_INTEGER li;
@@ -798,6 +850,25 @@ handle_t open(const file_path_t path, OpenMode mode, int advice) noexcept {
   #endif
 }
 
+bool direct_io(void* fd, bool enable) noexcept {
+#if defined(__APPLE__)
+  return -1 != fcntl(handle_cast(fd), F_NOCACHE, enable ? 1 : 0);
+#elif !defined(_WIN32) && defined(O_DIRECT)
+  const int descriptor = handle_cast(fd);
+  const int flags = fcntl(descriptor, F_GETFL);
+
+  if (-1 == flags) {
+    return false;
+  }
+
+  return -1 != fcntl(descriptor, F_SETFL, enable ? (flags | O_DIRECT) : (flags & ~O_DIRECT));
+#else
+  UNUSED(fd);
+  UNUSED(enable);
+  return false; // FILE_FLAG_NO_BUFFERING can't be changed for an open handle
+#endif
+}
+
 handle_t open(void* file, OpenMode mode, int advice) noexcept {
   #ifdef _WIN32
     // win32 approach is to get the original filename of the handle and open it again
@@ -138,6 +138,11 @@ typedef std::unique_ptr<void, file_deleter> handle_t;
 handle_t open(const file_path_t path, OpenMode mode, int advice) noexcept;
 handle_t open(void* file, OpenMode mode, int advice) noexcept;
 
+// enables/disables bypassing of the system caches for a file opened
+// for writing, writes must be aligned while bypassing is enabled,
+// returns false if not supported by the platform or a file system
+bool direct_io(void* fd, bool enable) noexcept;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                        path utils
 // -----------------------------------------------------------------------------
@@ -147,8 +152,13 @@ bool mkdir(const file_path_t path, bool createNew) noexcept;  // recursive direc
 bool move(const file_path_t src_path, const file_path_t dst_path) noexcept;
 
 size_t fread(void* fd, void* buf, size_t size);
+// reads at the specified offset without changing the file position,
+// concurrent calls on the same descriptor are safe
+size_t pread(void* fd, void* buf, size_t size, uint64_t offset);
 size_t fwrite(void* fd, const void* buf, size_t size);
 FORCE_INLINE bool write(void* fd, const void* buf, size_t size) { return fwrite(fd, buf, size) == size; }
+// asynchronously loads the specified region into the page cache
+void prefetch(void* fd, uint64_t offset, size_t size) noexcept;
 int fseek(void* fd, long pos, int origin);
 int ferror(void*);
 long ftell(void* fd);
@@ -79,7 +79,18 @@ class ImmutableFstImpl : public internal::FstImpl<A> {
 
   size_t NumOutputEpsilons(StateId) const noexcept { return 0; }
 
-  static std::shared_ptr<ImmutableFstImpl<Arc>> Read(irs::data_input& strm);
+  static std::shared_ptr<ImmutableFstImpl<Arc>> Read(
+    irs::data_input& strm, bool share_weights);
+
+  static bool Skip(irs::index_input& strm);
+
+  // Approximate amount of memory occupied by the FST.
+  size_t Memory() const noexcept {
+    return sizeof(*this)
+      + nstates_*sizeof(State)
+      + narcs_*sizeof(Arc)
+      + (weights_ ? weights_size_ : 0);
+  }
 
   const Arc* Arcs(StateId s) const noexcept { return states_[s].arcs; }
 
@@ -115,7 +126,8 @@ class ImmutableFstImpl : public internal::FstImpl<A> {
 
   std::unique_ptr<State[]> states_;
   std::unique_ptr<Arc[]> arcs_;
-  std::unique_ptr<irs::byte_type[]> weights_;
+  std::unique_ptr<irs::byte_type[]> weights_;  // nullptr if weights are shared
+  size_t weights_size_{0};                     // Total size of weights.
   size_t narcs_;                               // Number of arcs.
   StateId nstates_;                            // Number of states.
   StateId start_;                              // Initial state.
@@ -124,8 +136,13 @@ class ImmutableFstImpl : public internal::FstImpl<A> {
   ImmutableFstImpl &operator=(const ImmutableFstImpl &) = delete;
 };
 
+// If 'share_weights' is set, weights are referenced directly in the
+// 'stream' buffer whenever the stream provides persistent access to its
+// data (e.g. memory mapped input), the caller is then responsible for
+// keeping the stream alive while FST is in use.
 template<typename Arc>
-std::shared_ptr<ImmutableFstImpl<Arc>> ImmutableFstImpl<Arc>::Read(irs::data_input& stream) {
+std::shared_ptr<ImmutableFstImpl<Arc>> ImmutableFstImpl<Arc>::Read(
+    irs::data_input& stream, bool share_weights) {
   auto impl = std::make_shared<ImmutableFstImpl<Arc>>();
 
   // read header
@@ -141,28 +158,44 @@ std::shared_ptr<ImmutableFstImpl<Arc>> ImmutableFstImpl<Arc>::Read(irs::data_inp
 
   auto states = std::make_unique<State[]>(nstates);
   auto arcs = std::make_unique<Arc[]>(narcs);
-  auto weights = std::make_unique<irs::byte_type[]>(total_weight_size);
 
-  // read states & arcs
-  auto* weight = weights.get();
+  // read states & arcs, weights are bound once their location is known
   auto* arc = arcs.get();
   for (auto state = states.get(), end = state + nstates; state != end; ++state) {
     state->arcs = arc;
     state->narcs = stream.read_byte(); // FIXME total number of arcs can be encoded with 1 byte
-    state->weight = { weight, stream.read_vlong() };
-
-    weight += state->weight.Size();
+    state->weight = { nullptr, stream.read_vlong() };
 
     for (auto* end = arc + state->narcs; arc != end; ++arc) {
       arc->ilabel = stream.read_byte();
       arc->nextstate = stream.read_vint();
-      arc->weight = { weight, stream.read_vlong() };
-      weight += arc->weight.Size();
+      arc->weight = { nullptr, stream.read_vlong() };
     }
   }
 
   // read weights
-  stream.read_bytes(weights.get(), total_weight_size);
+  std::unique_ptr<irs::byte_type[]> weights;
+  const irs::byte_type* weight = share_weights
+    ? stream.read_buffer(total_weight_size, irs::BufferHint::PERSISTENT)
+    : nullptr;
+
+  if (!weight) {
+    weights = std::make_unique<irs::byte_type[]>(total_weight_size);
+    stream.read_bytes(weights.get(), total_weight_size);
+    weight = weights.get();
+  }
+
+  // bind weights in the order they were written
+  arc = arcs.get();
+  for (auto state = states.get(), end = state + nstates; state != end; ++state) {
+    state->weight = { weight, state->weight.Size() };
+    weight += state->weight.Size();
+
+    for (auto* end = arc + state->narcs; arc != end; ++arc) {
+      arc->weight = { weight, arc->weight.Size() };
+      weight += arc->weight.Size();
+    }
+  }
 
   // noexcept block
   impl->properties_ = props;
@@ -172,10 +205,43 @@ std::shared_ptr<ImmutableFstImpl<Arc>> ImmutableFstImpl<Arc>::Read(irs::data_inp
   impl->states_ = std::move(states);
   impl->arcs_ = std::move(arcs);
   impl->weights_ = std::move(weights);
+  impl->weights_size_ = total_weight_size;
 
   return impl;
 }
 
+// Moves 'stream' past the FST without materializing it.
+template<typename Arc>
+bool ImmutableFstImpl<Arc>::Skip(irs::index_input& stream) {
+  // read header
+  if (Version(stream.read_byte()) != Version::MIN) {
+    return false;
+  }
+
+  stream.read_long(); // properties
+  const size_t total_weight_size = stream.read_long();
+  stream.read_vint(); // start state
+  const size_t nstates = stream.read_vlong();
+  stream.read_vlong(); // number of arcs
+
+  // skip states & arcs
+  for (size_t state = 0; state < nstates; ++state) {
+    size_t narcs = stream.read_byte();
+    stream.read_vlong(); // final weight size
+
+    for (; narcs; --narcs) {
+      stream.read_byte();
+      stream.read_vint();
+      stream.read_vlong();
+    }
+  }
+
+  // skip weights
+  stream.seek(stream.file_pointer() + total_weight_size);
+
+  return true;
+}
+
 template<typename A>
 class ImmutableFst : public ImplToExpandedFst<ImmutableFstImpl<A>> {
  public:
@@ -200,11 +266,16 @@ class ImmutableFst : public ImplToExpandedFst<ImmutableFstImpl<A>> {
     return new ImmutableFst<A>(*this, safe);
   }
 
-  static ImmutableFst<A>* Read(irs::data_input& strm) {
-    auto impl = Impl::Read(strm);
+  static ImmutableFst<A>* Read(irs::data_input& strm,
+                               bool share_weights = false) {
+    auto impl = Impl::Read(strm, share_weights);
     return impl ? new ImmutableFst<A>(std::move(impl)) : nullptr;
   }
 
+  static bool Skip(irs::index_input& strm) {
+    return Impl::Skip(strm);
+  }
+
   // for OpenFST API compliance
   static ImmutableFst<A>* Read(std::istream& strm,
                                const FstReadOptions& /*opts*/) {
@@ -24,6 +24,7 @@
 #include "mmap_utils.hpp"
 #include "utils/log.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 namespace iresearch {
@@ -58,6 +59,26 @@ int flush(int fd, void* addr, size_t size, int flags) noexcept {
   return 0;
 }
 
+bool mmap_handle::advise(int advice, size_t offset, size_t length) noexcept {
+  if (addr_ == MAP_FAILED || offset >= size_) {
+    return false;
+  }
+
+#ifdef _MSC_VER
+  static const size_t page_size = 4096;
+#else
+  static const size_t page_size = size_t(sysconf(_SC_PAGESIZE));
+#endif
+
+  length = (std::min)(length, size_ - offset);
+
+  // madvise(...) requires page aligned address
+  const size_t begin = offset - offset % page_size;
+
+  return 0 == ::madvise(static_cast<byte_type*>(addr_) + begin,
+                        offset + length - begin, advice);
+}
+
 void mmap_handle::close() noexcept {
   if (addr_ != MAP_FAILED) {
     if (dontneed_) {
@@ -78,7 +99,7 @@ void mmap_handle::init() noexcept {
   dontneed_ = false;
 }
 
-bool mmap_handle::open(const file_path_t path) noexcept {
+bool mmap_handle::open(const file_path_t path, int flags /*= 0*/) noexcept {
   assert(path);
 
   close();
@@ -105,7 +126,7 @@ bool mmap_handle::open(const file_path_t path) noexcept {
   if (size) {
     size_ = size;
 
-    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | flags, fd, 0);
 
     if (MAP_FAILED == addr) {
       IR_FRMT_ERROR("Failed to mmap input file, error: %d, path: " IR_FILEPATH_SPECIFIER, errno, path);
@@ -39,6 +39,9 @@
 #define IR_MADVICE_WILLNEED 0
 #define IR_MADVICE_DONTNEED 0
 #define IR_MADVICE_DONTDUMP 0
+#define IR_MADVICE_HUGEPAGE 0
+
+#define IR_MMAP_POPULATE 0
 
 #else
 
@@ -76,6 +79,20 @@
 #define IR_MADVICE_RANDOM MADV_RANDOM
 #define IR_MADVICE_WILLNEED MADV_WILLNEED
 #define IR_MADVICE_DONTNEED MADV_DONTNEED
+#ifdef MADV_HUGEPAGE
+#define IR_MADVICE_HUGEPAGE MADV_HUGEPAGE
+#else
+#define IR_MADVICE_HUGEPAGE 0
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief mmap flag to pre-fault pages of a mapping
+////////////////////////////////////////////////////////////////////////////////
+#ifdef MAP_POPULATE
+#define IR_MMAP_POPULATE MAP_POPULATE
+#else
+#define IR_MMAP_POPULATE 0
+#endif
 
 #endif // _MSC_VER
 
@@ -100,7 +117,8 @@ class IRESEARCH_API mmap_handle : private util::noncopyable {
     close();
   }
 
-  bool open(const file_path_t file) noexcept;
+  // @param flags additional flags for mmap(...), e.g. IR_MMAP_POPULATE
+  bool open(const file_path_t file, int flags = 0) noexcept;
   void close() noexcept;
 
   explicit operator bool() const noexcept {
@@ -121,6 +139,14 @@ class IRESEARCH_API mmap_handle : private util::noncopyable {
     return 0 == ::madvise(addr_, size_, advice);
   }
 
+  // applies 'advice' to the pages covering the specified region
+  bool advise(int advice, size_t offset, size_t length) noexcept;
+
+  // locks mapped pages in memory, they're unlocked on close
+  bool lock() noexcept {
+    return MAP_FAILED == addr_ || 0 == ::mlock(addr_, size_);
+  }
+
   void dontneed(bool value) noexcept {
     dontneed_ = value;
   }
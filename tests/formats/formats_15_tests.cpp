@@ -0,0 +1,1018 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "formats_test_case_base.hpp"
+#include "formats/format_utils.hpp"
+#include "formats/formats_10.hpp"
+#include "formats/formats_10_attributes.hpp"
+#include "formats/formats_burst_trie.hpp"
+#include "search/score.hpp"
+#include "utils/block_cache.hpp"
+
+namespace {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                          format 15 specific tests
+// -----------------------------------------------------------------------------
+
+class format_15_test_case : public tests::format_test_case {
+ protected:
+  static constexpr size_t BLOCK_SIZE = 128;
+
+  struct freq_attribute_provider : irs::attribute_provider {
+    irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+      if (type == irs::type<irs::frequency>::id()) {
+        return freq;
+      }
+      if (type == irs::type<irs::term_meta>::id()) {
+        return meta;
+      }
+      return nullptr;
+    }
+
+    irs::frequency* freq{};
+    irs::term_meta* meta{};
+  };
+
+  // postings with document specific frequencies
+  class freq_postings final : public irs::doc_iterator {
+   public:
+    typedef std::vector<std::pair<irs::doc_id_t, uint32_t>> docs_t;
+
+    explicit freq_postings(const docs_t& docs) noexcept
+      : next_(docs.begin()), end_(docs.end()) {
+    }
+
+    virtual bool next() override {
+      if (next_ == end_) {
+        doc_ = irs::doc_limits::eof();
+        return false;
+      }
+
+      doc_ = next_->first;
+      freq_.value = next_->second;
+      ++next_;
+      return true;
+    }
+
+    virtual irs::doc_id_t value() const override {
+      return doc_;
+    }
+
+    virtual irs::doc_id_t seek(irs::doc_id_t target) override {
+      irs::seek(*this, target);
+      return value();
+    }
+
+    virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+      return irs::type<irs::frequency>::id() == type ? &freq_ : nullptr;
+    }
+
+   private:
+    docs_t::const_iterator next_;
+    docs_t::const_iterator end_;
+    irs::frequency freq_;
+    irs::doc_id_t doc_{ irs::doc_limits::invalid() };
+  }; // freq_postings
+
+  // max frequency of the documents in range (prev, last]
+  static uint32_t max_freq(
+      const freq_postings::docs_t& docs,
+      irs::doc_id_t prev,
+      irs::doc_id_t last) {
+    uint32_t max = 0;
+    for (auto& doc : docs) {
+      if (doc.first > prev && doc.first <= last) {
+        max = std::max(max, doc.second);
+      }
+    }
+    return max;
+  }
+
+  void assert_block_impact(const freq_postings::docs_t& docs) {
+    const irs::flags features{ irs::type<irs::frequency>::get() };
+    auto dir = get_directory(*this);
+    auto codec = std::dynamic_pointer_cast<const irs::version10::format>(get_codec());
+    ASSERT_NE(nullptr, codec);
+    auto writer = codec->get_postings_writer(false);
+    ASSERT_NE(nullptr, writer);
+    irs::postings_writer::state term_meta; // must be destroyed before the writer
+
+    uint32_t total_freq = 0;
+    for (auto& doc : docs) {
+      total_freq += doc.second;
+    }
+
+    // write postings
+    {
+      irs::flush_state state;
+      state.dir = dir.get();
+      state.doc_count = docs.back().first + 1;
+      state.name = "segment_name";
+      state.features = &features;
+
+      auto out = dir->create("attributes");
+      ASSERT_FALSE(!out);
+
+      writer->prepare(*out, state);
+      writer->begin_field(features);
+      freq_postings it(docs);
+      term_meta = writer->write(it);
+      writer->encode(*out, *term_meta);
+      writer->end();
+    }
+
+    // read postings
+    irs::segment_meta meta;
+    meta.name = "segment_name";
+
+    irs::reader_state state;
+    state.dir = dir.get();
+    state.meta = &meta;
+
+    auto in = dir->open("attributes", irs::IOAdvice::NORMAL);
+    ASSERT_FALSE(!in);
+
+    auto reader = codec->get_postings_reader();
+    ASSERT_NE(nullptr, reader);
+    reader->prepare(*in, state, features);
+
+    irs::bstring in_data(in->length() - in->file_pointer(), 0);
+    in->read_bytes(&in_data[0], in_data.size());
+
+    irs::frequency freq;
+    irs::version10::term_meta read_meta;
+    freq_attribute_provider read_attrs;
+    read_attrs.freq = &freq;
+    read_attrs.meta = &read_meta;
+    reader->decode(in_data.c_str(), features, read_attrs, read_meta);
+    ASSERT_EQ(total_freq, freq.value);
+
+    // no impacts without frequencies
+    {
+      auto it = reader->iterator(irs::flags::empty_instance(), read_attrs, irs::flags::empty_instance());
+      ASSERT_EQ(nullptr, irs::get<irs::block_impact>(*it));
+    }
+
+    // shallow seek to every document
+    {
+      auto it = reader->iterator(features, read_attrs, features);
+      auto* impact = irs::get_mutable<irs::block_impact>(it.get());
+      ASSERT_NE(nullptr, impact);
+
+      irs::doc_id_t prev = irs::doc_limits::invalid();
+      irs::doc_id_t last = irs::doc_limits::invalid();
+      for (size_t i = 0; i < docs.size(); ++i) {
+        const auto target = docs[i].first;
+
+        if (last < target) {
+          prev = last;
+          last = impact->shallow_seek(target);
+          ASSERT_EQ(last, impact->doc);
+
+          const size_t block_end = (i / BLOCK_SIZE + 1) * BLOCK_SIZE;
+
+          if (block_end < docs.size()) {
+            // block is covered by skip-list
+            ASSERT_EQ(docs[block_end - 1].first, last);
+            ASSERT_EQ(max_freq(docs, prev, last), impact->max_freq);
+          } else {
+            ASSERT_TRUE(irs::doc_limits::eof(last));
+            ASSERT_EQ(total_freq, impact->max_freq);
+          }
+        }
+
+        ASSERT_LE(docs[i].second, impact->max_freq);
+        ASSERT_EQ(target, it->seek(target));
+        ASSERT_EQ(docs[i].second, irs::get<irs::frequency>(*it)->value);
+      }
+      ASSERT_FALSE(it->next());
+    }
+
+    // shallow seek ahead of the iterator
+    {
+      auto it = reader->iterator(features, read_attrs, features);
+      auto* impact = irs::get_mutable<irs::block_impact>(it.get());
+      ASSERT_NE(nullptr, impact);
+
+      for (size_t i = BLOCK_SIZE/2; i < docs.size(); i += BLOCK_SIZE/2) {
+        const auto value = it->value();
+        const auto target = docs[i].first;
+        ASSERT_LE(target, impact->shallow_seek(target));
+        ASSERT_LE(docs[i].second, impact->max_freq);
+        ASSERT_EQ(value, it->value()); // iterator isn't moved by shallow seek
+
+        ASSERT_EQ(target, it->seek(target));
+        ASSERT_EQ(docs[i].second, irs::get<irs::frequency>(*it)->value);
+        if (i + 1 < docs.size()) {
+          ASSERT_TRUE(it->next());
+          ASSERT_EQ(docs[i + 1].first, it->value());
+        }
+      }
+    }
+
+    // skip non-competitive blocks
+    {
+      auto it = reader->iterator(features, read_attrs, features);
+      auto* impact = irs::get_mutable<irs::block_impact>(it.get());
+      ASSERT_NE(nullptr, impact);
+
+      const uint32_t threshold = 2;
+      auto expected = docs.begin();
+      for (irs::doc_id_t target = irs::doc_limits::min();;) {
+        const auto last = impact->shallow_seek(target);
+
+        if (impact->max_freq < threshold) {
+          if (irs::doc_limits::eof(last)) {
+            break;
+          }
+
+          target = last + 1;
+          continue;
+        }
+
+        const auto doc = it->seek(target);
+
+        for (; expected != docs.end() && expected->first < doc; ++expected) {
+          ASSERT_GT(threshold, expected->second);
+        }
+
+        if (irs::doc_limits::eof(doc)) {
+          break;
+        }
+
+        ASSERT_NE(docs.end(), expected);
+        ASSERT_EQ(expected->first, doc);
+        ASSERT_EQ(expected->second, irs::get<irs::frequency>(*it)->value);
+        ++expected;
+        target = doc + 1;
+      }
+
+      for (; expected != docs.end(); ++expected) {
+        ASSERT_GT(threshold, expected->second);
+      }
+    }
+  }
+
+  void assert_next_block(const freq_postings::docs_t& docs) {
+    const irs::flags features{ irs::type<irs::frequency>::get() };
+    auto dir = get_directory(*this);
+    auto codec = std::dynamic_pointer_cast<const irs::version10::format>(get_codec());
+    ASSERT_NE(nullptr, codec);
+    auto writer = codec->get_postings_writer(false);
+    ASSERT_NE(nullptr, writer);
+    irs::postings_writer::state term_meta; // must be destroyed before the writer
+
+    // write postings
+    {
+      irs::flush_state state;
+      state.dir = dir.get();
+      state.doc_count = docs.back().first + 1;
+      state.name = "segment_name";
+      state.features = &features;
+
+      auto out = dir->create("attributes");
+      ASSERT_FALSE(!out);
+
+      writer->prepare(*out, state);
+      writer->begin_field(features);
+      freq_postings it(docs);
+      term_meta = writer->write(it);
+      writer->encode(*out, *term_meta);
+      writer->end();
+    }
+
+    // read postings
+    irs::segment_meta meta;
+    meta.name = "segment_name";
+
+    irs::reader_state state;
+    state.dir = dir.get();
+    state.meta = &meta;
+
+    auto in = dir->open("attributes", irs::IOAdvice::NORMAL);
+    ASSERT_FALSE(!in);
+
+    auto reader = codec->get_postings_reader();
+    ASSERT_NE(nullptr, reader);
+    reader->prepare(*in, state, features);
+
+    irs::bstring in_data(in->length() - in->file_pointer(), 0);
+    in->read_bytes(&in_data[0], in_data.size());
+
+    irs::frequency freq;
+    irs::version10::term_meta read_meta;
+    freq_attribute_provider read_attrs;
+    read_attrs.freq = &freq;
+    read_attrs.meta = &read_meta;
+    reader->decode(in_data.c_str(), features, read_attrs, read_meta);
+
+    // blocks with and without frequencies
+    for (auto& read_features : { features, irs::flags::empty_instance() }) {
+      auto it = reader->iterator(features, read_attrs, read_features);
+      auto* doc_freq = irs::get<irs::frequency>(*it);
+      ASSERT_EQ(read_features.check<irs::frequency>(), nullptr != doc_freq);
+
+      auto expected = docs.begin();
+      for (auto block = it->next_block(); !block.empty(); block = it->next_block()) {
+        ASSERT_LE(block.size, BLOCK_SIZE);
+        ASSERT_EQ(nullptr != doc_freq, nullptr != block.freqs);
+
+        for (size_t i = 0; i < block.size; ++i, ++expected) {
+          ASSERT_NE(docs.end(), expected);
+          ASSERT_EQ(expected->first, block.docs[i]);
+          if (block.freqs) {
+            ASSERT_EQ(expected->second, block.freqs[i]);
+          }
+        }
+
+        // iterator is positioned at the last document of the block
+        ASSERT_EQ(block.docs[block.size - 1], it->value());
+        if (doc_freq) {
+          ASSERT_EQ(block.freqs[block.size - 1], doc_freq->value);
+        }
+      }
+      ASSERT_EQ(docs.end(), expected);
+      ASSERT_TRUE(irs::doc_limits::eof(it->value()));
+      ASSERT_TRUE(it->next_block().empty());
+      ASSERT_FALSE(it->next());
+    }
+
+    // blocks mixed with 'next()' and 'seek(...)'
+    {
+      auto it = reader->iterator(features, read_attrs, features);
+      auto* doc_freq = irs::get<irs::frequency>(*it);
+      ASSERT_NE(nullptr, doc_freq);
+
+      size_t i = 0;
+      for (size_t step = 0; i < docs.size(); ++step) {
+        switch (step % 3) {
+          case 0: {
+            ASSERT_TRUE(it->next());
+            ASSERT_EQ(docs[i].first, it->value());
+            ASSERT_EQ(docs[i].second, doc_freq->value);
+            ++i;
+          } break;
+          case 1: {
+            const auto block = it->next_block();
+            ASSERT_FALSE(block.empty());
+            for (size_t j = 0; j < block.size; ++j, ++i) {
+              ASSERT_EQ(docs[i].first, block.docs[j]);
+              ASSERT_EQ(docs[i].second, block.freqs[j]);
+            }
+          } break;
+          case 2: {
+            i = std::min(docs.size() - 1, i + BLOCK_SIZE/3);
+            ASSERT_EQ(docs[i].first, it->seek(docs[i].first));
+            ASSERT_EQ(docs[i].second, doc_freq->value);
+            ++i;
+          } break;
+        }
+      }
+      ASSERT_TRUE(it->next_block().empty());
+      ASSERT_TRUE(irs::doc_limits::eof(it->value()));
+    }
+  }
+
+  void assert_exclude(
+      const freq_postings::docs_t& docs,
+      const irs::document_mask& mask) {
+    const irs::flags features{ irs::type<irs::frequency>::get() };
+    auto dir = get_directory(*this);
+    auto codec = std::dynamic_pointer_cast<const irs::version10::format>(get_codec());
+    ASSERT_NE(nullptr, codec);
+    auto writer = codec->get_postings_writer(false);
+    ASSERT_NE(nullptr, writer);
+    irs::postings_writer::state term_meta; // must be destroyed before the writer
+
+    // write postings
+    {
+      irs::flush_state state;
+      state.dir = dir.get();
+      state.doc_count = docs.back().first + 1;
+      state.name = "segment_name";
+      state.features = &features;
+
+      auto out = dir->create("attributes");
+      ASSERT_FALSE(!out);
+
+      writer->prepare(*out, state);
+      writer->begin_field(features);
+      freq_postings it(docs);
+      term_meta = writer->write(it);
+      writer->encode(*out, *term_meta);
+      writer->end();
+    }
+
+    // read postings
+    irs::segment_meta meta;
+    meta.name = "segment_name";
+
+    irs::reader_state state;
+    state.dir = dir.get();
+    state.meta = &meta;
+
+    auto in = dir->open("attributes", irs::IOAdvice::NORMAL);
+    ASSERT_FALSE(!in);
+
+    auto reader = codec->get_postings_reader();
+    ASSERT_NE(nullptr, reader);
+    reader->prepare(*in, state, features);
+
+    irs::bstring in_data(in->length() - in->file_pointer(), 0);
+    in->read_bytes(&in_data[0], in_data.size());
+
+    irs::frequency freq;
+    irs::version10::term_meta read_meta;
+    freq_attribute_provider read_attrs;
+    read_attrs.freq = &freq;
+    read_attrs.meta = &read_meta;
+    reader->decode(in_data.c_str(), features, read_attrs, read_meta);
+
+    freq_postings::docs_t live;
+    for (auto& doc : docs) {
+      if (!mask.contains(doc.first)) {
+        live.emplace_back(doc);
+      }
+    }
+
+    // next
+    for (auto& read_features : { features, irs::flags::empty_instance() }) {
+      auto it = reader->iterator(features, read_attrs, read_features);
+      ASSERT_TRUE(it->exclude(mask));
+      auto* doc_freq = irs::get<irs::frequency>(*it);
+
+      for (auto& expected : live) {
+        ASSERT_TRUE(it->next());
+        ASSERT_EQ(expected.first, it->value());
+        if (doc_freq) {
+          ASSERT_EQ(expected.second, doc_freq->value);
+        }
+      }
+      ASSERT_FALSE(it->next());
+      ASSERT_TRUE(irs::doc_limits::eof(it->value()));
+    }
+
+    // next_block
+    for (auto& read_features : { features, irs::flags::empty_instance() }) {
+      auto it = reader->iterator(features, read_attrs, read_features);
+      ASSERT_TRUE(it->exclude(mask));
+      auto* doc_freq = irs::get<irs::frequency>(*it);
+
+      auto expected = live.begin();
+      for (auto block = it->next_block(); !block.empty(); block = it->next_block()) {
+        for (size_t i = 0; i < block.size; ++i, ++expected) {
+          ASSERT_NE(live.end(), expected);
+          ASSERT_EQ(expected->first, block.docs[i]);
+          if (block.freqs) {
+            ASSERT_EQ(expected->second, block.freqs[i]);
+          }
+        }
+
+        // iterator is positioned at the last live document of the block
+        ASSERT_EQ(block.docs[block.size - 1], it->value());
+        if (doc_freq) {
+          ASSERT_EQ(block.freqs[block.size - 1], doc_freq->value);
+        }
+      }
+      ASSERT_EQ(live.end(), expected);
+      ASSERT_TRUE(irs::doc_limits::eof(it->value()));
+    }
+
+    // seek to every document, masked documents lead to the next live one
+    for (auto& target : docs) {
+      auto it = reader->iterator(features, read_attrs, features);
+      ASSERT_TRUE(it->exclude(mask));
+      auto* doc_freq = irs::get<irs::frequency>(*it);
+      ASSERT_NE(nullptr, doc_freq);
+
+      auto expected = std::lower_bound(
+        live.begin(), live.end(), target,
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+      if (expected == live.end()) {
+        ASSERT_TRUE(irs::doc_limits::eof(it->seek(target.first)));
+        continue;
+      }
+
+      ASSERT_EQ(expected->first, it->seek(target.first));
+      ASSERT_EQ(expected->second, doc_freq->value);
+
+      // mix 'next()' and 'next_block()' after 'seek(...)'
+      for (++expected; expected != live.end(); ++expected) {
+        ASSERT_TRUE(it->next());
+        ASSERT_EQ(expected->first, it->value());
+        ASSERT_EQ(expected->second, doc_freq->value);
+
+        const auto block = it->next_block();
+        for (size_t i = 0; i < block.size; ++i) {
+          ASSERT_NE(live.end(), ++expected);
+          ASSERT_EQ(expected->first, block.docs[i]);
+          ASSERT_EQ(expected->second, block.freqs[i]);
+        }
+
+        if (block.empty()) {
+          break;
+        }
+      }
+      ASSERT_FALSE(it->next());
+    }
+  }
+}; // format_15_test_case
+
+TEST_P(format_15_test_case, postings_block_impact) {
+  // single block
+  {
+    freq_postings::docs_t docs;
+    for (irs::doc_id_t i = irs::doc_limits::min(); i < 100; ++i) {
+      docs.emplace_back(i, 1 + i % 13);
+    }
+
+    assert_block_impact(docs);
+  }
+
+  // several blocks with distinct max frequencies
+  {
+    freq_postings::docs_t docs;
+    for (irs::doc_id_t i = 0; i < 20 * BLOCK_SIZE + 17; ++i) {
+      const uint32_t block = i / BLOCK_SIZE;
+      docs.emplace_back(2*i + irs::doc_limits::min(), 1 + (i*7 + block*3) % (5 + block % 9));
+    }
+
+    assert_block_impact(docs);
+  }
+
+  // multi-level skip-list, some blocks have small frequencies only
+  {
+    freq_postings::docs_t docs;
+    for (irs::doc_id_t i = 0; i < 70 * BLOCK_SIZE; ++i) {
+      const uint32_t block = i / BLOCK_SIZE;
+      docs.emplace_back(i + irs::doc_limits::min(), 0 == block % 4 ? 1 + i % 50 : 1);
+    }
+
+    assert_block_impact(docs);
+  }
+}
+
+TEST_P(format_15_test_case, postings_next_block) {
+  for (const size_t count : { size_t(1), size_t(5), BLOCK_SIZE, BLOCK_SIZE + 1,
+                              3*BLOCK_SIZE, 3*BLOCK_SIZE + 17 }) {
+    freq_postings::docs_t docs;
+    for (size_t i = 0; i < count; ++i) {
+      docs.emplace_back(irs::doc_id_t(2*i + irs::doc_limits::min()), uint32_t(1 + i % 5));
+    }
+
+    assert_next_block(docs);
+  }
+}
+
+TEST_P(format_15_test_case, postings_exclude) {
+  for (const size_t count : { size_t(1), size_t(5), BLOCK_SIZE, 3*BLOCK_SIZE + 17 }) {
+    freq_postings::docs_t docs;
+    for (size_t i = 0; i < count; ++i) {
+      docs.emplace_back(irs::doc_id_t(2*i + irs::doc_limits::min()), uint32_t(1 + i % 5));
+    }
+
+    // every third document is masked
+    {
+      irs::document_mask mask;
+      for (size_t i = 0; i < count; i += 3) {
+        mask.insert(docs[i].first);
+      }
+
+      assert_exclude(docs, mask);
+    }
+
+    // whole block is masked along with the tail of the postings
+    {
+      irs::document_mask mask;
+      for (size_t i = 0; i < count; ++i) {
+        if ((i >= BLOCK_SIZE && i < 2*BLOCK_SIZE) || i + 10 >= count) {
+          mask.insert(docs[i].first);
+        }
+      }
+
+      assert_exclude(docs, mask);
+    }
+
+    // nothing but the first and the last documents are masked
+    {
+      irs::document_mask mask{ docs.front().first, docs.back().first };
+
+      assert_exclude(docs, mask);
+    }
+  }
+}
+
+TEST_P(format_15_test_case, postings_block_impact_format14) {
+  // segments written by the previous formats don't have block impacts,
+  // simd and non-simd formats use different postings encoding
+  // (note that "1_4simd" writes non-simd postings)
+  const bool simd = "1_5simd" == get_codec()->type().name();
+  auto codec = std::dynamic_pointer_cast<const irs::version10::format>(
+    irs::formats::get(simd ? "1_3simd" : "1_4", "1_0"));
+  ASSERT_NE(nullptr, codec);
+
+  const irs::flags features{ irs::type<irs::frequency>::get() };
+  auto dir = get_directory(*this);
+  auto writer = codec->get_postings_writer(false);
+  ASSERT_NE(nullptr, writer);
+  irs::postings_writer::state term_meta; // must be destroyed before the writer
+
+  freq_postings::docs_t docs;
+  uint32_t total_freq = 0;
+  for (irs::doc_id_t i = 0; i < 3 * BLOCK_SIZE; ++i) {
+    docs.emplace_back(i + irs::doc_limits::min(), 1 + i % 7);
+    total_freq += docs.back().second;
+  }
+
+  {
+    irs::flush_state state;
+    state.dir = dir.get();
+    state.doc_count = docs.back().first + 1;
+    state.name = "segment_name";
+    state.features = &features;
+
+    auto out = dir->create("attributes");
+    ASSERT_FALSE(!out);
+
+    writer->prepare(*out, state);
+    writer->begin_field(features);
+    freq_postings it(docs);
+    term_meta = writer->write(it);
+    writer->encode(*out, *term_meta);
+    writer->end();
+  }
+
+  irs::segment_meta meta;
+  meta.name = "segment_name";
+
+  irs::reader_state state;
+  state.dir = dir.get();
+  state.meta = &meta;
+
+  auto in = dir->open("attributes", irs::IOAdvice::NORMAL);
+  ASSERT_FALSE(!in);
+
+  // read with the reader of the current format
+  auto current_codec = std::dynamic_pointer_cast<const irs::version10::format>(get_codec());
+  ASSERT_NE(nullptr, current_codec);
+  auto reader = current_codec->get_postings_reader();
+  ASSERT_NE(nullptr, reader);
+  reader->prepare(*in, state, features);
+
+  irs::bstring in_data(in->length() - in->file_pointer(), 0);
+  in->read_bytes(&in_data[0], in_data.size());
+
+  irs::frequency freq;
+  irs::version10::term_meta read_meta;
+  freq_attribute_provider read_attrs;
+  read_attrs.freq = &freq;
+  read_attrs.meta = &read_meta;
+  reader->decode(in_data.c_str(), features, read_attrs, read_meta);
+
+  auto it = reader->iterator(features, read_attrs, features);
+  auto* impact = irs::get_mutable<irs::block_impact>(it.get());
+  ASSERT_NE(nullptr, impact);
+
+  // block boundaries are still known, total term frequency is the bound
+  ASSERT_EQ(docs[BLOCK_SIZE - 1].first, impact->shallow_seek(docs[1].first));
+  ASSERT_EQ(total_freq, impact->max_freq);
+  ASSERT_EQ(docs[2*BLOCK_SIZE - 1].first, impact->shallow_seek(docs[BLOCK_SIZE].first));
+  ASSERT_EQ(total_freq, impact->max_freq);
+
+  for (auto& doc : docs) {
+    ASSERT_EQ(doc.first, it->seek(doc.first));
+    ASSERT_EQ(doc.second, irs::get<irs::frequency>(*it)->value);
+  }
+}
+
+TEST_P(format_15_test_case, document_mask_rw_dense_invalid_size) {
+  irs::document_mask mask_set;
+  irs::segment_meta meta("_1", nullptr);
+  meta.version = 42;
+  meta.docs_count = 10000;
+
+  for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= meta.docs_count; ++doc) {
+    mask_set.insert(doc);
+  }
+
+  {
+    auto writer = codec()->get_document_mask_writer();
+    writer->write(dir(), meta, mask_set);
+  }
+
+  auto reader = codec()->get_document_mask_reader();
+
+  // the bitset is sized by documents which can't belong to the segment
+  {
+    meta.docs_count = 1000;
+    irs::document_mask expected;
+    ASSERT_THROW(reader->read(dir(), meta, expected), irs::index_error);
+    ASSERT_TRUE(expected.empty());
+  }
+
+  {
+    meta.docs_count = 10000;
+    irs::document_mask expected;
+    ASSERT_TRUE(reader->read(dir(), meta, expected));
+    ASSERT_EQ(mask_set, expected);
+  }
+}
+
+TEST_P(format_15_test_case, document_mask_rw_dense_invalid_count) {
+  irs::document_mask mask_set;
+  irs::segment_meta meta("_1", nullptr);
+  meta.version = 42;
+  meta.docs_count = 10000;
+
+  for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= meta.docs_count; ++doc) {
+    mask_set.insert(doc);
+  }
+
+  {
+    auto writer = codec()->get_document_mask_writer();
+    writer->write(dir(), meta, mask_set);
+  }
+
+  std::string name;
+  ASSERT_TRUE(dir().visit([&name](std::string& file) {
+    name = std::move(file);
+    return true;
+  }));
+  ASSERT_FALSE(name.empty());
+
+  // read the mask file and find the number of masked documents
+  irs::bstring data;
+  size_t count_offset;
+  {
+    auto in = dir().open(name, irs::IOAdvice::NORMAL);
+    ASSERT_FALSE(!in);
+    data.resize(in->length());
+    ASSERT_EQ(data.size(), in->read_bytes(&data[0], data.size()));
+
+    // skip header: magic, format name, version
+    in->seek(0);
+    in->read_int();
+    irs::read_string<std::string>(*in);
+    in->read_int();
+    count_offset = in->file_pointer();
+    ASSERT_EQ(mask_set.size(), in->read_vint());
+  }
+
+  auto reader = codec()->get_document_mask_reader();
+
+  // the number of masked documents mismatches the bitset in either direction
+  for (const uint32_t count : { uint32_t(mask_set.size() - 1), uint32_t(mask_set.size() + 1) }) {
+    SCOPED_TRACE(count);
+
+    {
+      irs::bstring encoded;
+      irs::bytes_output encoded_out(encoded);
+      encoded_out.write_vint(count);
+      ASSERT_EQ(2, encoded.size()); // same length as the original value
+      std::memcpy(&data[count_offset], encoded.c_str(), encoded.size());
+
+      auto file = dir().create(name);
+      ASSERT_FALSE(!file);
+      file->write_bytes(data.c_str(), data.size());
+    }
+
+    irs::document_mask expected;
+    ASSERT_THROW(reader->read(dir(), meta, expected), irs::index_error);
+    ASSERT_TRUE(expected.empty());
+  }
+}
+
+TEST_P(format_15_test_case, fields_term_index_lazy_checksum) {
+  // counts bytes read via inputs of term indices
+  class read_tracking_input final : public irs::index_input {
+   public:
+    read_tracking_input(irs::index_input::ptr&& impl, size_t& count)
+      : impl_(std::move(impl)), count_(&count) {
+    }
+
+    virtual irs::byte_type read_byte() override {
+      ++*count_;
+      return impl_->read_byte();
+    }
+    virtual size_t read_bytes(irs::byte_type* b, size_t count) override {
+      const auto read = impl_->read_bytes(b, count);
+      *count_ += read;
+      return read;
+    }
+    virtual const irs::byte_type* read_buffer(size_t count, irs::BufferHint hint) override {
+      const auto* buf = impl_->read_buffer(count, hint);
+      *count_ += buf ? count : 0;
+      return buf;
+    }
+    virtual size_t file_pointer() const override { return impl_->file_pointer(); }
+    virtual size_t length() const override { return impl_->length(); }
+    virtual bool eof() const override { return impl_->eof(); }
+    virtual ptr dup() const override {
+      return irs::memory::make_unique<read_tracking_input>(impl_->dup(), *count_);
+    }
+    virtual ptr reopen() const override {
+      return irs::memory::make_unique<read_tracking_input>(impl_->reopen(), *count_);
+    }
+    virtual void seek(size_t pos) override { impl_->seek(pos); }
+    virtual int64_t checksum(size_t offset) const override {
+      *count_ += (std::min)(offset, length() - file_pointer());
+      return impl_->checksum(offset);
+    }
+
+   private:
+    irs::index_input::ptr impl_;
+    size_t* count_;
+  };
+
+  class read_tracking_directory final : public tests::directory_mock {
+   public:
+    explicit read_tracking_directory(irs::directory& impl)
+      : tests::directory_mock(impl) {
+    }
+
+    virtual irs::index_input::ptr open(
+        const std::string& name,
+        irs::IOAdvice advice) const noexcept override {
+      auto in = tests::directory_mock::open(name, advice);
+
+      if (in && is_term_index(name)) {
+        return irs::memory::make_unique<read_tracking_input>(std::move(in), count);
+      }
+
+      return in;
+    }
+
+    static bool is_term_index(const std::string& name) {
+      constexpr irs::string_ref EXT = ".ti";
+
+      return name.size() > EXT.size()
+        && 0 == name.compare(name.size() - EXT.size(), EXT.size(), EXT.c_str());
+    }
+
+    mutable size_t count{ 0 };
+  };
+
+  // term index consists mostly of FST of a single field
+  constexpr size_t TERMS = 10000;
+
+  {
+    auto writer = open_writer(irs::OM_CREATE);
+
+    for (size_t i = 0; i < TERMS; ++i) {
+      char term[6];
+      std::snprintf(term, sizeof term, "%05u", unsigned(i));
+      tests::templates::string_field field("name", term);
+
+      ASSERT_TRUE(tests::insert(*writer, &field, &field + 1));
+    }
+
+    writer->commit();
+  }
+
+  ASSERT_EQ(irs::burst_trie::TermIndexMode::EAGER, irs::burst_trie::term_index_mode());
+  auto restore_mode = irs::make_finally([]() {
+    irs::burst_trie::term_index_mode(irs::burst_trie::TermIndexMode::EAGER);
+  });
+
+  std::string name;
+  ASSERT_TRUE(dir().visit([&name](std::string& file) {
+    if (read_tracking_directory::is_term_index(file)) {
+      name = std::move(file);
+    }
+    return true;
+  }));
+  ASSERT_FALSE(name.empty());
+
+  uint64_t length;
+  ASSERT_TRUE(dir().length(length, name));
+
+  read_tracking_directory dir(this->dir());
+
+  for (auto mode : { irs::burst_trie::TermIndexMode::EAGER,
+                     irs::burst_trie::TermIndexMode::LAZY,
+                     irs::burst_trie::TermIndexMode::LAZY_EVICTABLE }) {
+    irs::burst_trie::term_index_mode(mode);
+    dir.count = 0;
+
+    auto reader = irs::directory_reader::open(dir, codec());
+    ASSERT_EQ(1, reader.size());
+
+    if (irs::burst_trie::TermIndexMode::EAGER == mode) {
+      // the whole term index is verified and read on open
+      ASSERT_LT(length, dir.count);
+      continue;
+    }
+
+    // only the footer and fields metadata are read on open
+    const auto read = dir.count;
+    ASSERT_GT(length / 2, read);
+
+    // FST is verified and read on the first access
+    auto* field = reader[0].field("name");
+    ASSERT_NE(nullptr, field);
+    ASSERT_NE(nullptr, field->iterator());
+    ASSERT_LT(read + length / 2, dir.count);
+
+    irs::block_cache::instance().clear();
+  }
+
+  // corrupt checksum of the last FST, it's followed by fields count and footer
+  {
+    irs::bstring data(length, 0);
+
+    {
+      auto in = this->dir().open(name, irs::IOAdvice::NORMAL);
+      ASSERT_FALSE(!in);
+      ASSERT_EQ(length, in->read_bytes(&data[0], data.size()));
+    }
+
+    data[length - sizeof(uint64_t) - irs::format_utils::FOOTER_LEN - 1] ^= 0xFF;
+
+    auto out = this->dir().create(name);
+    ASSERT_FALSE(!out);
+    out->write_bytes(data.c_str(), data.size());
+  }
+
+  irs::burst_trie::term_index_mode(irs::burst_trie::TermIndexMode::EAGER);
+  ASSERT_THROW(irs::directory_reader::open(dir, codec()), irs::index_error);
+
+  for (auto mode : { irs::burst_trie::TermIndexMode::LAZY,
+                     irs::burst_trie::TermIndexMode::LAZY_EVICTABLE }) {
+    irs::burst_trie::term_index_mode(mode);
+
+    auto reader = irs::directory_reader::open(dir, codec());
+    ASSERT_EQ(1, reader.size());
+    auto* field = reader[0].field("name");
+    ASSERT_NE(nullptr, field);
+    ASSERT_THROW(field->iterator(), irs::index_error);
+  }
+}
+
+// Separate definition as MSVC parser fails to do conditional defines in macro expansion
+#if defined(IRESEARCH_SSE2)
+const auto format_15_test_case_values = ::testing::Values(tests::format_info{"1_5", "1_0"},
+                                                          tests::format_info{"1_5simd", "1_0"});
+#else
+const auto format_15_test_case_values = ::testing::Values(tests::format_info{"1_5", "1_0"});
+#endif
+
+INSTANTIATE_TEST_CASE_P(
+  format_15_test,
+  format_15_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::fs_directory,
+      &tests::mmap_directory
+    ),
+    format_15_test_case_values
+  ),
+  tests::to_string
+);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     generic tests
+// -----------------------------------------------------------------------------
+
+using tests::format_test_case;
+
+INSTANTIATE_TEST_CASE_P(
+  format_15_test,
+  format_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::fs_directory,
+      &tests::mmap_directory,
+      &tests::async_directory,
+      &tests::rot13_cipher_directory<&tests::memory_directory, 16>,
+      &tests::rot13_cipher_directory<&tests::mmap_directory, 16>
+    ),
+    format_15_test_case_values
+  ),
+  tests::to_string
+);
+
+}
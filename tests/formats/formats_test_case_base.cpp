@@ -22,8 +22,14 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "formats_test_case_base.hpp"
+#include "formats/formats_burst_trie.hpp"
+#include "store/mmap_directory.hpp"
+#include "utils/block_cache.hpp"
+#include "utils/encryption.hpp"
 #include "utils/lz4compression.hpp"
 
+#include <thread>
+
 namespace tests {
 
 TEST_P(format_test_case, directory_artifact_cleaner) {
@@ -456,6 +462,257 @@ TEST_P(format_test_case, fields_seek_ge) {
   }
 }
 
+TEST_P(format_test_case, fields_seek_repeated) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory);
+  add_segment(gen);
+
+  auto reader = open_reader();
+  ASSERT_EQ(1, reader->size());
+  auto& segment = reader[0];
+  auto* field = segment.field("duplicated");
+  ASSERT_NE(nullptr, field);
+
+  // term, docs count, first document
+  std::vector<std::tuple<irs::bstring, uint32_t, irs::doc_id_t>> expected_terms;
+
+  // extract all terms
+  {
+    auto it = field->iterator();
+    ASSERT_NE(nullptr, it);
+
+    while (it->next()) {
+      it->read();
+      auto* meta = irs::get<irs::term_meta>(*it);
+      ASSERT_NE(nullptr, meta);
+      auto docs = it->postings(irs::flags::empty_instance());
+      ASSERT_TRUE(docs->next());
+      expected_terms.emplace_back(it->value(), meta->docs_count, docs->value());
+    }
+    ASSERT_EQ(field->size(), expected_terms.size());
+  }
+
+  // repeated lookups of the same terms must produce the same state
+  for (size_t i = 0; i < 3; ++i) {
+    for (auto expected = expected_terms.begin(); expected != expected_terms.end(); ++expected) {
+      auto it = field->iterator();
+      ASSERT_NE(nullptr, it);
+      ASSERT_TRUE(it->seek(std::get<0>(*expected)));
+      ASSERT_EQ(irs::bytes_ref(std::get<0>(*expected)), it->value());
+      it->read();
+      auto* meta = irs::get<irs::term_meta>(*it);
+      ASSERT_NE(nullptr, meta);
+      ASSERT_EQ(std::get<1>(*expected), meta->docs_count);
+      auto docs = it->postings(irs::flags::empty_instance());
+      ASSERT_TRUE(docs->next());
+      ASSERT_EQ(std::get<2>(*expected), docs->value());
+
+      // iteration continues after the looked up term
+      if (std::next(expected) != expected_terms.end()) {
+        ASSERT_TRUE(it->next());
+        ASSERT_EQ(irs::bytes_ref(std::get<0>(*std::next(expected))), it->value());
+      } else {
+        ASSERT_FALSE(it->next());
+      }
+    }
+  }
+}
+
+TEST_P(format_test_case, fields_term_index_modes) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory);
+  add_segment(gen);
+
+  ASSERT_EQ(irs::burst_trie::TermIndexMode::EAGER, irs::burst_trie::term_index_mode());
+  auto restore_mode = irs::make_finally([]() {
+    irs::burst_trie::term_index_mode(irs::burst_trie::TermIndexMode::EAGER);
+  });
+
+  // field name -> terms
+  std::map<std::string, std::vector<irs::bstring>> expected_terms;
+
+  {
+    auto reader = open_reader();
+    ASSERT_EQ(1, reader->size());
+    auto& segment = reader[0];
+
+    for (auto fields = segment.fields(); fields->next(); ) {
+      auto& terms = expected_terms[fields->value().meta().name];
+
+      for (auto it = fields->value().iterator(); it->next(); ) {
+        terms.emplace_back(it->value());
+      }
+      ASSERT_FALSE(terms.empty());
+    }
+    ASSERT_FALSE(expected_terms.empty());
+  }
+
+  for (auto mode : { irs::burst_trie::TermIndexMode::EAGER,
+                     irs::burst_trie::TermIndexMode::LAZY,
+                     irs::burst_trie::TermIndexMode::LAZY_EVICTABLE }) {
+    irs::burst_trie::term_index_mode(mode);
+
+    auto reader = open_reader();
+    ASSERT_EQ(1, reader->size());
+    auto& segment = reader[0];
+
+    // fields are accessed in reverse order to load lazily read FSTs
+    // not in the order they're stored
+    for (auto entry = expected_terms.rbegin(); entry != expected_terms.rend(); ++entry) {
+      auto* field = segment.field(entry->first);
+      ASSERT_NE(nullptr, field);
+
+      // evicted FSTs are read again on the next access
+      for (size_t i = 0; i < 2; ++i) {
+        auto it = field->iterator();
+        ASSERT_NE(nullptr, it);
+
+        for (auto& term : entry->second) {
+          ASSERT_TRUE(it->next());
+          ASSERT_EQ(irs::bytes_ref(term), it->value());
+        }
+        ASSERT_FALSE(it->next());
+
+        for (auto& term : entry->second) {
+          auto seek_it = field->iterator();
+          ASSERT_NE(nullptr, seek_it);
+          ASSERT_TRUE(seek_it->seek(term));
+          ASSERT_EQ(irs::bytes_ref(term), seek_it->value());
+        }
+
+        irs::block_cache::instance().clear();
+      }
+    }
+  }
+}
+
+TEST_P(format_test_case, fields_blocks_cache) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    &tests::generic_json_field_factory);
+  add_segment(gen);
+
+  auto reader = open_reader();
+  ASSERT_EQ(1, reader->size());
+  auto& segment = reader[0];
+  auto* field = segment.field("name");
+  ASSERT_NE(nullptr, field);
+
+  auto& cache = irs::block_cache::instance();
+  cache.clear();
+
+  size_t count = 0;
+  for (auto it = field->iterator(); it->next(); ++count) { }
+  ASSERT_EQ(field->size(), count);
+
+  // memory mapped blocks are read in place rather than cached
+  if (dynamic_cast<irs::mmap_directory*>(&dir())
+      && !irs::get_encryption(dir().attributes())) {
+    ASSERT_EQ(0, cache.stats().count);
+  } else if (dynamic_cast<irs::fs_directory*>(&dir())
+             || irs::get_encryption(dir().attributes())) {
+    ASSERT_LT(0, cache.stats().count);
+  }
+}
+
+TEST_P(format_test_case, fields_prefetch_blocks) {
+  // counts prefetch hints issued via inputs of term dictionaries
+  class prefetch_tracking_input final : public irs::index_input {
+   public:
+    prefetch_tracking_input(irs::index_input::ptr&& impl, std::atomic<size_t>& count)
+      : impl_(std::move(impl)), count_(&count) {
+    }
+
+    virtual irs::byte_type read_byte() override { return impl_->read_byte(); }
+    virtual size_t read_bytes(irs::byte_type* b, size_t count) override {
+      return impl_->read_bytes(b, count);
+    }
+    virtual const irs::byte_type* read_buffer(size_t count, irs::BufferHint hint) override {
+      return impl_->read_buffer(count, hint);
+    }
+    virtual size_t file_pointer() const override { return impl_->file_pointer(); }
+    virtual size_t length() const override { return impl_->length(); }
+    virtual bool eof() const override { return impl_->eof(); }
+    virtual ptr dup() const override {
+      return irs::memory::make_unique<prefetch_tracking_input>(impl_->dup(), *count_);
+    }
+    virtual ptr reopen() const override {
+      return irs::memory::make_unique<prefetch_tracking_input>(impl_->reopen(), *count_);
+    }
+    virtual void seek(size_t pos) override { impl_->seek(pos); }
+    virtual int64_t checksum(size_t offset) const override {
+      return impl_->checksum(offset);
+    }
+    virtual void prefetch(size_t offset, size_t length) const noexcept override {
+      ++*count_;
+      impl_->prefetch(offset, length);
+    }
+
+   private:
+    irs::index_input::ptr impl_;
+    std::atomic<size_t>* count_;
+  };
+
+  class prefetch_tracking_directory final : public tests::directory_mock {
+   public:
+    explicit prefetch_tracking_directory(irs::directory& impl)
+      : tests::directory_mock(impl) {
+    }
+
+    virtual irs::index_input::ptr open(
+        const std::string& name,
+        irs::IOAdvice advice) const noexcept override {
+      auto in = tests::directory_mock::open(name, advice);
+
+      constexpr irs::string_ref EXT = ".tm";
+
+      if (in && name.size() > EXT.size()
+          && 0 == name.compare(name.size() - EXT.size(), EXT.size(), EXT.c_str())) {
+        return irs::memory::make_unique<prefetch_tracking_input>(std::move(in), count);
+      }
+
+      return in;
+    }
+
+    mutable std::atomic<size_t> count{ 0 };
+  };
+
+  // 100 terms sharing each of 2 byte prefixes are split into floor blocks
+  constexpr size_t TERMS = 1000;
+
+  {
+    auto writer = open_writer(irs::OM_CREATE);
+
+    for (size_t i = 0; i < TERMS; ++i) {
+      char term[4];
+      std::snprintf(term, sizeof term, "%03u", unsigned(i));
+      templates::string_field field("name", term);
+
+      ASSERT_TRUE(insert(*writer, &field, &field + 1));
+    }
+
+    writer->commit();
+  }
+
+  prefetch_tracking_directory dir(this->dir());
+  auto reader = irs::directory_reader::open(dir, codec());
+  ASSERT_EQ(1, reader.size());
+  auto* field = reader[0].field("name");
+  ASSERT_NE(nullptr, field);
+  ASSERT_EQ(TERMS, field->size());
+
+  irs::block_cache::instance().clear();
+  ASSERT_EQ(0, dir.count);
+
+  // the following sub-blocks are prefetched while the terms are enumerated
+  size_t count = 0;
+  for (auto it = field->iterator(); it->next(); ++count) { }
+  ASSERT_EQ(TERMS, count);
+  ASSERT_LT(0, dir.count);
+}
+
 TEST_P(format_test_case, fields_read_write) {
   /*
     Term dictionary structure:
@@ -1077,6 +1334,248 @@ TEST_P(format_test_case, columns_rw_sparse_column_dense_block) {
   }
 }
 
+TEST_P(format_test_case, columns_rw_values_shared) {
+  irs::segment_meta seg("_1", codec());
+  const irs::doc_id_t MAX_DOC = 20000;
+  const irs::doc_id_t GAP = 7777; // makes one of the columns sparse
+
+  size_t dense_id;
+  size_t sparse_id;
+
+  // write docs
+  {
+    auto writer = codec()->get_columnstore_writer();
+    writer->prepare(dir(), seg);
+    const irs::column_info info{
+      irs::type<irs::compression::lz4>::get(),
+      irs::compression::options(),
+      bool(irs::get_encryption(dir().attributes()))
+    };
+    auto dense = writer->push_column(info);
+    auto sparse = writer->push_column(info);
+    dense_id = dense.first;
+    sparse_id = sparse.first;
+
+    for (auto id = irs::doc_limits::min(); id <= MAX_DOC; ++id, ++seg.docs_count) {
+      const auto value = std::to_string(id);
+      dense.second(id).write_bytes(
+        reinterpret_cast<const irs::byte_type*>(value.c_str()), value.size());
+
+      if (id != GAP) {
+        sparse.second(id).write_bytes(
+          reinterpret_cast<const irs::byte_type*>(value.c_str()), value.size());
+      }
+    }
+
+    ASSERT_TRUE(writer->commit());
+  }
+
+  auto reader = codec()->get_columnstore_reader();
+  ASSERT_TRUE(reader->prepare(dir(), seg));
+
+  for (const auto column_id : { dense_id, sparse_id }) {
+    auto column = reader->column(column_id);
+    ASSERT_NE(nullptr, column);
+    auto values = column->values();
+
+    // a returned value stays valid until the next call
+    // even if its block is evicted from the cache
+    irs::bytes_ref actual;
+    for (auto id = irs::doc_limits::min(); id <= MAX_DOC; ++id) {
+      ASSERT_EQ(column_id == dense_id || id != GAP, values(id, actual));
+
+      if (column_id == dense_id || id != GAP) {
+        irs::block_cache::instance().clear();
+        ASSERT_EQ(irs::string_ref(std::to_string(id)), irs::ref_cast<char>(actual));
+      }
+    }
+
+    // readers of a column may be used concurrently
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i) {
+      threads.emplace_back([&, i]() {
+        auto values = column->values();
+        irs::bytes_ref value;
+
+        for (auto id = irs::doc_id_t(irs::doc_limits::min() + i); id <= MAX_DOC; id += 4) {
+          if (column_id == sparse_id && id == GAP) {
+            continue;
+          }
+
+          if (!values(id, value)
+              || irs::string_ref(std::to_string(id)) != irs::ref_cast<char>(value)) {
+            failed = true;
+          }
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    ASSERT_FALSE(failed);
+  }
+}
+
+TEST_P(format_test_case, columns_rw_values_cache_budget) {
+  irs::segment_meta seg("_1", codec());
+  const irs::doc_id_t MAX_DOC = 4096;
+  const size_t COLUMNS = 64;
+  const std::string PAD(100, 'x'); // makes blocks of all columns exceed the budget
+
+  std::vector<irs::field_id> ids;
+
+  // write docs
+  {
+    auto writer = codec()->get_columnstore_writer();
+    writer->prepare(dir(), seg);
+    const irs::column_info info{
+      irs::type<irs::compression::lz4>::get(),
+      irs::compression::options(),
+      bool(irs::get_encryption(dir().attributes()))
+    };
+
+    std::vector<irs::columnstore_writer::values_writer_f> columns;
+    for (size_t i = 0; i < COLUMNS; ++i) {
+      auto column = writer->push_column(info);
+      ids.emplace_back(column.first);
+      columns.emplace_back(std::move(column.second));
+    }
+
+    for (auto id = irs::doc_limits::min(); id <= MAX_DOC; ++id, ++seg.docs_count) {
+      const auto value = std::to_string(id) + PAD;
+
+      for (auto& column : columns) {
+        column(id).write_bytes(
+          reinterpret_cast<const irs::byte_type*>(value.c_str()), value.size());
+      }
+    }
+
+    ASSERT_TRUE(writer->commit());
+  }
+
+  auto& cache = irs::block_cache::instance();
+  const size_t budget = cache.budget();
+  auto restore_budget = irs::make_finally([&cache, budget]() {
+    cache.budget(budget);
+  });
+  const size_t LIMIT = size_t(1) << 20;
+  cache.clear();
+  cache.budget(LIMIT);
+
+  auto reader = codec()->get_columnstore_reader();
+  ASSERT_TRUE(reader->prepare(dir(), seg));
+
+  // values readers of all columns are alive at the same time
+  std::vector<irs::columnstore_reader::values_reader_f> readers;
+  for (const auto id : ids) {
+    auto column = reader->column(id);
+    ASSERT_NE(nullptr, column);
+    readers.emplace_back(column->values());
+  }
+
+  const auto evictions = cache.stats().evictions;
+  irs::bytes_ref actual;
+
+  for (auto id = irs::doc_limits::min(); id <= MAX_DOC; ++id) {
+    const auto expected = std::to_string(id) + PAD;
+
+    for (auto& values : readers) {
+      ASSERT_TRUE(values(id, actual));
+      ASSERT_EQ(irs::string_ref(expected), irs::ref_cast<char>(actual));
+    }
+
+    ASSERT_GE(LIMIT, cache.stats().size);
+  }
+
+  // blocks read via values readers are subject to eviction
+  ASSERT_LT(evictions, cache.stats().evictions);
+}
+
+TEST_P(format_test_case, columns_rw_zero_copy) {
+  // serves every file from an in-memory copy via persistent buffers
+  class persistent_directory final : public tests::directory_mock {
+   public:
+    explicit persistent_directory(irs::directory& impl)
+      : tests::directory_mock(impl) {
+    }
+
+    virtual irs::index_input::ptr open(
+        const std::string& name,
+        irs::IOAdvice advice) const noexcept override {
+      auto in = tests::directory_mock::open(name, advice);
+
+      if (!in) {
+        return nullptr;
+      }
+
+      auto& data = files.emplace_back(in->length(), 0);
+      in->read_bytes(&data[0], data.size());
+
+      return irs::memory::make_unique<irs::bytes_ref_input>(data);
+    }
+
+    // returns true if 'value' references data of any of the opened files
+    bool contains(const irs::bytes_ref& value) const noexcept {
+      return std::any_of(
+        files.begin(), files.end(),
+        [&value](const irs::bstring& data) {
+          return value.begin() >= data.data()
+              && value.end() <= data.data() + data.size();
+      });
+    }
+
+    mutable std::deque<irs::bstring> files;
+  };
+
+  irs::segment_meta seg("_1", codec());
+  const irs::doc_id_t MAX_DOC = 5000;
+  const bool encrypted = nullptr != irs::get_encryption(dir().attributes());
+
+  size_t column_id;
+
+  {
+    auto writer = codec()->get_columnstore_writer();
+    writer->prepare(dir(), seg);
+    auto column = writer->push_column({
+      irs::type<irs::compression::none>::get(),
+      irs::compression::options(),
+      encrypted
+    });
+    column_id = column.first;
+
+    for (auto id = irs::doc_limits::min(); id <= MAX_DOC; ++id, ++seg.docs_count) {
+      const auto value = std::to_string(id);
+      column.second(id).write_bytes(
+        reinterpret_cast<const irs::byte_type*>(value.c_str()), value.size());
+    }
+
+    ASSERT_TRUE(writer->commit());
+  }
+
+  persistent_directory dir(this->dir());
+  auto reader = codec()->get_columnstore_reader();
+  ASSERT_TRUE(reader->prepare(dir, seg));
+  ASSERT_FALSE(dir.files.empty());
+
+  auto column = reader->column(column_id);
+  ASSERT_NE(nullptr, column);
+  auto values = column->values();
+
+  irs::block_cache::instance().clear();
+
+  for (auto id = irs::doc_limits::min(); id <= MAX_DOC; ++id) {
+    irs::bytes_ref value;
+    ASSERT_TRUE(values(id, value));
+    ASSERT_EQ(irs::string_ref(std::to_string(id)), irs::ref_cast<char>(value));
+
+    // uncompressed blocks are referenced in place unless they're encrypted
+    ASSERT_EQ(!encrypted, dir.contains(value));
+  }
+}
+
 TEST_P(format_test_case, columns_rw_dense_mask) {
   irs::segment_meta seg("_1", codec());
   const irs::doc_id_t MAX_DOC = 1026;
@@ -3166,7 +3665,7 @@ TEST_P(format_test_case, columns_meta_rw) {
 }
 
 TEST_P(format_test_case, document_mask_rw) {
-  const std::unordered_set<irs::doc_id_t> mask_set = { 1, 4, 5, 7, 10, 12 };
+  const irs::document_mask mask_set = { 1, 4, 5, 7, 10, 12 };
   irs::segment_meta meta("_1", nullptr);
   meta.version = 42;
 
@@ -3182,10 +3681,49 @@ TEST_P(format_test_case, document_mask_rw) {
     auto reader = codec()->get_document_mask_reader();
     irs::document_mask expected;
     EXPECT_TRUE(reader->read(dir(), meta, expected));
+    EXPECT_EQ(mask_set.size(), expected.size());
     for (auto id : mask_set) {
-      EXPECT_EQ(1, expected.erase(id));
+      EXPECT_TRUE(expected.contains(id));
+    }
+    EXPECT_EQ(mask_set, expected);
+  }
+}
+
+TEST_P(format_test_case, document_mask_rw_dense) {
+  constexpr irs::doc_id_t DOCS_COUNT = 1 << 20;
+  irs::document_mask mask_set;
+  irs::segment_meta meta("_1", nullptr);
+  meta.version = 42;
+  meta.docs_count = DOCS_COUNT;
+
+  // mask most of the documents, e.g. after a bulk update
+  for (irs::doc_id_t doc = irs::doc_limits::min(); doc <= DOCS_COUNT; ++doc) {
+    if (doc % 7) {
+      mask_set.insert(doc);
     }
-    EXPECT_TRUE(expected.empty());
+  }
+
+  // write document_mask
+  {
+    auto writer = codec()->get_document_mask_writer();
+
+    writer->write(dir(), meta, mask_set);
+  }
+
+  // read document_mask
+  {
+    auto reader = codec()->get_document_mask_reader();
+    irs::document_mask expected;
+    EXPECT_TRUE(reader->read(dir(), meta, expected));
+    EXPECT_EQ(mask_set, expected);
+
+    // read into non-empty mask
+    irs::document_mask merged = { 7, DOCS_COUNT + 1 };
+    EXPECT_TRUE(reader->read(dir(), meta, merged));
+    EXPECT_EQ(mask_set.size() + 2, merged.size());
+    EXPECT_TRUE(merged.contains(7));
+    EXPECT_TRUE(merged.contains(DOCS_COUNT + 1));
+    EXPECT_FALSE(merged.contains(14));
   }
 }
 
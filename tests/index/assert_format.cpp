@@ -262,7 +262,7 @@ void document_mask_writer::write(
 ) {
   EXPECT_EQ(data_.doc_mask().size(), docs_mask.size());
   for (auto doc_id : docs_mask) {
-    EXPECT_EQ(true, data_.doc_mask().find(doc_id) != data_.doc_mask().end());
+    EXPECT_TRUE(data_.doc_mask().contains(doc_id));
   }
 }
 
@@ -27,6 +27,9 @@
 
 #include "tests_shared.hpp" 
 #include "iql/query_builder.hpp"
+#include "search/prefix_filter.hpp"
+#include "search/term_filter.hpp"
+#include "search/terms_filter.hpp"
 #include "store/memory_directory.hpp"
 #include "utils/index_utils.hpp"
 #include "utils/lz4compression.hpp"
@@ -2570,6 +2573,139 @@ TEST_P(index_test_case, concurrent_add_mt) {
   }
 }
 
+TEST_P(index_test_case, concurrent_flush_pool) {
+  irs::async_utils::thread_pool pool(1, 1);
+  irs::index_writer::init_options opts;
+  opts.flush_pool = &pool;
+
+  {
+    tests::json_doc_generator gen(resource("simple_sequential.json"), &tests::generic_json_field_factory);
+    add_segment(gen, irs::OM_CREATE, opts);
+  }
+
+  {
+    tests::json_doc_generator gen(resource("simple_sequential_utf8.json"), &tests::generic_json_field_factory);
+    add_segment(gen, irs::OM_APPEND, opts);
+  }
+
+  assert_index();
+
+  // stored columns are flushed along with the fields
+  auto reader = open_reader();
+  ASSERT_EQ(2, reader.size());
+
+  for (auto& segment : reader) {
+    auto* column = segment.column_reader("name");
+    ASSERT_NE(nullptr, column);
+    ASSERT_EQ(segment.docs_count(), column->size());
+  }
+}
+
+TEST_P(index_test_case, batched_modification_queries) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+    if (data.is_string()) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        irs::string_ref(name),
+        data.str
+      ));
+    }
+  });
+  std::vector<const tests::document*> docs;
+  for (const tests::document* doc; (doc = gen.next()) != nullptr; docs.emplace_back(doc)) {}
+  ASSERT_LE(28, docs.size());
+
+  auto by_name = [](const irs::string_ref& name,
+                    const irs::string_ref& field = "name") -> irs::filter::ptr {
+    auto filter = irs::memory::make_unique<irs::by_term>();
+    *filter->mutable_field() = field;
+    filter->mutable_options()->term = irs::ref_cast<irs::byte_type>(name);
+    return std::move(filter);
+  };
+
+  auto by_names = [](std::initializer_list<irs::string_ref> names) -> irs::filter::ptr {
+    auto filter = irs::memory::make_unique<irs::by_terms>();
+    *filter->mutable_field() = "name";
+    for (auto& name : names) {
+      filter->mutable_options()->terms.emplace(irs::ref_cast<irs::byte_type>(name));
+    }
+    return std::move(filter);
+  };
+
+  auto modify = [&](irs::async_utils::thread_pool* pool) {
+    irs::index_writer::init_options opts;
+    opts.flush_pool = pool;
+
+    irs::memory_directory dir;
+    auto writer = irs::index_writer::make(dir, codec(), irs::OM_CREATE, opts);
+
+    // 2 committed segments, 1 uncommitted
+    for (size_t i = 0; i < 26; ++i) {
+      auto& doc = *docs[i];
+      EXPECT_TRUE(insert(*writer, doc.indexed.begin(), doc.indexed.end()));
+
+      if (9 == i || 19 == i) {
+        writer->commit();
+      }
+    }
+
+    // unsorted, repeated and missing terms, terms of different fields and
+    // segments, terms matched by other modifications, non-term filters
+    writer->documents().remove(by_name("P"));
+    writer->documents().remove(by_name("B"));
+    writer->documents().remove(by_name("missing"));
+    writer->documents().remove(by_name("B"));
+    writer->documents().remove(by_name("~~~"));
+    writer->documents().remove(by_name("D", "same"));
+    writer->documents().remove(by_name("xyz", "duplicated"));
+    writer->documents().remove(by_names({ "X", "D", "missing", "Q", "P" }));
+    writer->documents().remove(by_names({ }));
+    {
+      auto filter = irs::memory::make_unique<irs::by_prefix>();
+      *filter->mutable_field() = "name";
+      filter->mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("Y"));
+      writer->documents().remove(irs::filter::ptr(std::move(filter)));
+    }
+    EXPECT_TRUE(update(*writer, by_name("C"), docs[26]->indexed.begin(), docs[26]->indexed.end()));
+    EXPECT_TRUE(update(*writer, by_name("missing"), docs[27]->indexed.begin(), docs[27]->indexed.end()));
+    writer->commit();
+
+    // live documents by their names
+    std::multiset<std::string> names;
+    auto reader = irs::directory_reader::open(dir, codec());
+    for (auto& segment : reader) {
+      auto* field = segment.field("name");
+      EXPECT_NE(nullptr, field);
+      if (!field) {
+        continue;
+      }
+
+      for (auto terms = field->iterator(); terms->next(); ) {
+        for (auto it = segment.mask(terms->postings(irs::flags::empty_instance())); it->next(); ) {
+          names.emplace(irs::ref_cast<char>(terms->value()));
+        }
+      }
+    }
+
+    return names;
+  };
+
+  std::multiset<std::string> expected;
+  for (size_t i = 0; i < 26; ++i) {
+    expected.emplace(docs[i]->indexed.get<tests::templates::string_field>("name")->value());
+  }
+  for (auto* name : { "B", "C", "D", "P", "Q", "X", "Y" }) {
+    expected.erase(name);
+  }
+  expected.emplace(docs[26]->indexed.get<tests::templates::string_field>("name")->value());
+
+  ASSERT_EQ(expected, modify(nullptr));
+
+  irs::async_utils::thread_pool pool(4, 4);
+  ASSERT_EQ(expected, modify(&pool));
+}
+
 TEST_P(index_test_case, concurrent_add_remove_mt) {
   tests::json_doc_generator gen(
     resource("simple_sequential.json"),
@@ -13691,6 +13827,30 @@ INSTANTIATE_TEST_CASE_P(
   tests::to_string
 );
 
+// Separate definition as MSVC parser fails to do conditional defines in macro expansion
+namespace {
+#if defined(IRESEARCH_SSE2)
+const auto index_test_case_15_values = ::testing::Values(tests::format_info{"1_5", "1_0"},
+                                                         tests::format_info{"1_5simd", "1_0"});
+#else
+const auto index_test_case_15_values = ::testing::Values(tests::format_info{"1_5", "1_0"});
+#endif
+}
+
+INSTANTIATE_TEST_CASE_P(
+  index_test_15,
+  index_test_case,
+  ::testing::Combine(
+    ::testing::Values(
+      tests::memory_directory,
+      &tests::rot13_cipher_directory<&tests::memory_directory, 16>,
+      &tests::rot13_cipher_directory<&tests::mmap_directory, 16>
+    ),
+    index_test_case_15_values
+  ),
+  tests::to_string
+);
+
 class index_test_case_10 : public tests::index_test_base { };
 
 TEST_P(index_test_case_10, commit_payload) {
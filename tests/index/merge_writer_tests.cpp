@@ -29,6 +29,7 @@
 #include "utils/lz4compression.hpp"
 #include "index/merge_writer.hpp"
 #include "index/comparer.hpp"
+#include "utils/async_utils.hpp"
 
 namespace tests {
   class merge_writer_tests: public ::testing::Test {
@@ -2248,6 +2249,76 @@ TEST_F(merge_writer_tests, test_merge_writer_add_segments) {
   }
 }
 
+TEST_F(merge_writer_tests, test_merge_writer_thread_pool) {
+  auto codec_ptr = irs::formats::get("1_0");
+  ASSERT_NE(nullptr, codec_ptr);
+  irs::memory_directory data_dir;
+
+  // populate directory
+  {
+    tests::json_doc_generator gen(
+      test_base::resource("simple_sequential.json"),
+      &tests::generic_json_field_factory
+    );
+
+    auto writer = irs::index_writer::make(data_dir, codec_ptr, irs::OM_CREATE);
+    const tests::document* doc;
+
+    while ((doc = gen.next())) {
+      ASSERT_TRUE(insert(
+        *writer,
+        doc->indexed.begin(), doc->indexed.end(),
+        doc->stored.begin(), doc->stored.end()
+      ));
+      writer->commit(); // create segmentN
+    }
+  }
+
+  auto reader = irs::directory_reader::open(data_dir, codec_ptr);
+  ASSERT_LT(1, reader.size());
+
+  irs::column_info_provider_t column_info = [](const irs::string_ref&) {
+    return irs::column_info(irs::type<irs::compression::lz4>::get(), irs::compression::options{}, true );
+  };
+
+  auto merge = [&](irs::directory& dir, irs::async_utils::thread_pool* pool) {
+    irs::index_meta::index_segment_t index_segment;
+    irs::merge_writer writer(dir, column_info, nullptr, pool);
+
+    for (auto& sub_reader: reader) {
+      writer.add(sub_reader);
+    }
+
+    index_segment.meta.codec = codec_ptr;
+    ASSERT_TRUE(writer.flush(index_segment));
+  };
+
+  irs::memory_directory expected_dir;
+  merge(expected_dir, nullptr);
+
+  irs::async_utils::thread_pool pool(1, 1);
+  irs::memory_directory actual_dir;
+  merge(actual_dir, &pool);
+
+  // merged segment must not depend on the pool
+  auto read_files = [](irs::directory& dir) {
+    std::map<std::string, std::string> files;
+    dir.visit([&dir, &files](std::string& name) {
+      auto in = dir.open(name, irs::IOAdvice::NORMAL);
+      EXPECT_NE(nullptr, in);
+      std::string data(in->length(), '\0');
+      in->read_bytes(reinterpret_cast<irs::byte_type*>(&data[0]), data.size());
+      files.emplace(name, std::move(data));
+      return true;
+    });
+    return files;
+  };
+
+  auto expected_files = read_files(expected_dir);
+  ASSERT_FALSE(expected_files.empty());
+  ASSERT_EQ(expected_files, read_files(actual_dir));
+}
+
 TEST_F(merge_writer_tests, test_merge_writer_flush_progress) {
   auto codec_ptr = irs::formats::get("1_0");
   ASSERT_NE(nullptr, codec_ptr);
@@ -52,19 +52,38 @@ void insert_find_core(const std::vector<std::string>& src) {
     const std::string& s = src[i];
     const bytes_ref b = detail::to_bytes_ref(s);
     auto res = bh.emplace(b);
-    ASSERT_NE(bh.end(), res.first);
-    ASSERT_EQ(b, res.first->first);
+    ASSERT_NE(nullptr, res.first);
+    ASSERT_EQ(b, res.first->term);
     ASSERT_TRUE(res.second);
 
     res = bh.emplace(b);
-    ASSERT_NE(bh.end(), res.first);
-    ASSERT_EQ(b, res.first->first);
+    ASSERT_NE(nullptr, res.first);
+    ASSERT_EQ(b, res.first->term);
     ASSERT_FALSE(res.second);
   }
 
   ASSERT_EQ(src.size(), bh.size());
   ASSERT_FALSE(bh.empty());
 
+  // terms are still found after the table has grown
+  for (auto& s : src) {
+    const bytes_ref b = detail::to_bytes_ref(s);
+    auto res = bh.emplace(b);
+    ASSERT_NE(nullptr, res.first);
+    ASSERT_EQ(b, res.first->term);
+    ASSERT_FALSE(res.second);
+  }
+  ASSERT_EQ(src.size(), bh.size());
+
+  // terms are iterated in order of insertion
+  auto it = bh.begin();
+  for (auto& s : src) {
+    ASSERT_NE(bh.end(), it);
+    ASSERT_EQ(detail::to_bytes_ref(s), it->term);
+    ++it;
+  }
+  ASSERT_EQ(bh.end(), it);
+
   // insert long key
   {
     const std::string long_str(block_size - irs::bytes_io<size_t>::vsize(32767), 'c');
@@ -140,7 +159,7 @@ TEST(postings_tests, slice_alignment) {
     auto res = bh.emplace(tests::detail::to_bytes_ref("string0"));
     ASSERT_FALSE(bh.empty());
     ASSERT_EQ(1, bh.size());
-    ASSERT_EQ(tests::detail::to_bytes_ref("string0"), bh.begin()->first);
+    ASSERT_EQ(tests::detail::to_bytes_ref("string0"), bh.begin()->term);
   }
 
   // read_write on reused pool
@@ -156,6 +175,6 @@ TEST(postings_tests, slice_alignment) {
     auto res = bh.emplace(tests::detail::to_bytes_ref("string1"));
     ASSERT_FALSE(bh.empty());
     ASSERT_EQ(1, bh.size());
-    ASSERT_EQ(tests::detail::to_bytes_ref("string1"), bh.begin()->first);
+    ASSERT_EQ(tests::detail::to_bytes_ref("string1"), bh.begin()->term);
   }
 }
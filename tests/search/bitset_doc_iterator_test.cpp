@@ -23,12 +23,102 @@
 
 #include "tests_shared.hpp"
 #include "filter_test_case_base.hpp"
+#include "index/document_mask.hpp"
 #include "utils/bitset.hpp"
 #include "utils/singleton.hpp"
 #include "search/bitset_doc_iterator.hpp"
+#include "search/conjunction.hpp"
+#include "search/disjunction.hpp"
+#include "search/exclusion.hpp"
 
 #ifndef IRESEARCH_DLL
 
+namespace {
+
+// forwards to a wrapped iterator, doesn't filter masked documents itself
+class unmaskable_doc_iterator final : public irs::doc_iterator {
+ public:
+  explicit unmaskable_doc_iterator(irs::doc_iterator::ptr&& it) noexcept
+    : it_(std::move(it)) {
+  }
+
+  virtual irs::attribute* get_mutable(irs::type_info::type_id type) override {
+    return it_->get_mutable(type);
+  }
+
+  virtual irs::doc_id_t value() const override { return it_->value(); }
+  virtual bool next() override { return it_->next(); }
+  virtual irs::doc_id_t seek(irs::doc_id_t target) override {
+    return it_->seek(target);
+  }
+
+ private:
+  irs::doc_iterator::ptr it_;
+}; // unmaskable_doc_iterator
+
+irs::doc_iterator::ptr make_bitset_iterator(
+    const irs::bitset& bs, bool maskable = true) {
+  auto it = irs::memory::make_managed<irs::bitset_doc_iterator>(bs);
+
+  if (maskable) {
+    return it;
+  }
+
+  return irs::memory::make_managed<unmaskable_doc_iterator>(std::move(it));
+}
+
+std::vector<irs::doc_id_t> read_docs(irs::doc_iterator& it) {
+  std::vector<irs::doc_id_t> docs;
+  while (it.next()) {
+    docs.push_back(it.value());
+  }
+  return docs;
+}
+
+template<typename Disjunction>
+void assert_exclude_disjunction(
+    const irs::bitset& lhs, const irs::bitset& rhs,
+    const irs::document_mask& mask) {
+  std::vector<irs::doc_id_t> expected;
+  for (irs::doc_id_t doc = 1; doc < lhs.size(); ++doc) {
+    if ((lhs.test(doc) || rhs.test(doc)) && !mask.contains(doc)) {
+      expected.push_back(doc);
+    }
+  }
+
+  // every sub-iterator filters masked documents
+  {
+    typename Disjunction::doc_iterators_t itrs;
+    itrs.emplace_back(make_bitset_iterator(lhs));
+    itrs.emplace_back(make_bitset_iterator(rhs));
+    auto it = irs::memory::make_managed<Disjunction>(std::move(itrs));
+    ASSERT_TRUE(it->exclude(mask));
+    ASSERT_EQ(expected, read_docs(*it));
+  }
+
+  // the caller has to filter masked documents of 'rhs'
+  {
+    typename Disjunction::doc_iterators_t itrs;
+    itrs.emplace_back(make_bitset_iterator(lhs));
+    itrs.emplace_back(make_bitset_iterator(rhs, false));
+    auto it = irs::memory::make_managed<Disjunction>(std::move(itrs));
+    ASSERT_FALSE(it->exclude(mask));
+
+    std::vector<irs::doc_id_t> actual;
+    for (const auto doc : read_docs(*it)) {
+      // masked documents of 'lhs' are still skipped
+      ASSERT_TRUE(rhs.test(doc) || !mask.contains(doc));
+
+      if (!mask.contains(doc)) {
+        actual.push_back(doc);
+      }
+    }
+    ASSERT_EQ(expected, actual);
+  }
+}
+
+}
+
 TEST(bitset_iterator_test, next) {
   auto& reader = irs::sub_reader::empty();
   const irs::byte_type* filter_attrs = irs::bytes_ref::EMPTY.c_str();
@@ -948,4 +1038,219 @@ TEST(bitset_iterator_test, seek_next) {
   }
 }
 
+TEST(bitset_iterator_test, next_block) {
+  auto& reader = irs::sub_reader::empty();
+  const irs::byte_type* filter_attrs = irs::bytes_ref::EMPTY.c_str();
+
+  // empty bitset
+  {
+    irs::bitset bs;
+    irs::bitset_doc_iterator it(
+      reader, filter_attrs, bs,
+      irs::order::prepared::unordered(), irs::no_boost());
+    ASSERT_TRUE(it.next_block().empty());
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+  }
+
+  // sparse bitset
+  {
+    const size_t size = 3*irs::bits_required<irs::bitset::word_t>() + 13;
+    irs::bitset bs(size);
+    std::vector<irs::doc_id_t> expected;
+    for (irs::doc_id_t i = 0; i < size; ++i) {
+      if (0 == i % 3 && (i < 64 || i >= 128)) { // 2nd word is empty
+        bs.set(i);
+        expected.emplace_back(i);
+      }
+    }
+
+    irs::bitset_doc_iterator it(
+      reader, filter_attrs, bs,
+      irs::order::prepared::unordered(), irs::no_boost());
+    auto* doc = irs::get<irs::document>(it);
+    ASSERT_NE(nullptr, doc);
+
+    std::vector<irs::doc_id_t> actual;
+    size_t blocks = 0;
+    for (auto block = it.next_block(); !block.empty(); block = it.next_block(), ++blocks) {
+      ASSERT_EQ(nullptr, block.freqs);
+      ASSERT_LE(block.size, irs::bits_required<irs::bitset::word_t>());
+      actual.insert(actual.end(), block.docs, block.docs + block.size);
+      ASSERT_EQ(block.docs[block.size - 1], it.value());
+      ASSERT_EQ(it.value(), doc->value);
+    }
+    ASSERT_EQ(3, blocks);
+    ASSERT_EQ(expected, actual);
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+    ASSERT_FALSE(it.next());
+  }
+
+  // blocks mixed with 'next()' and 'seek(...)'
+  {
+    const size_t size = 2*irs::bits_required<irs::bitset::word_t>();
+    irs::bitset bs(size);
+    for (irs::doc_id_t i = 0; i < size; ++i) {
+      bs.set(i);
+    }
+
+    irs::bitset_doc_iterator it(
+      reader, filter_attrs, bs,
+      irs::order::prepared::unordered(), irs::no_boost());
+
+    ASSERT_EQ(10, it.seek(10));
+    auto block = it.next_block();
+    ASSERT_EQ(53, block.size);
+    ASSERT_EQ(11, block.docs[0]);
+    ASSERT_EQ(63, it.value());
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(64, it.value());
+    block = it.next_block();
+    ASSERT_EQ(63, block.size);
+    ASSERT_EQ(65, block.docs[0]);
+    ASSERT_EQ(127, it.value());
+    ASSERT_TRUE(it.next_block().empty());
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+  }
+}
+
+TEST(bitset_iterator_test, owned_bitset) {
+  // empty bitset
+  {
+    irs::bitset_doc_iterator it(irs::bitset{});
+    ASSERT_EQ(0, irs::cost::extract(it));
+    ASSERT_TRUE(irs::score::get(it).is_default());
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+    ASSERT_FALSE(it.next());
+  }
+
+  // iterator owns a bitset
+  {
+    const size_t size = 3*irs::bits_required<irs::bitset::word_t>() + 13;
+    std::vector<irs::doc_id_t> expected;
+    irs::bitset bs(size);
+    for (irs::doc_id_t i = 1; i < size; i += 5) {
+      bs.set(i);
+      expected.push_back(i);
+    }
+
+    irs::bitset_doc_iterator it(std::move(bs));
+    ASSERT_EQ(expected.size(), irs::cost::extract(it));
+    ASSERT_EQ(irs::doc_limits::invalid(), it.value());
+
+    std::vector<irs::doc_id_t> actual;
+    while (it.next()) {
+      actual.push_back(it.value());
+    }
+    ASSERT_EQ(expected, actual);
+    ASSERT_EQ(expected[7], it.seek(expected[7]));
+  }
+}
+
+TEST(bitset_iterator_test, exclude) {
+  const size_t size = 4*irs::bits_required<irs::bitset::word_t>() + 13;
+  irs::bitset bs(size);
+  irs::document_mask mask;
+  std::vector<irs::doc_id_t> expected;
+  for (irs::doc_id_t i = 1; i < size; ++i) {
+    bs.set(i);
+
+    // mask a word entirely, every other document of the rest but the tail
+    // which isn't covered by the mask
+    if (i < 3*irs::bits_required<irs::bitset::word_t>() &&
+        (irs::bitset::word(i) == 1 || i % 2)) {
+      mask.insert(i);
+    } else {
+      expected.push_back(i);
+    }
+  }
+
+  // next
+  {
+    irs::bitset_doc_iterator it(bs);
+    ASSERT_TRUE(it.exclude(mask));
+
+    std::vector<irs::doc_id_t> actual;
+    while (it.next()) {
+      actual.push_back(it.value());
+    }
+    ASSERT_EQ(expected, actual);
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+  }
+
+  // next_block
+  {
+    irs::bitset_doc_iterator it(bs);
+    ASSERT_TRUE(it.exclude(mask));
+
+    std::vector<irs::doc_id_t> actual;
+    for (auto block = it.next_block(); !block.empty(); block = it.next_block()) {
+      actual.insert(actual.end(), block.docs, block.docs + block.size);
+      ASSERT_EQ(actual.back(), it.value());
+    }
+    ASSERT_EQ(expected, actual);
+  }
+
+  // seek
+  for (irs::doc_id_t target = 1; target < size; ++target) {
+    irs::bitset_doc_iterator it(bs);
+    ASSERT_TRUE(it.exclude(mask));
+
+    const auto doc = std::lower_bound(expected.begin(), expected.end(), target);
+    ASSERT_NE(expected.end(), doc);
+    ASSERT_EQ(*doc, it.seek(target));
+  }
+}
+
+TEST(bitset_iterator_test, exclude_compound) {
+  const size_t size = 3*irs::bits_required<irs::bitset::word_t>() + 7;
+  irs::bitset all(size), odd(size), even(size);
+  irs::document_mask mask;
+  for (irs::doc_id_t i = 1; i < size; ++i) {
+    all.set(i);
+    (i % 2 ? odd : even).set(i);
+
+    if (0 == i % 3) {
+      mask.insert(i);
+    }
+  }
+
+  auto expected = [&mask, size](const irs::bitset& bs) {
+    std::vector<irs::doc_id_t> docs;
+    for (irs::doc_id_t doc = 1; doc < size; ++doc) {
+      if (bs.test(doc) && !mask.contains(doc)) {
+        docs.push_back(doc);
+      }
+    }
+    return docs;
+  };
+
+  // conjunction skips documents masked by any of sub-iterators
+  for (const bool maskable : { true, false }) {
+    using conjunction_t = irs::conjunction<irs::doc_iterator::ptr>;
+
+    conjunction_t::doc_iterators_t itrs;
+    itrs.emplace_back(make_bitset_iterator(all, maskable));
+    itrs.emplace_back(make_bitset_iterator(odd));
+    auto it = irs::make_conjunction<conjunction_t>(std::move(itrs));
+    ASSERT_TRUE(it->exclude(mask));
+    ASSERT_EQ(expected(odd), read_docs(*it));
+  }
+
+  // disjunction skips documents masked by all of sub-iterators
+  assert_exclude_disjunction<irs::disjunction_iterator<irs::doc_iterator::ptr>>(odd, even, mask);
+  assert_exclude_disjunction<irs::disjunction<irs::doc_iterator::ptr>>(odd, even, mask);
+  assert_exclude_disjunction<irs::small_disjunction<irs::doc_iterator::ptr>>(odd, even, mask);
+
+  // exclusion relies on the included iterator only
+  for (const bool maskable : { true, false }) {
+    irs::exclusion it(make_bitset_iterator(all, maskable),
+                      make_bitset_iterator(odd, false));
+    ASSERT_EQ(maskable, it.exclude(mask));
+
+    if (maskable) {
+      ASSERT_EQ(expected(even), read_docs(it));
+    }
+  }
+}
+
 #endif
@@ -25,6 +25,7 @@
 #include "index/index_tests.hpp"
 #include "search/all_filter.hpp"
 #include "search/boolean_filter.hpp"
+#include "search/collectors.hpp"
 #include "search/column_existence_filter.hpp"
 #include "search/phrase_filter.hpp"
 #include "search/prefix_filter.hpp"
@@ -1370,6 +1371,306 @@ TEST_P(bm25_test, test_make) {
   }
 }
 
+TEST_P(bm25_test, test_max_score) {
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential_order.json"),
+      [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+        if (data.is_string()) { // field
+          doc.insert(std::make_shared<templates::string_field>(name, data.str), true, false);
+        } else if (data.is_number()) { // seq
+          const auto value = std::to_string(data.as_number<uint64_t>());
+          doc.insert(std::make_shared<templates::string_field>(name, value), false, true);
+        }
+    });
+    add_segment(gen);
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  auto& segment = *(reader.begin());
+
+  for (const bool boost_as_score : { false, true }) {
+    for (const float_t b : { 0.f, irs::bm25_sort::B() }) {
+      irs::order order;
+      order.add(true, std::make_unique<irs::bm25_sort>(irs::bm25_sort::K(), b, boost_as_score));
+      auto prepared_order = order.prepare();
+
+      for (const irs::string_ref term : { "0", "2", "7", "9" }) {
+        irs::by_term filter;
+        *filter.mutable_field() = "field";
+        filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+        filter.boost(1.5f);
+
+        auto prepared_filter = filter.prepare(reader, prepared_order);
+        auto docs = prepared_filter->execute(segment, prepared_order);
+        auto* score = irs::get<irs::score>(*docs);
+        ASSERT_NE(nullptr, score);
+        ASSERT_NE(irs::no_max_score(), score->max);
+        ASSERT_LE(0.f, score->max);
+
+        size_t count = 0;
+        for (; docs->next(); ++count) {
+          const auto score_value = *reinterpret_cast<const float_t*>(score->evaluate());
+          ASSERT_LE(score_value, score->max);
+        }
+        ASSERT_NE(0, count);
+      }
+    }
+  }
+
+  // ascending order doesn't support score bounds
+  {
+    irs::order order;
+    order.add<irs::bm25_sort>(false);
+    auto prepared_order = order.prepare();
+
+    irs::by_term filter;
+    *filter.mutable_field() = "field";
+    filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("7"));
+
+    auto prepared_filter = filter.prepare(reader, prepared_order);
+    auto docs = prepared_filter->execute(segment, prepared_order);
+    auto* score = irs::get<irs::score>(*docs);
+    ASSERT_NE(nullptr, score);
+    ASSERT_EQ(irs::no_max_score(), score->max);
+  }
+}
+
+TEST_P(bm25_test, test_score_block) {
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential_order.json"),
+      [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+        static irs::flags extra_features = { irs::type<irs::norm>::get() };
+
+        if (data.is_string()) { // field
+          doc.insert(std::make_shared<templates::string_field>(name, data.str, extra_features), true, false);
+        }
+    });
+    add_segment(gen);
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  auto& segment = *(reader.begin());
+  const auto* field = segment.field("field");
+  ASSERT_NE(nullptr, field);
+
+  constexpr irs::boost_t boost = 1.5f;
+
+  for (const float_t b : { 0.f, irs::bm25_sort::B() }) {
+    irs::order order;
+    order.add(true, std::make_unique<irs::bm25_sort>(irs::bm25_sort::K(), b));
+    auto prepared_order = order.prepare();
+    auto& bucket = *prepared_order.front().bucket;
+
+    for (const irs::string_ref term : { "0", "2", "7", "9" }) {
+      // collect term statistics
+      irs::field_collectors field_stats(prepared_order);
+      irs::term_collectors term_stats(prepared_order, 1);
+      field_stats.collect(segment, *field);
+      auto terms = field->iterator();
+      ASSERT_TRUE(terms->seek(irs::ref_cast<irs::byte_type>(term)));
+      terms->read();
+      term_stats.collect(segment, *field, 0, *terms);
+      irs::bstring stats(prepared_order.stats_size(), 0);
+      term_stats.finish(&stats[0], 0, field_stats, reader);
+
+      // evaluate scores document by document
+      auto docs = terms->postings(prepared_order.features());
+      auto* doc = irs::get<irs::document>(*docs);
+      ASSERT_NE(nullptr, doc);
+      auto* freq = irs::get<irs::frequency>(*docs);
+      ASSERT_NE(nullptr, freq);
+      irs::norm norm;
+      ASSERT_TRUE(norm.reset(segment, field->meta().norm, *doc));
+      irs::bstring score_buf(prepared_order.score_size(), 0);
+      auto scorer = bucket.prepare_scorer(segment, *field, stats.c_str(), &score_buf[0], *docs, boost);
+      ASSERT_TRUE(bool(scorer));
+
+      std::vector<uint32_t> freqs;
+      std::vector<float_t> norms;
+      std::vector<float_t> expected;
+      while (docs->next()) {
+        freqs.emplace_back(freq->value);
+        norms.emplace_back(norm.read());
+        expected.emplace_back(irs::sort::score_cast<float_t>(scorer()));
+      }
+      ASSERT_FALSE(expected.empty());
+
+      std::vector<float_t> actual(expected.size());
+      ASSERT_TRUE(prepared_order.score_block(stats.c_str(), boost, freqs.data(),
+                                             norms.data(), actual.data(), actual.size()));
+      for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_FLOAT_EQ(expected[i], actual[i]);
+      }
+
+      // vectorized and per-document evaluation give the same scores,
+      // including frequencies exceeding the precomputed square roots
+      freqs.clear();
+      norms.clear();
+      for (uint32_t i = 0; i < 131; ++i) {
+        freqs.emplace_back(i * 17);
+        norms.emplace_back(1.f / (1 + i % 13));
+      }
+
+      // frequencies not representable as signed 32-bit integers
+      for (uint32_t i = 0; i < 17; ++i) {
+        freqs.emplace_back(irs::integer_traits<uint32_t>::const_max - i * 0x0FFFFFFF);
+        norms.emplace_back(1.f / (1 + i % 13));
+      }
+
+      for (const float_t* block_norms : { static_cast<const float_t*>(norms.data()), static_cast<const float_t*>(nullptr) }) {
+        std::vector<float_t> block(freqs.size());
+        ASSERT_TRUE(bucket.score_block(stats.c_str(), boost, freqs.data(),
+                                       block_norms, block.data(), block.size()));
+
+        for (size_t i = 0; i < freqs.size(); ++i) {
+          float_t value;
+          ASSERT_TRUE(bucket.score_block(stats.c_str(), boost, &freqs[i],
+                                         block_norms ? &norms[i] : nullptr, &value, 1));
+          ASSERT_FLOAT_EQ(value, block[i]);
+        }
+      }
+    }
+  }
+
+  // no frequencies, documents get 'boost' as a score if requested
+  for (const bool boost_as_score : { false, true }) {
+    irs::order order;
+    order.add(true, irs::bm25_sort::make(irs::bm25_sort::K(), irs::bm25_sort::B(), boost_as_score));
+    auto prepared_order = order.prepare();
+    std::vector<irs::byte_type> stats(prepared_order.stats_size());
+    std::vector<float_t> scores(5, 0.f);
+    ASSERT_EQ(boost_as_score, prepared_order.score_block(stats.data(), 1.5f, nullptr, nullptr, scores.data(), scores.size()));
+
+    if (boost_as_score) {
+      for (const auto score : scores) {
+        ASSERT_EQ(1.5f, score);
+      }
+    }
+  }
+
+  // multiple buckets don't support block scoring
+  {
+    irs::order order;
+    order.add(true, std::make_unique<irs::bm25_sort>());
+    order.add(false, std::make_unique<irs::bm25_sort>());
+    auto prepared_order = order.prepare();
+    std::vector<irs::byte_type> stats(prepared_order.stats_size());
+    const uint32_t freq = 1;
+    float_t score;
+    ASSERT_FALSE(prepared_order.score_block(stats.data(), 1.f, &freq, nullptr, &score, 1));
+  }
+}
+
+TEST_P(bm25_test, test_query_top_k) {
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential_order.json"),
+      [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+        if (data.is_string()) { // field
+          doc.insert(std::make_shared<templates::string_field>(name, data.str), true, false);
+        } else if (data.is_number()) { // seq
+          const auto value = std::to_string(data.as_number<uint64_t>());
+          doc.insert(std::make_shared<templates::string_field>(name, value), false, true);
+        }
+    });
+    add_segment(gen);
+  }
+
+  struct top_k_context final : irs::attribute_provider {
+    virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+      return irs::type<irs::score_threshold>::id() == type ? &threshold : nullptr;
+    }
+
+    irs::score_threshold threshold;
+  };
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  auto& segment = *(reader.begin());
+
+  irs::order order;
+  order.add<irs::bm25_sort>(true);
+  auto prepared_order = order.prepare();
+
+  irs::Or filter;
+  for (const irs::string_ref term : { "0", "2", "7", "9" }) {
+    auto& sub = filter.add<irs::by_term>();
+    *sub.mutable_field() = "field";
+    sub.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+  }
+
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+
+  // evaluate all matched documents
+  std::vector<float_t> expected;
+  {
+    auto docs = prepared_filter->execute(segment, prepared_order);
+    auto* score = irs::get<irs::score>(*docs);
+    ASSERT_NE(nullptr, score);
+    while (docs->next()) {
+      expected.emplace_back(*reinterpret_cast<const float_t*>(score->evaluate()));
+    }
+    ASSERT_EQ(8, expected.size());
+    std::sort(expected.begin(), expected.end(), std::greater<>());
+  }
+
+  // zero threshold doesn't filter out anything
+  {
+    top_k_context ctx;
+    auto docs = prepared_filter->execute(segment, prepared_order, &ctx);
+    auto* score = irs::get<irs::score>(*docs);
+    ASSERT_NE(nullptr, score);
+    ASSERT_NE(irs::no_max_score(), score->max);
+
+    std::vector<float_t> actual;
+    while (docs->next()) {
+      actual.emplace_back(*reinterpret_cast<const float_t*>(score->evaluate()));
+      ASSERT_LE(actual.back(), score->max);
+    }
+    std::sort(actual.begin(), actual.end(), std::greater<>());
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_FLOAT_EQ(expected[i], actual[i]);
+    }
+  }
+
+  // threshold is raised as top-k is collected
+  for (size_t k = 1; k <= expected.size(); ++k) {
+    top_k_context ctx;
+    auto docs = prepared_filter->execute(segment, prepared_order, &ctx);
+    auto* score = irs::get<irs::score>(*docs);
+    ASSERT_NE(nullptr, score);
+
+    std::vector<float_t> heap; // min heap
+    size_t count = 0;
+    for (; docs->next(); ++count) {
+      const auto score_value = *reinterpret_cast<const float_t*>(score->evaluate());
+      ASSERT_LE(ctx.threshold.value, score_value);
+
+      if (heap.size() < k) {
+        heap.emplace_back(score_value);
+        std::push_heap(heap.begin(), heap.end(), std::greater<>());
+      } else if (heap.front() < score_value) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+        heap.back() = score_value;
+        std::push_heap(heap.begin(), heap.end(), std::greater<>());
+      }
+
+      if (heap.size() == k) {
+        ctx.threshold.value = heap.front();
+      }
+    }
+    ASSERT_LE(count, expected.size());
+
+    std::sort(heap.begin(), heap.end(), std::greater<>());
+    ASSERT_EQ(k, heap.size());
+    for (size_t i = 0; i < k; ++i) {
+      ASSERT_FLOAT_EQ(expected[i], heap[i]);
+    }
+  }
+}
+
 TEST_P(bm25_test, test_order) {
   {
     tests::json_doc_generator gen(
@@ -29,6 +29,7 @@
 #include "search/disjunction.hpp"
 #include "search/min_match_disjunction.hpp"
 #include "search/exclusion.hpp"
+#include "search/query_plan.hpp"
 #include "search/bm25.hpp"
 #include "search/tfidf.hpp"
 #include "filter_test_case_base.hpp"
@@ -38,6 +39,7 @@
 #include "search/term_query.hpp"
 
 #include <functional>
+#include <numeric>
 
 namespace {
 
@@ -5139,6 +5141,124 @@ TEST(block_disjunction_test, next_scored_two_blocks) {
   }
 }
 
+TEST(block_disjunction_test, next_scored_float) {
+  // sub-iterators with 'float_t' scores equal to their boosts
+  const std::vector<std::pair<std::vector<irs::doc_id_t>, irs::boost_t>> docs{
+    { { 1, 2, 5, 7, 9, 11, 45, 65, 78, 127, 1000 }, 1.f },
+    { { 1, 5, 6, 12, 29, 78, 129 }, 2.f },
+    { { 1, 5, 29, 65, 127, 1000 }, 4.f }
+  };
+
+  irs::order order;
+  order.add<tests::sort::boost>(false);
+  const auto ord = order.prepare();
+
+  auto execute = [&](auto& itrs) {
+    const irs::byte_type* stats = irs::bytes_ref::EMPTY.c_str();
+    for (auto& entry : docs) {
+      itrs.emplace_back(irs::memory::make_managed<detail::basic_doc_iterator>(
+        entry.first.begin(), entry.first.end(), stats, ord, entry.second));
+    }
+  };
+
+  auto expected = [&](irs::sort::MergeType merge_type) {
+    std::map<irs::doc_id_t, irs::boost_t> expected;
+    for (auto& entry : docs) {
+      for (auto doc : entry.first) {
+        auto& score = expected[doc];
+        score = irs::sort::MergeType::AGGREGATE == merge_type
+          ? score + entry.second
+          : std::max(score, entry.second);
+      }
+    }
+    return expected;
+  };
+
+  auto assert_scores = [&](auto&& it, irs::sort::MergeType merge_type) {
+    auto& score = irs::score::get(it);
+    ASSERT_FALSE(score.is_default());
+
+    std::map<irs::doc_id_t, irs::boost_t> actual;
+    while (it.next()) {
+      actual.emplace(it.value(), ord.get<irs::boost_t>(score.evaluate(), 0));
+    }
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+    ASSERT_EQ(expected(merge_type), actual);
+  };
+
+  // 1 block per window, i.e. 64 documents
+  {
+    using disjunction = irs::block_disjunction<
+      irs::doc_iterator::ptr,
+      irs::block_disjunction_traits<true, irs::MatchType::MATCH, false, 1>>;
+
+    for (auto merge_type : { irs::sort::MergeType::AGGREGATE,
+                             irs::sort::MergeType::MAX }) {
+      disjunction::doc_iterators_t itrs;
+      execute(itrs);
+      assert_scores(disjunction(std::move(itrs), ord, merge_type), merge_type);
+    }
+  }
+
+  // default number of blocks
+  {
+    using disjunction = irs::scored_disjunction_iterator<irs::doc_iterator::ptr>;
+
+    for (auto merge_type : { irs::sort::MergeType::AGGREGATE,
+                             irs::sort::MergeType::MAX }) {
+      disjunction::doc_iterators_t itrs;
+      execute(itrs);
+      assert_scores(disjunction(std::move(itrs), ord, merge_type), merge_type);
+    }
+  }
+
+  // seek
+  {
+    using disjunction = irs::scored_disjunction_iterator<irs::doc_iterator::ptr>;
+
+    disjunction::doc_iterators_t itrs;
+    execute(itrs);
+    disjunction it(std::move(itrs), ord, irs::sort::MergeType::AGGREGATE);
+    auto& score = irs::score::get(it);
+
+    ASSERT_EQ(5, it.seek(3));
+    ASSERT_EQ(7.f, ord.get<irs::boost_t>(score.evaluate(), 0));
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(6, it.value());
+    ASSERT_EQ(2.f, ord.get<irs::boost_t>(score.evaluate(), 0));
+    ASSERT_EQ(127, it.seek(100));
+    ASSERT_EQ(5.f, ord.get<irs::boost_t>(score.evaluate(), 0));
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(129, it.value());
+    ASSERT_EQ(2.f, ord.get<irs::boost_t>(score.evaluate(), 0));
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(1000, it.value());
+    ASSERT_EQ(5.f, ord.get<irs::boost_t>(score.evaluate(), 0));
+    ASSERT_FALSE(it.next());
+  }
+
+  // min match
+  {
+    using disjunction = irs::scored_min_match_iterator<irs::doc_iterator::ptr>;
+
+    disjunction::doc_iterators_t itrs;
+    execute(itrs);
+    disjunction it(std::move(itrs), 2, ord, irs::sort::MergeType::AGGREGATE);
+    auto& score = irs::score::get(it);
+
+    const std::vector<std::pair<irs::doc_id_t, irs::boost_t>> expected{
+      { 1, 7.f }, { 5, 7.f }, { 29, 6.f }, { 65, 5.f },
+      { 78, 3.f }, { 127, 5.f }, { 1000, 5.f }
+    };
+
+    std::vector<std::pair<irs::doc_id_t, irs::boost_t>> actual;
+    while (it.next()) {
+      actual.emplace_back(it.value(), ord.get<irs::boost_t>(score.evaluate(), 0));
+    }
+    ASSERT_EQ(expected, actual);
+  }
+}
+
 TEST(block_disjunction_test, min_match_next) {
   using disjunction = irs::block_disjunction<
     irs::doc_iterator::ptr,
@@ -10830,6 +10950,77 @@ TEST(disjunction_test, scored_seek_next) {
   }
 }
 
+TEST(bitset_disjunction_test, is_cheaper) {
+  constexpr irs::doc_id_t docs_count = 1 << 20;
+
+  // a few iterators are merged by windows
+  ASSERT_FALSE(irs::is_bitset_disjunction_cheaper(2, docs_count, docs_count));
+  ASSERT_FALSE(irs::is_bitset_disjunction_cheaper(32, docs_count, docs_count));
+
+  // many iterators
+  ASSERT_TRUE(irs::is_bitset_disjunction_cheaper(33, docs_count, docs_count));
+  ASSERT_TRUE(irs::is_bitset_disjunction_cheaper(1000, 1000, docs_count));
+  ASSERT_TRUE(irs::is_bitset_disjunction_cheaper(1000, 10000, 10000));
+
+  // too sparse to scan the whole bitset
+  ASSERT_FALSE(irs::is_bitset_disjunction_cheaper(100, 100, docs_count));
+  ASSERT_FALSE(irs::is_bitset_disjunction_cheaper(1000, 0, docs_count));
+}
+
+TEST(bitset_disjunction_test, next) {
+  using disjunction = irs::disjunction_iterator<irs::doc_iterator::ptr>;
+
+  // empty
+  {
+    auto it = irs::make_bitset_disjunction(disjunction::doc_iterators_t{}, 100);
+    ASSERT_TRUE(irs::doc_limits::eof(it->value()));
+    ASSERT_FALSE(it->next());
+  }
+
+  std::vector<std::vector<irs::doc_id_t>> docs;
+  for (irs::doc_id_t i = 1; i <= 40; ++i) {
+    docs.emplace_back();
+    for (irs::doc_id_t doc = i; doc < 1000; doc += 7*i) {
+      docs.back().push_back(doc);
+    }
+  }
+  docs.emplace_back(); // empty iterator
+
+  const auto expected = detail::union_all(docs);
+
+  // next
+  {
+    auto it = irs::make_bitset_disjunction(
+      detail::execute_all<disjunction::adapter>(docs), 1000);
+    ASSERT_NE(nullptr, dynamic_cast<irs::bitset_doc_iterator*>(it.get()));
+    auto* doc = irs::get<irs::document>(*it);
+    ASSERT_NE(nullptr, doc);
+    ASSERT_EQ(expected.size(), irs::cost::extract(*it));
+    ASSERT_TRUE(irs::score::get(*it).is_default());
+    ASSERT_EQ(irs::doc_limits::invalid(), it->value());
+
+    std::vector<irs::doc_id_t> result;
+    while (it->next()) {
+      ASSERT_EQ(it->value(), doc->value);
+      result.push_back(it->value());
+    }
+    ASSERT_EQ(expected, result);
+    ASSERT_TRUE(irs::doc_limits::eof(it->value()));
+  }
+
+  // seek
+  {
+    auto it = irs::make_bitset_disjunction(
+      detail::execute_all<disjunction::adapter>(docs), 1000);
+
+    for (const irs::doc_id_t target : { 1, 100, 500, 993 }) {
+      ASSERT_EQ(*std::lower_bound(expected.begin(), expected.end(), target),
+                it->seek(target));
+    }
+    ASSERT_TRUE(irs::doc_limits::eof(it->seek(1000)));
+  }
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--  Minimum match count: iterator0 OR iterator1 OR iterator2 OR ...
 // ----------------------------------------------------------------------------
@@ -13450,6 +13641,298 @@ TEST(conjunction_test, scored_seek_next) {
   }
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                block_conjunction
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief iterator returning decoded blocks of a fixed size via 'next_block()'
+////////////////////////////////////////////////////////////////////////////////
+class block_doc_iterator : public irs::doc_iterator {
+ public:
+  block_doc_iterator(const std::vector<irs::doc_id_t>& docs, size_t block_size)
+    : docs_(docs), block_size_(block_size) {
+    assert(block_size_);
+    est_.value(docs_.size());
+  }
+
+  virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    if (irs::type<irs::document>::id() == type) {
+      return &doc_;
+    }
+
+    return irs::type<irs::cost>::id() == type ? &est_ : nullptr;
+  }
+
+  virtual irs::doc_id_t value() const override { return doc_.value; }
+
+  virtual bool next() override {
+    if (pos_ == docs_.size()) {
+      doc_.value = irs::doc_limits::eof();
+      return false;
+    }
+
+    doc_.value = docs_[pos_++];
+    return true;
+  }
+
+  virtual irs::doc_id_t seek(irs::doc_id_t target) override {
+    while (doc_.value < target && next()) { }
+    return doc_.value;
+  }
+
+  virtual irs::doc_block next_block() override {
+    if (pos_ == docs_.size()) {
+      doc_.value = irs::doc_limits::eof();
+      return {};
+    }
+
+    const size_t end = std::min(docs_.size(), (pos_ / block_size_ + 1) * block_size_);
+    const irs::doc_block block{ docs_.data() + pos_, nullptr, end - pos_ };
+    pos_ = end;
+    doc_.value = docs_[end - 1];
+    ++blocks;
+
+    return block;
+  }
+
+  size_t blocks{}; // number of returned blocks
+
+ private:
+  const std::vector<irs::doc_id_t>& docs_;
+  size_t block_size_;
+  size_t pos_{};
+  irs::document doc_;
+  irs::cost est_;
+}; // block_doc_iterator
+
+std::vector<irs::doc_id_t> intersect_all(
+    const std::vector<std::vector<irs::doc_id_t>>& docs) {
+  std::vector<irs::doc_id_t> result = docs.front();
+  for (auto& part : docs) {
+    std::vector<irs::doc_id_t> tmp;
+    std::set_intersection(result.begin(), result.end(), part.begin(), part.end(),
+                          std::back_inserter(tmp));
+    result = std::move(tmp);
+  }
+  return result;
+}
+
+} // detail
+
+TEST(block_conjunction_test, intersect_block) {
+  std::vector<irs::doc_id_t> block;
+  for (irs::doc_id_t i = 1; i < 100; ++i) {
+    block.push_back(3*i);
+  }
+
+  // every candidate is compared against blocks of different sizes
+  for (size_t size = 0; size <= block.size(); ++size) {
+    std::vector<irs::doc_id_t> candidates;
+    for (irs::doc_id_t i = 1; i < 200; i += 2) {
+      candidates.push_back(i);
+    }
+
+    std::vector<irs::doc_id_t> expected;
+    std::set_intersection(candidates.begin(), candidates.end(),
+                          block.begin(), block.begin() + size,
+                          std::back_inserter(expected));
+
+    irs::doc_id_t* out = candidates.data();
+    const irs::doc_id_t* begin = block.data();
+    const irs::doc_id_t* end = block.data() + size;
+    const irs::doc_id_t* it = irs::intersect_block(
+      out, candidates.data(), candidates.data() + candidates.size(), begin, end);
+
+    ASSERT_EQ(expected.size(), size_t(out - candidates.data()));
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), candidates.data()));
+    ASSERT_LE(begin, end);
+
+    if (it == candidates.data() + candidates.size()) {
+      // all candidates are processed
+      ASSERT_TRUE(!size || candidates.back() <= block[size - 1]);
+    } else {
+      // the rest of candidates is greater than any document of a block
+      ASSERT_EQ(end, begin);
+      ASSERT_TRUE(!size || *it > block[size - 1]);
+      ASSERT_TRUE(it == candidates.data() || !size || it[-1] <= block[size - 1]);
+    }
+  }
+}
+
+TEST(block_conjunction_test, next) {
+  using conjunction = irs::block_conjunction<irs::doc_iterator::ptr>;
+
+  std::vector<std::vector<irs::doc_id_t>> docs(3);
+  for (irs::doc_id_t i = 1; i < 5000; ++i) {
+    if (0 == i % 2) docs[0].push_back(i);
+    if (0 == i % 3) docs[1].push_back(i);
+    if (0 == i % 5 || 0 == i % 7) docs[2].push_back(i);
+  }
+  docs.push_back({ 6, 30, 60, 1470, 2100, 4980, 4999 }); // sparse iterator
+
+  const auto expected = detail::intersect_all(docs);
+  ASSERT_EQ((std::vector<irs::doc_id_t>{ 30, 60, 1470, 2100, 4980 }), expected);
+  const auto dense = detail::intersect_all({ docs[0], docs[1], docs[2] });
+
+  for (const size_t block_size : { size_t(1), size_t(3), size_t(64), size_t(128) }) {
+    // all iterators expose blocks
+    {
+      conjunction::doc_iterators_t itrs;
+      for (auto& part : docs) {
+        itrs.emplace_back(irs::memory::make_managed<detail::block_doc_iterator>(part, block_size));
+      }
+
+      conjunction it(std::move(itrs));
+      ASSERT_EQ(docs.size(), it.size());
+      ASSERT_EQ(docs.back().size(), irs::cost::extract(it));
+      ASSERT_TRUE(irs::score::get(it).is_default());
+      auto* doc = irs::get<irs::document>(it);
+      ASSERT_NE(nullptr, doc);
+      ASSERT_EQ(irs::doc_limits::invalid(), it.value());
+
+      std::vector<irs::doc_id_t> result;
+      while (it.next()) {
+        ASSERT_EQ(it.value(), doc->value);
+        result.push_back(it.value());
+      }
+      ASSERT_EQ(expected, result);
+      ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+      ASSERT_FALSE(it.next());
+      ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+    }
+
+    // mixed iterators, dense intersection
+    {
+      conjunction::doc_iterators_t itrs;
+      itrs.emplace_back(irs::memory::make_managed<detail::block_doc_iterator>(docs[0], block_size));
+      itrs.emplace_back(irs::memory::make_managed<detail::basic_doc_iterator>(docs[1].begin(), docs[1].end()));
+      itrs.emplace_back(irs::memory::make_managed<detail::block_doc_iterator>(docs[2], block_size));
+
+      conjunction it(std::move(itrs));
+      std::vector<irs::doc_id_t> result;
+      while (it.next()) {
+        result.push_back(it.value());
+      }
+      ASSERT_EQ(dense, result);
+    }
+
+    // nested conjunctions return matched documents in blocks
+    {
+      conjunction::doc_iterators_t nested;
+      for (size_t i = 0; i < 3; ++i) {
+        nested.emplace_back(irs::memory::make_managed<detail::block_doc_iterator>(docs[i], block_size));
+      }
+
+      conjunction::doc_iterators_t itrs;
+      itrs.emplace_back(irs::memory::make_managed<conjunction>(std::move(nested)));
+      itrs.emplace_back(irs::memory::make_managed<detail::block_doc_iterator>(docs[2], block_size));
+
+      conjunction it(std::move(itrs));
+      std::vector<irs::doc_id_t> result;
+      for (auto block = it.next_block(); !block.empty(); block = it.next_block()) {
+        ASSERT_EQ(nullptr, block.freqs);
+        ASSERT_EQ(block.docs[block.size - 1], it.value());
+        result.insert(result.end(), block.docs, block.docs + block.size);
+      }
+      ASSERT_EQ(dense, result);
+      ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+    }
+  }
+
+  // other iterators are decoded block by block rather than seeked
+  {
+    std::vector<irs::doc_id_t> all(2*docs[0].size());
+    std::iota(all.begin(), all.end(), irs::doc_limits::min());
+
+    auto lead = irs::memory::make_managed<detail::block_doc_iterator>(docs[0], 128);
+    auto other = irs::memory::make_managed<detail::block_doc_iterator>(all, 128);
+    auto* other_it = other.get();
+
+    conjunction::doc_iterators_t itrs;
+    itrs.emplace_back(std::move(lead));
+    itrs.emplace_back(std::move(other));
+
+    conjunction it(std::move(itrs));
+    std::vector<irs::doc_id_t> result;
+    while (it.next()) {
+      result.push_back(it.value());
+    }
+    ASSERT_EQ(docs[0], result);
+    ASSERT_EQ((all.size() + 127) / 128, other_it->blocks); // one seek per block
+  }
+}
+
+TEST(block_conjunction_test, seek) {
+  using conjunction = irs::block_conjunction<irs::doc_iterator::ptr>;
+
+  std::vector<std::vector<irs::doc_id_t>> docs{
+    { 1, 5, 6, 45, 77, 99, 256, 988 },
+    { 1, 2, 5, 6, 7, 9, 11, 28, 45, 99, 256 },
+    { 1, 5, 6, 12, 28, 45, 99, 124, 256, 553 },
+    { 1, 6, 11, 29, 45, 99, 141, 256, 1025, 1101 }
+  };
+
+  std::vector<detail::seek_doc> expected{
+    {irs::doc_limits::invalid(), irs::doc_limits::invalid()},
+    {1, 1},
+    {6, 6},
+    {irs::doc_limits::invalid(), 6},
+    {29, 45},
+    {46, 99},
+    {68, 99},
+    {256, 256},
+    {257, irs::doc_limits::eof()}
+  };
+
+  for (const size_t block_size : { size_t(1), size_t(2), size_t(4), size_t(16) }) {
+    conjunction::doc_iterators_t itrs;
+    for (auto& part : docs) {
+      itrs.emplace_back(irs::memory::make_managed<detail::block_doc_iterator>(part, block_size));
+    }
+
+    conjunction it(std::move(itrs));
+    auto* doc = irs::get<irs::document>(it);
+    ASSERT_NE(nullptr, doc);
+
+    for (const auto& target : expected) {
+      ASSERT_EQ(target.expected, it.seek(target.target));
+      ASSERT_EQ(target.expected, doc->value);
+    }
+    ASSERT_FALSE(it.next());
+    ASSERT_TRUE(irs::doc_limits::eof(it.value()));
+  }
+
+  // seek + next
+  {
+    std::vector<std::vector<irs::doc_id_t>> docs{
+      { 1, 2, 4, 5, 7, 8, 9, 11, 14, 45 },
+      { 1, 4, 5, 6, 8, 12, 14, 29 },
+      { 1, 4, 5, 8, 14 }
+    };
+
+    conjunction::doc_iterators_t itrs;
+    for (auto& part : docs) {
+      itrs.emplace_back(irs::memory::make_managed<detail::block_doc_iterator>(part, 2));
+    }
+
+    conjunction it(std::move(itrs));
+    ASSERT_EQ(irs::doc_limits::invalid(), it.value());
+    ASSERT_EQ(4, it.seek(3));
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(5, it.value());
+    ASSERT_EQ(5, it.seek(5));
+    ASSERT_TRUE(it.next());
+    ASSERT_EQ(8, it.value());
+    ASSERT_EQ(14, it.seek(14));
+    ASSERT_FALSE(it.next());
+    ASSERT_EQ(irs::doc_limits::eof(), it.value());
+    ASSERT_EQ(irs::doc_limits::eof(), it.seek(15));
+  }
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                      iterator0 AND NOT iterator1
 // ----------------------------------------------------------------------------
@@ -15128,6 +15611,116 @@ TEST(Or_test, boosted_not) {
 }
 
 
+TEST_P(boolean_filter_test_case, query_plan) {
+  // add segment
+  {
+    tests::json_doc_generator gen(
+      resource("simple_sequential.json"),
+      &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr->size());
+  auto& segment = (*rdr)[0];
+
+  struct plan_context final : irs::attribute_provider {
+    virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+      return irs::type<irs::query_plan>::id() == type ? &plan : nullptr;
+    }
+
+    irs::query_plan plan;
+  };
+
+  irs::order order;
+  order.add<sort::boost>(false);
+  const auto prepared_order = order.prepare();
+
+  auto execute = [&](const irs::filter& filter,
+                     const irs::order::prepared& ord,
+                     plan_context& ctx) {
+    auto prepared = filter.prepare(*rdr, ord, &ctx);
+    auto it = prepared->execute(segment, ord, &ctx);
+
+    docs_t actual;
+    while (it->next()) {
+      actual.push_back(it->value());
+    }
+    return actual;
+  };
+
+  // exclusion is applied to the leading iterator of a scored conjunction,
+  // since the rest of iterators don't prune anything
+  {
+    irs::And root;
+    append<irs::by_term>(root, "duplicated", "vczc");
+    append<irs::by_term>(root, "same", "xyz");
+    root.add<irs::Not>().filter<irs::by_term>() = make_filter<irs::by_term>("name", "X");
+
+    plan_context ctx;
+    ASSERT_EQ((docs_t{ 2, 3, 8, 14, 17, 19 }), execute(root, prepared_order, ctx));
+
+    const auto plan = ctx.plan.to_string();
+    ASSERT_NE(std::string::npos, plan.find("conjunction of 2 iterators, costs 7 32"));
+    ASSERT_NE(std::string::npos, plan.find("exclusion of cost 1 is applied to the leading iterator"));
+    ASSERT_EQ(std::string::npos, plan.find("applied to the result"));
+  }
+
+  // exclusion is applied to the result of a scored conjunction,
+  // since the rest of iterators prune more than the exclusion
+  {
+    irs::And root;
+    append<irs::by_term>(root, "duplicated", "vczc");
+    append<irs::by_term>(root, "name", "X");
+    root.add<irs::Not>().filter<irs::by_term>() = make_filter<irs::by_term>("duplicated", "abcd");
+
+    plan_context ctx;
+    ASSERT_EQ((docs_t{ 24 }), execute(root, prepared_order, ctx));
+
+    const auto plan = ctx.plan.to_string();
+    ASSERT_NE(std::string::npos, plan.find("conjunction of 2 iterators, costs 1 7\n"));
+    ASSERT_NE(std::string::npos, plan.find("exclusion, applied to the result"));
+  }
+
+  // unscored conjunction intersects blocks, exclusion is applied to the result
+  {
+    irs::And root;
+    append<irs::by_term>(root, "duplicated", "vczc");
+    append<irs::by_term>(root, "same", "xyz");
+    root.add<irs::Not>().filter<irs::by_term>() = make_filter<irs::by_term>("name", "X");
+
+    plan_context ctx;
+    ASSERT_EQ((docs_t{ 2, 3, 8, 14, 17, 19 }),
+              execute(root, irs::order::prepared::unordered(), ctx));
+
+    const auto plan = ctx.plan.to_string();
+    ASSERT_NE(std::string::npos, plan.find("conjunction of 2 iterators, costs 7 32, intersected by blocks"));
+    ASSERT_NE(std::string::npos, plan.find("exclusion, applied to the result"));
+  }
+
+  // nested disjunction, prepare time rewrites
+  {
+    irs::And root;
+    append<irs::by_term>(root, "same", "xyz");
+    auto& child = root.add<irs::Or>();
+    append<irs::by_term>(child, "duplicated", "abcd");
+    append<irs::by_term>(child, "duplicated", "vczc");
+    append<irs::by_term>(child, "duplicated", "none");
+    root.add<irs::Or>().add<irs::all>();
+
+    plan_context ctx;
+    ASSERT_EQ((docs_t{ 1, 2, 3, 5, 8, 11, 14, 17, 19, 21, 24, 27, 31 }),
+              execute(root, irs::order::prepared::unordered(), ctx));
+
+    ASSERT_EQ(
+      "Or: 'all' filters are merged\n"
+      "Or: reduced to a single filter\n"
+      "conjunction of 3 iterators, costs 13 32 32, intersected by blocks\n"
+      "  disjunction of 2 non-empty iterators out of 3, merged by windows\n",
+      ctx.plan.to_string());
+  }
+}
+
 #endif // IRESEARCH_DLL
 
 INSTANTIATE_TEST_CASE_P(
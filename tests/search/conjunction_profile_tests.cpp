@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/index_tests.hpp"
+#include "search/conjunction.hpp"
+#include "search/term_filter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+namespace {
+
+using namespace tests;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief iterator over an in-memory postings list, exposes blocks of
+///        decoded documents similar to the ones of the postings formats
+////////////////////////////////////////////////////////////////////////////////
+class postings_iterator final : public irs::doc_iterator {
+ public:
+  static constexpr size_t BLOCK_SIZE = 128;
+
+  explicit postings_iterator(const std::vector<irs::doc_id_t>& docs)
+    : docs_(docs) {
+    est_.value(docs_.size());
+  }
+
+  virtual irs::attribute* get_mutable(irs::type_info::type_id type) noexcept override {
+    if (irs::type<irs::document>::id() == type) {
+      return &doc_;
+    }
+
+    return irs::type<irs::cost>::id() == type ? &est_ : nullptr;
+  }
+
+  virtual irs::doc_id_t value() const override { return doc_.value; }
+
+  virtual bool next() override {
+    if (pos_ == docs_.size()) {
+      doc_.value = irs::doc_limits::eof();
+      return false;
+    }
+
+    doc_.value = docs_[pos_++];
+    return true;
+  }
+
+  virtual irs::doc_id_t seek(irs::doc_id_t target) override {
+    if (target <= doc_.value) {
+      return doc_.value;
+    }
+
+    // skip whole blocks as a skip-list would do
+    size_t block = pos_ / BLOCK_SIZE;
+    while ((block + 1) * BLOCK_SIZE < docs_.size()
+           && docs_[(block + 1) * BLOCK_SIZE - 1] < target) {
+      pos_ = ++block * BLOCK_SIZE;
+    }
+
+    while (next() && doc_.value < target) { }
+    return doc_.value;
+  }
+
+  virtual irs::doc_block next_block() override {
+    if (pos_ == docs_.size()) {
+      doc_.value = irs::doc_limits::eof();
+      return {};
+    }
+
+    const size_t end = std::min(docs_.size(), (pos_ / BLOCK_SIZE + 1) * BLOCK_SIZE);
+    const irs::doc_block block{ docs_.data() + pos_, nullptr, end - pos_ };
+    pos_ = end;
+    doc_.value = docs_[end - 1];
+
+    return block;
+  }
+
+ private:
+  const std::vector<irs::doc_id_t>& docs_;
+  size_t pos_{};
+  irs::document doc_;
+  irs::cost est_;
+}; // postings_iterator
+
+template<typename Factory>
+size_t profile(const std::string& name, size_t repeat, Factory&& factory) {
+  size_t count = 0;
+  const auto start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < repeat; ++i) {
+    for (auto it = factory(); it->next(); ) {
+      ++count;
+    }
+  }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start);
+
+  std::cout << name << ": " << elapsed.count() / repeat << "us per query, "
+            << count / repeat << " docs" << std::endl;
+
+  return count / repeat;
+}
+
+template<template<typename> class Conjunction, typename Factory>
+irs::doc_iterator::ptr make(size_t size, Factory&& factory) {
+  using conjunction_t = Conjunction<irs::doc_iterator::ptr>;
+
+  typename conjunction_t::doc_iterators_t itrs;
+  for (size_t i = 0; i < size; ++i) {
+    itrs.emplace_back(factory(i));
+  }
+
+  return irs::memory::make_managed<conjunction_t>(std::move(itrs));
+}
+
+typedef std::vector<std::pair<std::string, std::vector<irs::doc_id_t>>> postings_t;
+
+// sets of postings of synthetic documents in range [min, max)
+std::vector<postings_t> synthetic_postings(irs::doc_id_t max) {
+  // every n-th document
+  auto generate = [max](irs::doc_id_t step) {
+    std::vector<irs::doc_id_t> docs;
+    for (irs::doc_id_t i = irs::doc_limits::min(); i < max; i += step) {
+      docs.push_back(i);
+    }
+    return docs;
+  };
+
+  return {
+    { { "dense", generate(2) }, { "dense", generate(3) } },
+    { { "dense", generate(2) }, { "dense", generate(3) }, { "dense", generate(5) } },
+    { { "sparse", generate(1021) }, { "dense", generate(2) } },
+    { { "medium", generate(31) }, { "medium", generate(37) } }
+  };
+}
+
+}
+
+TEST(conjunction_profile_test, synthetic) {
+  for (auto& postings : synthetic_postings(1 << 14)) {
+    // expected intersection
+    auto expected = postings.front().second;
+    for (auto& entry : postings) {
+      std::vector<irs::doc_id_t> docs;
+      std::set_intersection(
+        expected.begin(), expected.end(),
+        entry.second.begin(), entry.second.end(),
+        std::back_inserter(docs));
+      expected = std::move(docs);
+    }
+    ASSERT_FALSE(expected.empty());
+
+    auto factory = [&postings](size_t i) -> irs::doc_iterator::ptr {
+      return irs::memory::make_managed<postings_iterator>(postings[i].second);
+    };
+
+    auto docs = [](irs::doc_iterator::ptr&& it) {
+      std::vector<irs::doc_id_t> docs;
+      while (it->next()) {
+        docs.push_back(it->value());
+      }
+      return docs;
+    };
+
+    ASSERT_EQ(expected, docs(make<irs::conjunction>(postings.size(), factory)));
+    ASSERT_EQ(expected, docs(make<irs::block_conjunction>(postings.size(), factory)));
+  }
+}
+
+// long-running benchmark, run explicitly via --gtest_also_run_disabled_tests
+TEST(conjunction_profile_test, DISABLED_profile_synthetic_mt) {
+  constexpr size_t REPEAT = 10;
+
+  for (auto& postings : synthetic_postings(1 << 20)) {
+    std::string name;
+    for (auto& entry : postings) {
+      name += entry.first + "(" + std::to_string(entry.second.size()) + ") ";
+    }
+
+    auto factory = [&postings](size_t i) -> irs::doc_iterator::ptr {
+      return irs::memory::make_managed<postings_iterator>(postings[i].second);
+    };
+
+    const size_t expected = profile(name + "conjunction", REPEAT, [&](){
+      return make<irs::conjunction>(postings.size(), factory);
+    });
+
+    const size_t actual = profile(name + "block_conjunction", REPEAT, [&](){
+      return make<irs::block_conjunction>(postings.size(), factory);
+    });
+
+    ASSERT_EQ(expected, actual);
+  }
+}
+
+#ifndef IRESEARCH_DLL
+
+class conjunction_profile_test_case : public index_test_base { };
+
+// long-running benchmark, run explicitly via --gtest_also_run_disabled_tests
+TEST_P(conjunction_profile_test_case, DISABLED_profile_europarl_mt) {
+  constexpr size_t REPEAT = 100;
+
+  {
+    tests::templates::europarl_doc_template doc;
+    tests::delim_doc_generator gen(resource("europarl.subset.txt"), doc);
+    auto writer = open_writer(irs::OM_CREATE);
+
+    // enlarge postings in order to get more than a single block
+    for (size_t i = 0; i < 4; ++i, gen.reset()) {
+      for (const document* src; (src = gen.next()); ) {
+        ASSERT_TRUE(insert(*writer,
+          src->indexed.begin(), src->indexed.end(),
+          src->stored.begin(), src->stored.end()));
+      }
+    }
+
+    writer->commit();
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0];
+
+  const std::vector<std::vector<irs::string_ref>> queries {
+    { "the", "of" },
+    { "the", "of", "and" },
+    { "the", "european" },
+    { "commission", "parliament" }
+  };
+
+  for (auto& terms : queries) {
+    std::vector<irs::filter::prepared::ptr> filters;
+    std::string name = "europarl";
+
+    for (auto& term : terms) {
+      irs::by_term filter;
+      *filter.mutable_field() = "body_anl";
+      filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+      filters.emplace_back(filter.prepare(reader));
+      name += " " + std::string(term);
+    }
+
+    auto factory = [&filters, &segment](size_t i) {
+      return filters[i]->execute(segment);
+    };
+
+    const size_t expected = profile(name + " conjunction", REPEAT, [&](){
+      return make<irs::conjunction>(filters.size(), factory);
+    });
+
+    const size_t actual = profile(name + " block_conjunction", REPEAT, [&](){
+      return make<irs::block_conjunction>(filters.size(), factory);
+    });
+
+    ASSERT_LT(0, expected);
+    ASSERT_EQ(expected, actual);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+  conjunction_profile_test,
+  conjunction_profile_test_case,
+  ::testing::Combine(
+    ::testing::Values(&tests::memory_directory),
+    ::testing::Values("1_5")
+  ),
+  tests::to_string
+);
+
+#endif // IRESEARCH_DLL
@@ -23,6 +23,7 @@
 #include "tests_shared.hpp"
 #include "filter_test_case_base.hpp"
 
+#include "search/bitset_doc_iterator.hpp"
 #include "search/boost_sort.hpp"
 #include "search/terms_filter.hpp"
 
@@ -305,6 +306,62 @@ TEST_P(terms_filter_test_case, simple_sequential) {
   }
 }
 
+TEST_P(terms_filter_test_case, wide_expansion) {
+  // add segment
+  {
+    std::string data = "[";
+    for (size_t i = 0; i < 200; ++i) {
+      data += (i ? ",{\"name\":\"t" : "{\"name\":\"t") + std::to_string(i) + "\"}";
+    }
+    data += "]";
+
+    tests::json_doc_generator gen(data.c_str(), &tests::generic_json_field_factory);
+    add_segment(gen);
+  }
+
+  auto rdr = open_reader();
+  ASSERT_EQ(1, rdr.size());
+  auto& segment = rdr[0];
+
+  // every second document
+  std::vector<std::string> terms;
+  docs_t result;
+  for (size_t i = 0; i < 200; i += 2) {
+    terms.emplace_back("t" + std::to_string(i));
+    result.push_back(irs::doc_id_t(irs::doc_limits::min() + i));
+  }
+
+  // expansion is accumulated into a bitset
+  {
+    irs::by_terms filter;
+    *filter.mutable_field() = "name";
+    for (auto& term : terms) {
+      filter.mutable_options()->terms.emplace(irs::ref_cast<irs::byte_type>(irs::string_ref(term)));
+    }
+
+    check_query(filter, result, costs_t{ result.size() }, rdr);
+
+    auto prepared = filter.prepare(rdr);
+    auto docs = prepared->execute(segment);
+    ASSERT_NE(nullptr, dynamic_cast<irs::bitset_doc_iterator*>(docs.get()));
+  }
+
+  // narrow expansion is merged by a disjunction
+  {
+    irs::by_terms filter;
+    *filter.mutable_field() = "name";
+    for (size_t i = 0; i < 10; ++i) {
+      filter.mutable_options()->terms.emplace(irs::ref_cast<irs::byte_type>(irs::string_ref(terms[i])));
+    }
+
+    check_query(filter, docs_t(result.begin(), result.begin() + 10), costs_t{ 10 }, rdr);
+
+    auto prepared = filter.prepare(rdr);
+    auto docs = prepared->execute(segment);
+    ASSERT_EQ(nullptr, dynamic_cast<irs::bitset_doc_iterator*>(docs.get()));
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(
   terms_filter_test,
   terms_filter_test_case,
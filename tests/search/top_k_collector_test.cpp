@@ -0,0 +1,450 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/index_tests.hpp"
+#include "search/all_filter.hpp"
+#include "search/boolean_filter.hpp"
+#include "search/bm25.hpp"
+#include "search/term_filter.hpp"
+#include "search/top_k_collector.hpp"
+#include "utils/async_utils.hpp"
+
+namespace {
+
+using namespace tests;
+
+class top_k_collector_test : public index_test_base {
+ protected:
+  struct expected_entry {
+    const irs::sub_reader* segment;
+    irs::doc_id_t doc;
+    float_t score;
+  };
+
+  void SetUp() override {
+    index_test_base::SetUp();
+
+    // 2 segments with the same documents
+    for (size_t i = 0; i < 2; ++i) {
+      tests::json_doc_generator gen(
+        resource("simple_sequential_order.json"),
+        [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+          if (data.is_string()) { // field
+            doc.insert(std::make_shared<templates::string_field>(name, data.str), true, false);
+          }
+      });
+      add_segment(gen, i ? irs::OM_APPEND : irs::OM_CREATE);
+    }
+  }
+
+  // evaluate all documents matched by a filter
+  static std::vector<expected_entry> evaluate(
+      const irs::index_reader& reader,
+      const irs::filter::prepared& filter,
+      const irs::order::prepared& ord) {
+    std::vector<expected_entry> result;
+
+    for (auto& segment : reader) {
+      auto docs = segment.mask(filter.execute(segment, ord));
+      auto& score = irs::score::get(*docs);
+
+      while (docs->next()) {
+        result.push_back({
+          &segment, docs->value(),
+          ord.empty() ? 0.f : irs::sort::score_cast<float_t>(score.evaluate()) });
+      }
+    }
+
+    std::stable_sort(
+      result.begin(), result.end(),
+      [](const expected_entry& lhs, const expected_entry& rhs) {
+        return lhs.score > rhs.score;
+    });
+
+    return result;
+  }
+
+  static void assert_top(
+      const std::vector<expected_entry>& expected,
+      const std::vector<irs::top_k_collector::entry>& actual) {
+    ASSERT_LE(actual.size(), expected.size());
+
+    for (size_t i = 0; i < actual.size(); ++i) {
+      ASSERT_FLOAT_EQ(expected[i].score, actual[i].score);
+
+      // returned document has the returned score
+      auto it = std::find_if(
+        expected.begin(), expected.end(),
+        [&actual, i](const expected_entry& entry) {
+          return entry.segment == actual[i].segment && entry.doc == actual[i].doc;
+      });
+      ASSERT_NE(expected.end(), it);
+      ASSERT_FLOAT_EQ(it->score, actual[i].score);
+
+      if (i) {
+        ASSERT_LE(actual[i].score, actual[i-1].score);
+      }
+    }
+  }
+};
+
+#ifndef IRESEARCH_DLL
+
+TEST_P(top_k_collector_test, disjunction) {
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+
+  irs::order order;
+  order.add<irs::bm25_sort>(true);
+  auto prepared_order = order.prepare();
+
+  irs::Or filter;
+  for (const irs::string_ref term : { "0", "2", "7", "9" }) {
+    auto& sub = filter.add<irs::by_term>();
+    *sub.mutable_field() = "field";
+    sub.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+  }
+
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+  const auto expected = evaluate(reader, *prepared_filter, prepared_order);
+  ASSERT_EQ(16, expected.size());
+
+  for (size_t k = 1; k <= expected.size() + 1; ++k) {
+    irs::top_k_collector collector(k);
+    ASSERT_EQ(k, collector.k());
+    ASSERT_EQ(0, collector.size());
+    ASSERT_EQ(0.f, collector.threshold());
+
+    collector.collect(reader, *prepared_filter, prepared_order);
+    ASSERT_EQ(std::min(k, expected.size()), collector.size());
+    ASSERT_LE(collector.hits(), expected.size());
+
+    const auto top = collector.top();
+    ASSERT_EQ(collector.size(), top.size());
+    assert_top(expected, top);
+
+    if (collector.full()) {
+      ASSERT_FLOAT_EQ(top.back().score, collector.threshold());
+    } else {
+      ASSERT_EQ(0.f, collector.threshold());
+      ASSERT_EQ(expected.size(), collector.hits());
+    }
+
+    // collector is reusable
+    collector.clear();
+    ASSERT_EQ(0, collector.size());
+    ASSERT_EQ(0, collector.hits());
+    ASSERT_EQ(0.f, collector.threshold());
+    collector.collect(reader, *prepared_filter, prepared_order);
+    assert_top(expected, collector.top());
+  }
+}
+
+TEST_P(top_k_collector_test, disjunction_parallel) {
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+
+  irs::order order;
+  order.add<irs::bm25_sort>(true);
+  auto prepared_order = order.prepare();
+
+  irs::Or filter;
+  for (const irs::string_ref term : { "0", "2", "7", "9" }) {
+    auto& sub = filter.add<irs::by_term>();
+    *sub.mutable_field() = "field";
+    sub.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+  }
+
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+  const auto expected = evaluate(reader, *prepared_filter, prepared_order);
+  ASSERT_EQ(16, expected.size());
+
+  irs::async_utils::thread_pool pool(4, 4);
+
+  // whole segments, ranges of documents, single document ranges
+  for (const size_t max_range_docs : { size_t(0), size_t(7), size_t(1) }) {
+    for (size_t k = 1; k <= expected.size() + 1; ++k) {
+      irs::top_k_collector collector(k);
+      collector.collect(reader, *prepared_filter, prepared_order,
+                        pool, max_range_docs);
+      ASSERT_EQ(std::min(k, expected.size()), collector.size());
+      ASSERT_LE(collector.size(), collector.hits());
+
+      const auto top = collector.top();
+      ASSERT_EQ(collector.size(), top.size());
+      assert_top(expected, top);
+
+      if (collector.full()) {
+        ASSERT_FLOAT_EQ(top.back().score, collector.threshold());
+      }
+
+      // sequential and parallel collections can be combined
+      irs::top_k_collector sequential(k);
+      sequential.collect(*reader.begin(), *prepared_filter, prepared_order);
+      sequential.collect(reader, *prepared_filter, prepared_order,
+                         pool, max_range_docs);
+      ASSERT_EQ(std::min(k, 2*expected.size()), sequential.size());
+    }
+  }
+
+  // stopped pool, ranges are processed by the calling thread
+  pool.stop();
+  irs::top_k_collector collector(5);
+  collector.collect(reader, *prepared_filter, prepared_order, pool, 3);
+  ASSERT_EQ(5, collector.size());
+  assert_top(expected, collector.top());
+}
+
+TEST_P(top_k_collector_test, term) {
+  auto reader = irs::directory_reader::open(dir(), codec());
+
+  irs::order order;
+  order.add<irs::bm25_sort>(true);
+  auto prepared_order = order.prepare();
+
+  irs::by_term filter;
+  *filter.mutable_field() = "field";
+  filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("7"));
+
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+  const auto expected = evaluate(reader, *prepared_filter, prepared_order);
+  ASSERT_FALSE(expected.empty());
+
+  for (size_t k = 1; k <= expected.size(); ++k) {
+    irs::top_k_collector collector(k);
+    collector.collect(reader, *prepared_filter, prepared_order);
+    ASSERT_EQ(k, collector.size());
+    assert_top(expected, collector.top());
+  }
+}
+
+TEST_P(top_k_collector_test, blocks) {
+  // terms 'a' and 'b' occur in every document, the frequency of 'a' is high
+  // only within the first postings block
+  {
+    auto writer = open_writer(irs::OM_CREATE);
+
+    for (size_t i = 0; i < 2000; ++i) {
+      std::deque<templates::string_field> fields;
+      const size_t freq = i < 100 ? 1 + i % 31 : 1 + (i * 7919) % 3;
+
+      for (size_t j = 0; j < freq; ++j) {
+        fields.emplace_back("field", "a");
+      }
+
+      fields.emplace_back("field", "b");
+
+      ASSERT_TRUE(insert(*writer, fields.begin(), fields.end()));
+    }
+
+    writer->commit();
+  }
+
+  auto reader = open_reader();
+  ASSERT_EQ(1, reader.size());
+  const bool has_impacts = irs::string_ref("1_5") == std::get<1>(GetParam()).codec;
+
+  // the field has no norms, 'b == 0' makes upper bounds of bm25 exact
+  irs::order order;
+  order.add<irs::bm25_sort>(true, irs::bm25_sort::K(), 0.f);
+  auto prepared_order = order.prepare();
+
+  // single term
+  {
+    irs::by_term filter;
+    *filter.mutable_field() = "field";
+    filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("a"));
+
+    auto prepared_filter = filter.prepare(reader, prepared_order);
+    const auto expected = evaluate(reader, *prepared_filter, prepared_order);
+    ASSERT_EQ(2000, expected.size());
+
+    for (const size_t k : { 1, 10, 50, 2000 }) {
+      irs::top_k_collector collector(k);
+      collector.collect(reader, *prepared_filter, prepared_order);
+      ASSERT_EQ(k, collector.size());
+      assert_top(expected, collector.top());
+
+      if (has_impacts && k < 100) {
+        // blocks of low frequency documents are skipped
+        ASSERT_LT(collector.hits(), expected.size());
+      }
+    }
+  }
+
+  // disjunction
+  {
+    irs::Or filter;
+    for (const irs::string_ref term : { "a", "b" }) {
+      auto& sub = filter.add<irs::by_term>();
+      *sub.mutable_field() = "field";
+      sub.mutable_options()->term = irs::ref_cast<irs::byte_type>(term);
+    }
+
+    auto prepared_filter = filter.prepare(reader, prepared_order);
+    const auto expected = evaluate(reader, *prepared_filter, prepared_order);
+    ASSERT_EQ(2000, expected.size());
+
+    for (const size_t k : { 1, 10, 50, 2000 }) {
+      irs::top_k_collector collector(k);
+      collector.collect(reader, *prepared_filter, prepared_order);
+      ASSERT_EQ(k, collector.size());
+      assert_top(expected, collector.top());
+
+      if (has_impacts && k < 100) {
+        // candidates within low frequency blocks are rejected
+        ASSERT_LT(collector.hits(), expected.size());
+      }
+    }
+  }
+}
+
+TEST_P(top_k_collector_test, removed) {
+  // remove documents containing "6", i.e. 'seq' 0, 2 and 5 of both segments
+  {
+    auto writer = open_writer(irs::OM_APPEND);
+    auto filter = irs::memory::make_unique<irs::by_term>();
+    *filter->mutable_field() = "field";
+    filter->mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("6"));
+    writer->documents().remove(irs::filter::ptr(std::move(filter)));
+    writer->commit();
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+
+  irs::order order;
+  order.add<irs::bm25_sort>(true);
+  auto prepared_order = order.prepare();
+
+  irs::by_term filter;
+  *filter.mutable_field() = "field";
+  filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("7"));
+
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+  const auto expected = evaluate(reader, *prepared_filter, prepared_order);
+  ASSERT_EQ(4, expected.size()); // 'seq' 1 and 7 of both segments
+
+  for (size_t k = 1; k <= expected.size() + 1; ++k) {
+    irs::top_k_collector collector(k);
+    collector.collect(reader, *prepared_filter, prepared_order);
+    ASSERT_EQ(std::min(k, expected.size()), collector.size());
+
+    const auto top = collector.top();
+    assert_top(expected, top);
+
+    for (auto& entry : top) {
+      auto live = entry.segment->docs_iterator();
+      ASSERT_EQ(entry.doc, live->seek(entry.doc)); // not removed
+    }
+  }
+
+  irs::async_utils::thread_pool pool(4, 4);
+
+  for (const size_t max_range_docs : { size_t(0), size_t(1) }) {
+    irs::top_k_collector collector(expected.size() + 1);
+    collector.collect(reader, *prepared_filter, prepared_order,
+                      pool, max_range_docs);
+    ASSERT_EQ(expected.size(), collector.size());
+    ASSERT_EQ(expected.size(), collector.hits());
+    assert_top(expected, collector.top());
+  }
+}
+
+TEST_P(top_k_collector_test, unordered) {
+  auto reader = irs::directory_reader::open(dir(), codec());
+
+  irs::all filter;
+  auto prepared_filter = filter.prepare(reader);
+
+  const auto& prepared_order = irs::order::prepared::unordered();
+  const auto expected = evaluate(reader, *prepared_filter, prepared_order);
+  ASSERT_EQ(reader.docs_count(), expected.size());
+
+  // no need to evaluate documents after collecting first 'k' documents
+  irs::top_k_collector collector(5);
+  collector.collect(reader, *prepared_filter, prepared_order);
+  ASSERT_EQ(5, collector.size());
+  ASSERT_EQ(5, collector.hits());
+
+  const auto top = collector.top();
+  ASSERT_EQ(5, top.size());
+  for (size_t i = 0; i < top.size(); ++i) {
+    ASSERT_EQ(&*reader.begin(), top[i].segment);
+    ASSERT_EQ(irs::doc_limits::min() + i, top[i].doc);
+    ASSERT_EQ(0.f, top[i].score);
+  }
+}
+
+TEST_P(top_k_collector_test, empty) {
+  auto reader = irs::directory_reader::open(dir(), codec());
+
+  irs::order order;
+  order.add<irs::bm25_sort>(true);
+  auto prepared_order = order.prepare();
+
+  irs::by_term filter;
+  *filter.mutable_field() = "field";
+  filter.mutable_options()->term = irs::ref_cast<irs::byte_type>(irs::string_ref("missing"));
+
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+
+  // nothing matched
+  {
+    irs::top_k_collector collector(10);
+    collector.collect(reader, *prepared_filter, prepared_order);
+    ASSERT_EQ(0, collector.size());
+    ASSERT_EQ(0, collector.hits());
+    ASSERT_TRUE(collector.top().empty());
+  }
+
+  // nothing to collect
+  {
+    irs::all all;
+    auto prepared_all = all.prepare(reader, prepared_order);
+
+    irs::top_k_collector collector(0);
+    collector.collect(reader, *prepared_all, prepared_order);
+    ASSERT_EQ(0, collector.size());
+    ASSERT_EQ(0, collector.hits());
+    ASSERT_TRUE(collector.top().empty());
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(
+  top_k_collector_test,
+  top_k_collector_test,
+  ::testing::Combine(
+    ::testing::Values(
+      &tests::memory_directory,
+      &tests::fs_directory,
+      &tests::mmap_directory
+    ),
+    ::testing::Values("1_0", "1_5")
+  ),
+  tests::to_string
+);
+
+#endif // IRESEARCH_DLL
+
+}
@@ -25,7 +25,9 @@
 #include "tests_param.hpp"
 
 #include "store/store_utils.hpp"
+#include "store/async_directory.hpp"
 #include "store/fs_directory.hpp"
+#include "store/mmap_directory.hpp"
 #include "store/memory_directory.hpp"
 #include "store/data_output.hpp"
 #include "store/data_input.hpp"
@@ -33,15 +35,22 @@
 #include "utils/crc.hpp"
 #include "utils/utf8_path.hpp"
 #include "utils/directory_utils.hpp"
+#include "utils/mmap_utils.hpp"
 #include "utils/process_utils.hpp"
 #include "utils/network_utils.hpp"
 
 #include <cstdio>
+#include <set>
+#include <sstream>
 #include <vector>
 #include <string>
 #include <algorithm>
 #include <fstream>
 
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
 namespace {
 
 using namespace iresearch;
@@ -420,6 +429,78 @@ TEST_P(directory_test_case, create_many_files) {
 }
 #endif
 
+TEST_P(directory_test_case, prefetch) {
+  {
+    auto out = dir_->create("test_prefetch");
+    ASSERT_FALSE(!out);
+
+    for (uint32_t i = 0; i < 10000; ++i) {
+      out->write_int(i);
+    }
+  }
+
+  auto in = dir_->open("test_prefetch", irs::IOAdvice::RANDOM);
+  ASSERT_FALSE(!in);
+
+  // prefetch is just a hint and never changes the state of an input
+  in->prefetch(0, 0);
+  in->prefetch(4000, 8000);
+  in->prefetch(in->length() - 1, 100);
+  in->prefetch(in->length() + 100, 100);
+  ASSERT_EQ(0, in->file_pointer());
+
+  in->seek(4000);
+  in->prefetch(36000, 4000);
+  ASSERT_EQ(4000, in->file_pointer());
+
+  for (uint32_t i = 1000; i < 10000; ++i) {
+    ASSERT_EQ(i, in->read_int());
+  }
+  ASSERT_TRUE(in->eof());
+}
+
+TEST_P(directory_test_case, create_readonce) {
+  constexpr uint32_t count = 300000; // exceeds internal buffers, unaligned tail
+  int64_t checksum;
+
+  {
+    auto out = dir_->create("test_readonce", irs::IOAdvice::READONCE);
+    ASSERT_FALSE(!out);
+
+    for (uint32_t i = 0; i < count; ++i) {
+      out->write_vint(i);
+    }
+
+    checksum = out->checksum();
+    out->write_byte(42);
+  }
+
+  {
+    auto out = dir_->create("test_normal", irs::IOAdvice::NORMAL);
+    ASSERT_FALSE(!out);
+
+    for (uint32_t i = 0; i < count; ++i) {
+      out->write_vint(i);
+    }
+
+    ASSERT_EQ(checksum, out->checksum());
+  }
+
+  uint64_t length;
+  ASSERT_TRUE(dir_->length(length, "test_readonce"));
+
+  auto in = dir_->open("test_readonce", irs::IOAdvice::NORMAL);
+  ASSERT_FALSE(!in);
+  ASSERT_EQ(length, in->length());
+  ASSERT_EQ(checksum, in->checksum(length - 1));
+
+  for (uint32_t i = 0; i < count; ++i) {
+    ASSERT_EQ(i, in->read_vint());
+  }
+  ASSERT_EQ(42, in->read_byte());
+  ASSERT_TRUE(in->eof());
+}
+
 TEST_P(directory_test_case, read_multiple_streams) {
   // write data
   {
@@ -1210,7 +1291,8 @@ INSTANTIATE_TEST_CASE_P(
   ::testing::Values(
     &tests::memory_directory,
     &tests::fs_directory,
-    &tests::mmap_directory
+    &tests::mmap_directory,
+    &tests::async_directory
   ),
   tests::directory_test_case_base::to_string
 );
@@ -1451,6 +1533,118 @@ TEST_F(fs_directory_test, utf8_chars_native) {
   }
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                               mmap_directory_test
+// -----------------------------------------------------------------------------
+
+class mmap_directory_test : public fs_directory_test {
+ protected:
+#ifdef __linux__
+  struct mapping_info {
+    size_t rss{}; // resident memory in kB
+    std::set<std::string> flags; // 'VmFlags', e.g. 'lo' (locked), 'hg' (huge pages)
+  };
+
+  // returns info of the mapping containing 'addr' from '/proc/self/smaps'
+  static bool get_mapping_info(const void* addr, mapping_info& info) {
+    std::ifstream smaps("/proc/self/smaps");
+    bool found = false;
+
+    for (std::string line; std::getline(smaps, line); ) {
+      uintptr_t begin, end;
+      char sep;
+      std::istringstream stream(line);
+
+      if (stream >> std::hex >> begin >> sep >> end && '-' == sep) {
+        // header of the next mapping
+        if (found) {
+          break;
+        }
+
+        found = begin <= uintptr_t(addr) && uintptr_t(addr) < end;
+      } else if (found && 0 == line.compare(0, 4, "Rss:")) {
+        std::istringstream(line.substr(4)) >> info.rss;
+      } else if (found && 0 == line.compare(0, 8, "VmFlags:")) {
+        std::istringstream flags(line.substr(8));
+        for (std::string flag; flags >> flag; ) {
+          info.flags.insert(flag);
+        }
+      }
+    }
+
+    return found;
+  }
+#endif
+}; // mmap_directory_test
+
+TEST_F(mmap_directory_test, options) {
+  irs::mmap_directory dir(path_.utf8(), {
+    { "pop", irs::MmapOptions::POPULATE },
+    { "lck", irs::MmapOptions::LOCK },
+    { "all", irs::MmapOptions::POPULATE | irs::MmapOptions::LOCK | irs::MmapOptions::HUGE_PAGES }
+  });
+
+  // options never change the content of a file
+  for (auto* name : { "file.pop", "file.lck", "file.all", "file.none", "file", "empty.pop" }) {
+    SCOPED_TRACE(name);
+    const std::string file_name(name);
+    const bool empty = "empty.pop" == file_name;
+
+    {
+      auto out = dir.create(name);
+      ASSERT_FALSE(!out);
+
+      if (!empty) {
+        for (uint32_t i = 0; i < 10000; ++i) {
+          out->write_vint(i);
+        }
+      }
+    }
+
+    auto in = dir.open(name, irs::IOAdvice::RANDOM);
+    ASSERT_FALSE(!in);
+
+#ifdef __linux__
+    // check the options applied to the mapping before reading it
+    if (!empty) {
+      const auto* addr = in->read_buffer(0, irs::BufferHint::PERSISTENT);
+      ASSERT_NE(nullptr, addr);
+
+      mapping_info info;
+      ASSERT_TRUE(get_mapping_info(addr, info));
+
+      const bool populate = "file.pop" == file_name || "file.all" == file_name;
+      const bool lock = "file.lck" == file_name || "file.all" == file_name;
+
+      // pages are faulted in by MAP_POPULATE or mlock(...) only
+      ASSERT_EQ(populate || lock, 0 != info.rss);
+
+      rlimit limit;
+      if (0 == getrlimit(RLIMIT_MEMLOCK, &limit) && limit.rlim_cur >= in->length()) {
+        ASSERT_EQ(lock, 0 != info.flags.count("lo"));
+      }
+
+      // madvise(MADV_HUGEPAGE) requires transparent huge pages support
+      if ("file.all" == file_name) {
+        if (IR_MADVICE_HUGEPAGE
+            && std::ifstream("/sys/kernel/mm/transparent_hugepage/enabled")) {
+          ASSERT_EQ(1, info.flags.count("hg"));
+        }
+      } else {
+        ASSERT_EQ(0, info.flags.count("hg"));
+      }
+    }
+#endif
+
+    if (!empty) {
+      for (uint32_t i = 0; i < 10000; ++i) {
+        ASSERT_EQ(i, in->read_vint());
+      }
+    }
+    ASSERT_TRUE(in->eof());
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 fs_directory_test
 // -----------------------------------------------------------------------------
@@ -1510,4 +1704,115 @@ TEST(memory_directory_test, file_reset_allocator) {
   ASSERT_NE(buf0.data, buf1.data);
 }
 
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                              async_directory_test
+// -----------------------------------------------------------------------------
+
+class async_directory_test : public fs_directory_test {
+ protected:
+  static constexpr uint32_t COUNT = 100000;
+  static constexpr size_t REGION = 4096; // in bytes
+
+  // writes 'COUNT' consecutive integers starting with 'base', an existing
+  // file is rewritten in place, i.e. open inputs observe the new content
+  static void write(irs::directory& dir, uint32_t base) {
+    auto out = dir.create("file");
+    ASSERT_FALSE(!out);
+
+    for (uint32_t i = 0; i < COUNT; ++i) {
+      out->write_int(base + i);
+    }
+  }
+
+  static uint32_t read(irs::index_input& in, size_t offset) {
+    in.seek(offset);
+    return uint32_t(in.read_int());
+  }
+}; // async_directory_test
+
+TEST_F(async_directory_test, prefetch) {
+  irs::async_utils::thread_pool pool(1, 1);
+  irs::async_directory dir(path_.utf8(), pool);
+
+  write(dir, 0);
+  auto in = dir.open("file", irs::IOAdvice::RANDOM);
+  ASSERT_FALSE(!in);
+  auto dup = in->dup();
+  ASSERT_FALSE(!dup);
+
+  in->prefetch(0, REGION);
+  in->prefetch(3*REGION, REGION);
+  in->prefetch(3*REGION + 8, 16); // already requested
+  in->prefetch(in->length(), REGION); // out of range
+  in->prefetch(2*REGION, 0); // empty
+  pool.stop(); // wait for the reads
+
+  write(dir, COUNT);
+
+  // prefetched regions are served from memory to all duplicates of an input
+  for (auto* input : { in.get(), dup.get() }) {
+    ASSERT_EQ(0, read(*input, 0));
+    ASSERT_EQ(REGION/4 - 1, read(*input, REGION - 4));
+    ASSERT_EQ(COUNT + REGION/4, read(*input, REGION));
+    ASSERT_EQ(COUNT + 2*REGION/4, read(*input, 2*REGION));
+    ASSERT_EQ(3*REGION/4, read(*input, 3*REGION));
+    ASSERT_EQ(COUNT + 4*REGION/4, read(*input, 4*REGION));
+
+    // a read spanning the end of a prefetched region
+    input->seek(REGION - 8);
+    ASSERT_EQ(REGION/4 - 2, input->read_int());
+    ASSERT_EQ(REGION/4 - 1, input->read_int());
+    ASSERT_EQ(COUNT + REGION/4, input->read_int());
+  }
+
+  // the pool isn't active anymore
+  in->prefetch(5*REGION, REGION);
+  ASSERT_EQ(COUNT + 5*REGION/4, read(*in, 5*REGION));
+
+  // checksums aren't affected by prefetched regions
+  in->seek(0);
+  auto expected = dir.open("file", irs::IOAdvice::NORMAL);
+  ASSERT_FALSE(!expected);
+  ASSERT_EQ(expected->checksum(in->length()), in->checksum(in->length()));
+}
+
+TEST_F(async_directory_test, prefetch_not_started) {
+  irs::async_utils::thread_pool pool(0, 0); // never executes a task
+  irs::async_directory dir(path_.utf8(), pool);
+
+  write(dir, 0);
+  auto in = dir.open("file", irs::IOAdvice::RANDOM);
+  ASSERT_FALSE(!in);
+
+  in->prefetch(0, REGION);
+  ASSERT_EQ(1, pool.tasks_pending());
+
+  write(dir, COUNT);
+
+  // a reader never waits for a pending read, it reads the region itself
+  ASSERT_EQ(COUNT, read(*in, 0));
+  ASSERT_EQ(COUNT + REGION/4, read(*in, REGION));
+}
+
+TEST_F(async_directory_test, prefetch_limit) {
+  irs::async_utils::thread_pool pool(1, 1);
+  irs::async_directory dir(path_.utf8(), pool, 2);
+
+  write(dir, 0);
+  auto in = dir.open("file", irs::IOAdvice::RANDOM);
+  ASSERT_FALSE(!in);
+
+  in->prefetch(0, REGION);
+  in->prefetch(REGION, REGION);
+  in->prefetch(2*REGION, REGION); // drops the oldest region
+  pool.stop(); // wait for the reads
+
+  write(dir, COUNT);
+
+  ASSERT_EQ(COUNT, read(*in, 0));
+  ASSERT_EQ(REGION/4, read(*in, REGION));
+  ASSERT_EQ(2*REGION/4, read(*in, 2*REGION));
+}
+
 }
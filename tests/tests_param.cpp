@@ -23,9 +23,11 @@
 
 #include "tests_shared.hpp"
 #include "tests_param.hpp"
+#include "store/async_directory.hpp"
 #include "store/fs_directory.hpp"
 #include "store/mmap_directory.hpp"
 #include "store/memory_directory.hpp"
+#include "utils/async_utils.hpp"
 
 namespace tests {
 
@@ -76,6 +78,27 @@ std::pair<std::shared_ptr<irs::directory>, std::string> mmap_directory(const tes
   return std::make_pair(impl, "mmap");
 }
 
+std::pair<std::shared_ptr<irs::directory>, std::string> async_directory(const test_base* test) {
+  static irs::async_utils::thread_pool pool(4, 4); // shared by all directories
+  std::shared_ptr<irs::directory> impl;
+
+  if (test) {
+    auto dir = test->test_dir();
+
+    dir /= "index";
+    dir.mkdir(false);
+
+    impl = std::shared_ptr<irs::async_directory>(
+      new irs::async_directory(dir.utf8(), pool),
+      [dir](irs::async_directory* p) {
+        dir.remove();
+        delete p;
+    });
+  }
+
+  return std::make_pair(impl, "async");
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                          directory_test_case_base
 // -----------------------------------------------------------------------------
@@ -99,6 +99,7 @@ typedef std::pair<std::shared_ptr<irs::directory>, std::string>(*dir_factory_f)(
 std::pair<std::shared_ptr<irs::directory>, std::string> memory_directory(const test_base*);
 std::pair<std::shared_ptr<irs::directory>, std::string> fs_directory(const test_base* test);
 std::pair<std::shared_ptr<irs::directory>, std::string> mmap_directory(const test_base* test);
+std::pair<std::shared_ptr<irs::directory>, std::string> async_directory(const test_base* test);
 
 template<dir_factory_f DirectoryGenerator, size_t BlockSize>
 std::pair<std::shared_ptr<irs::directory>, std::string> rot13_cipher_directory(const test_base* ctx) {
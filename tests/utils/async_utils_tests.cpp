@@ -763,6 +763,36 @@ TEST_F(async_utils_tests, test_thread_pool_stop_mt) {
   }
 }
 
+TEST_F(async_utils_tests, test_run_concurrently_busy_pool_mt) {
+  irs::async_utils::thread_pool pool(1, 0);
+  std::mutex mutex;
+  std::unique_lock<std::mutex> lock(mutex);
+
+  // occupy the only thread of the pool till 'lock' is released
+  ASSERT_TRUE(pool.run([&mutex]()->void { std::lock_guard<std::mutex> lock(mutex); }));
+
+  // 'background' isn't started by the busy pool and runs on the current thread
+  std::thread::id background_id;
+  bool foreground = false;
+  irs::async_utils::run_concurrently(
+    &pool,
+    [&background_id]()->void { background_id = std::this_thread::get_id(); },
+    [&foreground]()->void { foreground = true; });
+  ASSERT_TRUE(foreground);
+  ASSERT_EQ(std::this_thread::get_id(), background_id);
+
+  // exception thrown by 'background' is rethrown
+  ASSERT_THROW(
+    irs::async_utils::run_concurrently(
+      &pool,
+      []()->void { throw std::runtime_error("background"); },
+      []()->void { }),
+    std::runtime_error);
+
+  lock.unlock();
+  pool.stop();
+}
+
 TEST(thread_utils_test, get_set_name) {
   const thread_name_t expected_name = IR_NATIVE_STRING("foo");
 #if (defined(__linux__) || defined(__APPLE__) || (defined(_WIN32) && (_WIN32_WINNT >= _WIN32_WINNT_WIN10)))
@@ -2516,6 +2516,36 @@ TEST(bitvector_tests, set_unset_pas_end) {
   ASSERT_NE(prev_data, bv.data());
 }
 
+TEST(bitvector_tests, set_reserved_large) {
+  constexpr size_t BITS = size_t(1) << 24;
+  irs::bitvector bv;
+  bv.reserve(BITS);
+  ASSERT_EQ(BITS, bv.capacity());
+  ASSERT_EQ(0, bv.size());
+  auto* prev_data = bv.data();
+
+  // setting bits in ascending order must not touch the rest of the reserved
+  // words, otherwise filling a pre-sized bitvector is quadratic
+  for (size_t i = 0; i < BITS; i += 3) {
+    bv.set(i);
+    ASSERT_EQ(i + 1, bv.size());
+  }
+
+  ASSERT_EQ(prev_data, bv.data());
+  ASSERT_EQ(BITS, bv.capacity());
+  ASSERT_EQ((BITS + 2) / 3, bv.count());
+
+  for (size_t i = 0; i < BITS; ++i) {
+    ASSERT_EQ(0 == i % 3, bv.test(i));
+  }
+
+  // unset within capacity
+  bv.unset(BITS - 2);
+  ASSERT_EQ(BITS, bv.size());
+  ASSERT_EQ((BITS + 2) / 3, bv.count());
+  ASSERT_EQ(prev_data, bv.data());
+}
+
 TEST(bitvector_tests, shrink_to_fit) {
   // shrink from null
   {
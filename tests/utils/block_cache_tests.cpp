@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2021 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author agent
+////////////////////////////////////////////////////////////////////////////////
+
+#include "gtest/gtest.h"
+#include "utils/block_cache.hpp"
+
+#include <thread>
+
+namespace {
+
+irs::block_cache::value_ptr make_value(int value) {
+  return std::make_shared<int>(value);
+}
+
+int get_value(const irs::block_cache::value_ptr& value) {
+  return *static_cast<const int*>(value.get());
+}
+
+}
+
+TEST(block_cache_test, next_file_id) {
+  const auto id0 = irs::block_cache::next_file_id();
+  const auto id1 = irs::block_cache::next_file_id();
+  ASSERT_NE(id0, id1);
+}
+
+TEST(block_cache_test, find_insert) {
+  irs::block_cache cache(100, 1);
+  ASSERT_EQ(100, cache.budget());
+  ASSERT_EQ(nullptr, cache.find({0, 0}));
+
+  auto value = cache.insert({0, 0}, make_value(1), 10);
+  ASSERT_NE(nullptr, value);
+  ASSERT_EQ(1, get_value(value));
+
+  // already cached
+  value = cache.insert({0, 0}, make_value(2), 10);
+  ASSERT_EQ(1, get_value(value));
+
+  value = cache.find({0, 0});
+  ASSERT_NE(nullptr, value);
+  ASSERT_EQ(1, get_value(value));
+
+  // same offset, different file
+  ASSERT_EQ(nullptr, cache.find({1, 0}));
+
+  const auto stats = cache.stats();
+  ASSERT_EQ(1, stats.hits);
+  ASSERT_EQ(2, stats.misses);
+  ASSERT_EQ(0, stats.evictions);
+  ASSERT_EQ(1, stats.count);
+  ASSERT_EQ(10, stats.size);
+}
+
+TEST(block_cache_test, lru_eviction) {
+  irs::block_cache cache(30, 1);
+
+  cache.insert({0, 0}, make_value(0), 10);
+  cache.insert({0, 1}, make_value(1), 10);
+  cache.insert({0, 2}, make_value(2), 10);
+
+  // mark as recently used
+  auto value0 = cache.find({0, 0});
+  ASSERT_NE(nullptr, value0);
+
+  // evicts {0, 1}
+  cache.insert({0, 3}, make_value(3), 10);
+  ASSERT_EQ(nullptr, cache.find({0, 1}));
+  ASSERT_NE(nullptr, cache.find({0, 2}));
+  ASSERT_NE(nullptr, cache.find({0, 3}));
+
+  // evicts {0, 0} and {0, 2}
+  cache.insert({0, 4}, make_value(4), 20);
+  ASSERT_EQ(nullptr, cache.find({0, 0}));
+  ASSERT_EQ(nullptr, cache.find({0, 2}));
+  ASSERT_NE(nullptr, cache.find({0, 3}));
+  ASSERT_NE(nullptr, cache.find({0, 4}));
+
+  // evicted value is still alive
+  ASSERT_EQ(0, get_value(value0));
+
+  const auto stats = cache.stats();
+  ASSERT_EQ(3, stats.evictions);
+  ASSERT_EQ(2, stats.count);
+  ASSERT_EQ(30, stats.size);
+}
+
+TEST(block_cache_test, too_large) {
+  irs::block_cache cache(30, 1);
+
+  auto value = cache.insert({0, 0}, make_value(0), 31);
+  ASSERT_NE(nullptr, value);
+  ASSERT_EQ(0, get_value(value));
+  ASSERT_EQ(nullptr, cache.find({0, 0}));
+  ASSERT_EQ(0, cache.stats().count);
+}
+
+TEST(block_cache_test, budget) {
+  irs::block_cache cache(40, 1);
+
+  for (uint64_t i = 0; i < 4; ++i) {
+    cache.insert({0, i}, make_value(int(i)), 10);
+  }
+  ASSERT_EQ(4, cache.stats().count);
+
+  cache.budget(20);
+  ASSERT_EQ(20, cache.budget());
+
+  const auto stats = cache.stats();
+  ASSERT_EQ(2, stats.count);
+  ASSERT_EQ(20, stats.size);
+  ASSERT_EQ(2, stats.evictions);
+  ASSERT_EQ(nullptr, cache.find({0, 0}));
+  ASSERT_EQ(nullptr, cache.find({0, 1}));
+  ASSERT_NE(nullptr, cache.find({0, 2}));
+  ASSERT_NE(nullptr, cache.find({0, 3}));
+}
+
+TEST(block_cache_test, erase_clear) {
+  irs::block_cache cache;
+
+  for (uint64_t i = 0; i < 100; ++i) {
+    cache.insert({0, i << 10}, make_value(int(i)), 10);
+    cache.insert({1, i << 10}, make_value(int(i)), 10);
+  }
+  ASSERT_EQ(200, cache.stats().count);
+  ASSERT_EQ(2000, cache.stats().size);
+
+  cache.erase(0);
+  ASSERT_EQ(100, cache.stats().count);
+  ASSERT_EQ(1000, cache.stats().size);
+
+  for (uint64_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(nullptr, cache.find({0, i << 10}));
+    auto value = cache.find({1, i << 10});
+    ASSERT_NE(nullptr, value);
+    ASSERT_EQ(int(i), get_value(value));
+  }
+
+  cache.clear();
+  ASSERT_EQ(0, cache.stats().count);
+  ASSERT_EQ(0, cache.stats().size);
+  ASSERT_EQ(nullptr, cache.find({1, 0}));
+}
+
+TEST(block_cache_test, concurrent_access) {
+  constexpr size_t THREADS = 8;
+  constexpr uint64_t KEYS = 1000;
+  irs::block_cache cache(KEYS*10, 4); // not everything fits
+
+  std::vector<std::thread> threads;
+  std::atomic<bool> failed{false};
+
+  for (size_t t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&cache, &failed, t]() {
+      for (uint64_t i = 0; i < 10*KEYS; ++i) {
+        const uint64_t offset = (i*(t+1)) % (2*KEYS);
+        auto value = cache.find({0, offset});
+
+        if (!value) {
+          value = cache.insert({0, offset}, make_value(int(offset)), 10);
+        }
+
+        if (!value || uint64_t(get_value(value)) != offset) {
+          failed = true;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_FALSE(failed);
+  const auto stats = cache.stats();
+  ASSERT_LE(stats.size, cache.budget());
+  ASSERT_EQ(10*stats.count, stats.size);
+  ASSERT_EQ(THREADS*10*KEYS, stats.hits + stats.misses);
+}
@@ -233,6 +233,39 @@ TEST(immutable_fst_test, read_write) {
     }
   }
 
+  // skip fst
+  {
+    irs::memory_index_input in(out.file);
+    ASSERT_TRUE(irs::immutable_byte_fst::Skip(in));
+    ASSERT_EQ(in.length(), in.file_pointer());
+  }
+
+  // read fst with weights referenced in the input buffer
+  {
+    irs::memory_index_input in(out.file);
+    std::unique_ptr<irs::immutable_byte_fst> shared_fst(irs::immutable_byte_fst::Read(in, true));
+
+    ASSERT_NE(nullptr, shared_fst);
+    ASSERT_EQ(in.length(), in.file_pointer());
+    ASSERT_EQ(read_fst->NumStates(), shared_fst->NumStates());
+    ASSERT_EQ(read_fst->Start(), shared_fst->Start());
+    for (fst::StateIterator<irs::immutable_byte_fst> it(*read_fst); !it.Done(); it.Next()) {
+      const auto s = it.Value();
+      ASSERT_EQ(read_fst->NumArcs(s), shared_fst->NumArcs(s));
+      ASSERT_EQ(static_cast<irs::bytes_ref>(read_fst->Final(s)),
+                static_cast<irs::bytes_ref>(shared_fst->Final(s)));
+
+      fst::ArcIterator<irs::immutable_byte_fst> expected_arcs(*read_fst, s);
+      fst::ArcIterator<irs::immutable_byte_fst> actual_arcs(*shared_fst, s);
+      for (; !expected_arcs.Done(); expected_arcs.Next(), actual_arcs.Next()) {
+        ASSERT_EQ(expected_arcs.Value().ilabel, actual_arcs.Value().ilabel);
+        ASSERT_EQ(expected_arcs.Value().nextstate, actual_arcs.Value().nextstate);
+        ASSERT_EQ(static_cast<irs::bytes_ref>(expected_arcs.Value().weight),
+                  static_cast<irs::bytes_ref>(actual_arcs.Value().weight));
+      }
+    }
+  }
+
   // check fst
   {
     using sorted_matcher_t = fst::SortedMatcher<irs::immutable_byte_fst>;
@@ -58,6 +58,7 @@
 #include "search/prefix_filter.hpp"
 #include "search/score.hpp"
 #include "search/term_filter.hpp"
+#include "search/top_k_collector.hpp"
 #include "search/wildcard_filter.hpp"
 #include "search/ngram_similarity_filter.hpp"
 #include "store/fs_directory.hpp"
@@ -582,8 +583,8 @@ int search(
       const timers_t building_timers("building");
       const timers_t execution_timers("execution");
 
-      std::vector<std::pair<float_t, irs::doc_id_t>> sorted;
-      sorted.reserve(limit);
+      irs::top_k_collector collector(limit);
+      std::vector<irs::top_k_collector::entry> sorted;
 
       // process a single task
       for (const task_t* task; (task = task_provider.pop()) != nullptr;) {
@@ -611,57 +612,10 @@ int search(
         {
           irs::timer_utils::scoped_timer timer(*(execution_timers.stat[size_t(task->category)]));
 
-          for (auto& segment: reader) {
-            auto docs = filter->execute(segment, order); // query segment
-            const irs::score* score = irs::get<irs::score>(*docs);
-            assert(score);
-            const irs::document* doc = irs::get<irs::document>(*docs);
-            assert(doc);
-
-            while (docs->next()) {
-              ++doc_count;
-              const float_t score_value = *reinterpret_cast<const float_t*>(score->evaluate());
-
-              if (sorted.size() < limit) {
-                sorted.emplace_back(score_value, doc->value);
-
-                std::push_heap(
-                  sorted.begin(), sorted.end(),
-                  [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                     const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                    return lhs.first < rhs.first;
-                });
-              } else if (sorted.front().first < score_value) {
-                std::pop_heap(
-                  sorted.begin(), sorted.end(),
-                  [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                     const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                    return lhs.first < rhs.first;
-                });
-
-                auto& back = sorted.back();
-                back.first = score_value;
-                back.second = doc->value;
-
-                std::push_heap(
-                  sorted.begin(), sorted.end(),
-                  [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                     const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                    return lhs.first < rhs.first;
-                });
-              }
-            }
-          }
-
-          auto end = sorted.end();
-          for (auto begin = sorted.begin(); begin != end; --end) {
-            std::pop_heap(
-              begin, end,
-              [](const std::pair<float_t, irs::doc_id_t>& lhs,
-                 const std::pair<float_t, irs::doc_id_t>& rhs) noexcept {
-                return lhs.first < rhs.first;
-            });
-          }
+          collector.clear();
+          collector.collect(reader, *filter, order);
+          doc_count = collector.hits();
+          sorted = collector.top();
         }
 
         const auto tdiff = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
@@ -677,7 +631,7 @@ int search(
                 << "  thread " << std::this_thread::get_id() << '\n';
 
             for (auto& entry : sorted) {
-              ss << "  doc=" << entry.second << " score=" << entry.first << '\n';
+              ss << "  doc=" << entry.doc << " score=" << entry.score << '\n';
             }
 
             ss << '\n';